@@ -0,0 +1,70 @@
+#version 410 core
+
+layout (location = 0) in vec4 i_vertex;
+
+out vec2 io_texCoord;
+out vec3 io_pos;
+
+uniform mat4 u_model;
+
+layout (std140) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 pos;
+} u_camera;
+
+void main()
+{
+	gl_Position = u_camera.projection * u_camera.view * u_model * vec4(i_vertex.xy, 0.0, 1.0);
+	io_texCoord = i_vertex.zw;
+	io_pos = vec3(u_model * vec4(i_vertex.xy, 0.0, 1.0));
+}
+
+// ------------------------------------------------------------------------
+#switch
+
+#version 410 core
+
+in vec2 io_texCoord;
+in vec3 io_pos;
+
+out vec4 o_color;
+
+uniform sampler2D u_tex;
+uniform vec4 u_color;
+
+layout (std140) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 pos;
+} u_camera;
+
+layout (std140) uniform FogBlock
+{
+	vec3 color;
+	float start;
+	float end;
+	bool enabled;
+} u_fog;
+
+void main()
+{
+	// 0.5 is the outline, smoothing over the distance covered by one screen pixel keeps the edge sharp at any scale
+	float dist = texture(u_tex, io_texCoord).r;
+	float width = max(fwidth(dist) * 0.5, 0.001);
+	o_color = u_color * vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, dist));
+	if (!u_fog.enabled) return;
+
+	float camDist = distance(u_camera.pos, io_pos);
+
+	if (camDist > u_fog.start)
+	{
+		float fogFactor = (camDist - u_fog.start) / (u_fog.end - u_fog.start);
+		fogFactor = clamp(fogFactor, 0.0, 1.0);
+		float a = o_color.a;
+		o_color = mix(o_color, vec4(u_fog.color, 1.0), fogFactor);
+		o_color.a = a;
+	}
+}
@@ -0,0 +1,65 @@
+#version 410 core
+
+layout (location = 0) in vec3 i_pos;
+layout (location = 4) in vec4 i_color;
+layout (location = 5) in mat4 i_model;
+
+out vec3 io_pos;
+out vec4 io_color;
+
+layout (std140) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 pos;
+} u_camera;
+
+void main()
+{
+	gl_Position = u_camera.projection * u_camera.view * i_model * vec4(i_pos, 1.0);
+	io_pos = vec3(i_model * vec4(i_pos, 1.0));
+	io_color = i_color;
+}
+
+// ------------------------------------------------------------------------
+#switch
+
+#version 410 core
+
+in vec3 io_pos;
+in vec4 io_color;
+
+out vec4 o_color;
+
+layout (std140) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 pos;
+} u_camera;
+
+layout (std140) uniform FogBlock
+{
+	vec3 color;
+	float start;
+	float end;
+	bool enabled;
+} u_fog;
+
+void main()
+{
+	o_color = io_color;
+
+	if (!u_fog.enabled) return;
+
+	float camDist = distance(u_camera.pos, io_pos);
+
+	if (camDist > u_fog.start)
+	{
+		float fogFactor = (camDist - u_fog.start) / (u_fog.end - u_fog.start);
+		fogFactor = clamp(fogFactor, 0.0, 1.0);
+		float a = o_color.a;
+		o_color = mix(o_color, vec4(u_fog.color, 1.0), fogFactor);
+		o_color.a = a;
+	}
+}
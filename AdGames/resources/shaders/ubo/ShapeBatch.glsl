@@ -0,0 +1,40 @@
+#version 410 core
+
+layout (location = 0) in vec3 i_pos;
+layout (location = 1) in vec4 i_color;
+layout (location = 2) in vec2 i_texCoords;
+
+out vec4 io_color;
+out vec2 io_texCoords;
+
+layout (std140) uniform CameraBlock
+{
+	mat4 view;
+	mat4 projection;
+	vec3 pos;
+} u_camera;
+
+void main()
+{
+	// batched vertices are already in world space
+	gl_Position = u_camera.projection * u_camera.view * vec4(i_pos, 1.0);
+	io_color = i_color;
+	io_texCoords = i_texCoords;
+}
+
+// ------------------------------------------------------------------------
+#switch
+
+#version 410 core
+
+in vec4 io_color;
+in vec2 io_texCoords;
+
+out vec4 o_color;
+
+uniform sampler2D u_tex;
+
+void main()
+{
+	o_color = io_color * texture(u_tex, io_texCoords);
+}
@@ -1,10 +1,13 @@
 #include "Application.h"
 
-#include "SpikeDodge.h"
-#include "MathGates.h"
-#include "ConnectFour.h"
-#include "CannonGame.h"
 #include "Launcher.h"
+#include "engine/AssetLoader.h"
+#include "engine/ShaderCache.h"
+#include "engine/SharedUniforms.h"
+#include "engine/PrimitiveCache.h"
+#include "engine/FontCache.h"
+#include "engine/ImageCache.h"
+#include "engine/CookedModel.h"
 
 Application::Application()
 {
@@ -14,12 +17,25 @@ void Application::run()
 {
 	m_errorHandler = Onyx::ErrorHandler(true, true);
 	Onyx::Init(m_errorHandler);
-	Onyx::Terminate();
 
-	Launcher::GameHub::Launch();
+	// one window for the whole session, the launcher and every game are scenes in it
+	m_scenes = Onyx::SceneManager(Launcher::GameHub::GetWindowProperties());
+	m_scenes.init();
+	m_scenes.run(std::make_unique<Launcher::GameHub>());
 }
 
 void Application::dispose()
 {
+	// the caches outlive every scene, so they go while the context they were made in still exists
+	Onyx::AssetLoader::Cancel();
+	Onyx::FontCache::Clear();
+	Onyx::CookedModel::Clear();
+	Onyx::PrimitiveCache::Clear();
+	Onyx::ShaderCache::Clear();
+	Onyx::SharedUniforms::Clear();
+	Onyx::ImageCache::Clear();
+	m_scenes.dispose();
+
 	Onyx::Terminate();
+	Onyx::AssetLoader::Shutdown();
 }
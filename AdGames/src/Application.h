@@ -2,6 +2,8 @@
 
 #include <Onyx/Core.h>
 
+#include "engine/SceneManager.h"
+
 class Application
 {
 public:
@@ -12,4 +14,5 @@ public:
 
 private:
 	Onyx::ErrorHandler m_errorHandler;
+	Onyx::SceneManager m_scenes;
 };
@@ -2,9 +2,7 @@
 
 #include "CannonGame.h"
 
-#include "Launcher.h"
-
-#include <list>
+#include <random>
 
 #include <Onyx/Core.h>
 #include <Onyx/Window.h>
@@ -14,391 +12,219 @@
 using namespace Onyx;
 using namespace Onyx::Math;
 
-const int SCR_WIDTH = 1280, SCR_HEIGHT = 720;
-
-const int FLOOR_HEIGHT = 150;
-const int CANNON_BODY_WIDTH = 100, CANNON_BODY_HEIGHT = 50;
-const int CANNON_BARREL_WIDTH = 30, CANNON_BARREL_HEIGHT = 100;
-
-const float BALL_SPAWN_INTERVAL = 0.1f;
-const int BALL_RADIUS = 10, BALL_SEGMENTS = 5;
-const float BALL_SPEED = 500.0f;
-const float BALL_ROT_SPEED_MIN = 50.0f, BALL_ROT_SPEED_MAX = 200.0f;
-
+const int BALL_SEGMENTS = 5;
 const float BOULDER_OUTLINE_RATIO = 1.1f;
-const float BOULDER_SPAWN_INTERVAL = 2.0f;
-const int	BOULDER_STARTING_HEALTH = 5, BOULDER_STARTING_RADIUS = 50, BOULDER_STARTING_SEGMENTS = 5;
-const float BOUDLER_HEALTH_RANGE = 5, BOULDER_HEALTH_INC = 5;
-const float BOULDER_RADIUS_RANGE = 25, BOULDER_RADIUS_INC = 0.3;
-const float BOULDER_SEGMENTS_RANGE = 2.0f, BOULDER_SEGMENTS_INC = 0.02f;
-const float BOULDER_VEL_MIN_X = 200.0f, BOULDER_VEL_MAX_X = 400.0f;
-const float BOULDER_VEL_MIN_Y = 0.0f, BOULDER_VEL_MAX_Y = 50.0f;
-const float BOULDER_ROT_SPEED_MIN = 20.0f, BOULDER_ROT_SPEED_MAX = 100.0f;
 
-const float STRAFE_SPEED = 200.0f, STRAFE_RANGE = SCR_WIDTH / 2.0f - CANNON_BODY_WIDTH / 2.0f - 50.0f;
-const float DAMAGE_INC = 0.25f;
+// BL_TEXT_SIZE is the size of the text in world units, the font is an SDF font so its atlas stays small at any size
+const float BL_TEXT_PADDING = 20.0f, BL_TEXT_SIZE = 51.2f;
+const uint FONT_SIZE = 48;
 
-const float BL_TEXT_PADDING = 20.0f, BL_TEXT_SCALE = 0.2f;
+// more boulders than are ever in the air at once, the pool grows if it has to
+const uint BOULDER_POOL_SIZE = 16;
 
-const float GRAVITY = -100.0f;
+// the physics runs at a fixed rate so fast balls can't skip through a boulder on a long frame
+const double TICK_RATE = 120.0;
 
-void CannonGame::Run()
+CannonGame::Game::Game()
 {
-	Onyx::Init();
+	m_pManager = nullptr;
+}
 
-	Monitor monitor = Monitor::GetPrimary();
+void CannonGame::Game::load(SceneManager& manager)
+{
+	m_pManager = &manager;
+	Window& window = manager.getWindow();
 
-	Window window(
+	Monitor monitor = Monitor::GetPrimary();
+	manager.configureWindow(
 		WindowProperties{
 			.title = "Cannon",
 			.width = SCR_WIDTH,
 			.height = SCR_HEIGHT,
-			.nSamplesMSAA = 16,
+			.position = Vec2(monitor.getWidth() / 2 - SCR_WIDTH / 2, monitor.getHeight() / 2 - SCR_HEIGHT / 2),
 			.backgroundColor = Vec3::LightBlue()
 		}
 	);
 
-	window.init();
-	window.setPosition(Vec2(monitor.getWidth() / 2 - SCR_WIDTH / 2, monitor.getHeight() / 2 - SCR_HEIGHT / 2));
-
-	Onyx::WindowIcon icon = Onyx::WindowIcon::Load({
-		Onyx::Resources("icons/icon-16x.png"),
-		Onyx::Resources("icons/icon-24x.png"),
-		Onyx::Resources("icons/icon-32x.png"),
-		Onyx::Resources("icons/icon-48x.png"),
-		Onyx::Resources("icons/icon-256x.png")
-	});
-	window.setIcon(icon);
-	icon.dispose();
-
-	Cursor crosshair = Cursor::Standard(CursorType::Crosshair);
-	window.setCursor(crosshair);
-
-	InputHandler input;
-	window.linkInputHandler(input);
-
-	Camera cam(Projection::Orthographic(SCR_WIDTH, SCR_HEIGHT));
-	window.linkCamera(cam);
-
-	Renderer renderer(cam);
-	window.linkRenderer(renderer);
-
-	Renderable floor = Renderable::ColoredQuad(SCR_WIDTH, FLOOR_HEIGHT, Vec3(0.5f, 0.8f, 0.0f));
-	floor.translate(Vec3(SCR_WIDTH / 2, FLOOR_HEIGHT / 2, 0.0f));
-	renderer.add(floor);
-
-	Renderable cannonBodyRenderable = Renderable::ColoredQuad(100, 50, Vec3::Brown());
-	cannonBodyRenderable.translate(Vec3(SCR_WIDTH / 2, FLOOR_HEIGHT + CANNON_BODY_HEIGHT / 2, 0.0f));
-	renderer.add(cannonBodyRenderable);
-
-	float vertices[12] = {
-		-CANNON_BARREL_WIDTH / 2,    -CANNON_BARREL_HEIGHT / 4.0f, 0.0f,
-		 CANNON_BARREL_WIDTH / 2,    -CANNON_BARREL_HEIGHT / 4.0f, 0.0f,
-		 CANNON_BARREL_WIDTH / 2, 3 * CANNON_BARREL_HEIGHT / 4.0f, 0.0f,
-		-CANNON_BARREL_WIDTH / 2, 3 * CANNON_BARREL_HEIGHT / 4.0f, 0.0f
-	};
-
-	Renderable cannonBarrelRenderable(
-		Mesh(
-			VertexBuffer(vertices, sizeof(vertices), VertexFormat::P),
-			IndexBuffer::Quad()
-		),
-		Shader::P_Color(Vec4(Vec3::LightGray() * 0.65f, 1.0f))
-	);
-	cannonBarrelRenderable.translate(Vec3(SCR_WIDTH / 2, FLOOR_HEIGHT + CANNON_BODY_HEIGHT, 0.0f));
-	renderer.add(cannonBarrelRenderable);
-
-	Renderable cannonBallRenderable = Renderable::ColoredCircle(BALL_RADIUS, BALL_SEGMENTS, Vec4::Black());
-
-	std::list<CannonBall> cannonBalls;
-	std::list<Boulder> boulders;
-
-	Font font = Font::Load(Resources("fonts/Poppins/Poppins-Bold.ttf"), 256);
+	m_crosshair = Cursor::Standard(CursorType::Crosshair);
+	window.setCursor(m_crosshair);
 
-	TextRenderable3D nMissedText("0", font, Vec4::Red(0.8f));
-	nMissedText.setScale(BL_TEXT_SCALE);
-	nMissedText.setPosition(Vec3(BL_TEXT_PADDING, BL_TEXT_PADDING, 0.1f));
+	window.linkInputHandler(m_input);
 
-	TextRenderable3D nDestroyedText("0", font, Vec4::White(0.8f));
-	nDestroyedText.setScale(BL_TEXT_SCALE);
-	nDestroyedText.setPosition(Vec3(BL_TEXT_PADDING, BL_TEXT_PADDING + nMissedText.getHeight() + BL_TEXT_PADDING, 0.1f));
+	m_cam = Camera(Projection::Orthographic(SCR_WIDTH, SCR_HEIGHT));
+	window.linkCamera(m_cam);
 
-	renderer.add(nMissedText);
-	renderer.add(nDestroyedText);
+	m_renderQueue = RenderQueue(window, m_cam);
 
-	Vec3 colors[] = { Vec3::Red(), Vec3::Orange(), Vec3::Green(), Vec3::Blue(), Vec3::Cyan(), Vec3::Magenta(), Vec3::Pink(), Vec3::Purple(), Vec3::Brown() };
+	// every flat shape is redrawn into the batch each frame, so nothing here owns any GPU objects
+	m_shapes = ShapeBatch(16384);
+	m_renderQueue.add(m_shapes);
 
-	float boulderSpawnTimer = 0.0f;
-	float boulderHealthMin = BOULDER_STARTING_HEALTH, boulderRadiusMin = BOULDER_STARTING_RADIUS, boulderSegmentsMin = BOULDER_STARTING_SEGMENTS;
+	// the simulation replays the same way from the same seed, so each game gets a new one
+	m_sim = CannonSim(std::random_device()());
+	m_simInput = CannonInput();
 
-	float damage = 1.0f;
-	bool ballRotEnabled = true;
-
-	int nDestroyed = 0, nMissed = 0;
-
-	float ballSpawnTimer = 0.0f;
+	m_fontHandle = AssetLoader::LoadFont(Resources("fonts/Poppins/Poppins-Bold.ttf"), FONT_SIZE, true, m_assets);
+}
 
-	while (window.isOpen())
+bool CannonGame::Game::finishLoad()
+{
+	if (m_fontHandle.getState() == AssetState::Pending) return false;
+	if (m_fontHandle.isFailed())
 	{
-		double dt = window.getDeltaTime();
-		boulderSpawnTimer += dt;
-		ballSpawnTimer += dt;
-
-		if (boulderSpawnTimer >= BOULDER_SPAWN_INTERVAL)
-		{
-			boulderSpawnTimer = BOULDER_SPAWN_INTERVAL - boulderSpawnTimer;
-
-			bool left = Rand<int>(0, 1);
-			float rot = Rand<float>(0.0f, 360.0f);
-			float rotStep = Rand<float>(BOULDER_ROT_SPEED_MIN, BOULDER_ROT_SPEED_MAX);
-			if (left) rotStep = -rotStep;
-			float radius = Rand<float>(boulderRadiusMin, boulderRadiusMin + BOULDER_RADIUS_RANGE);
-			int nSegments = Rand<int>(boulderSegmentsMin, boulderSegmentsMin + BOULDER_SEGMENTS_RANGE);
-			int health = Rand<int>(boulderHealthMin, boulderHealthMin + BOUDLER_HEALTH_RANGE);
-			Vec2 vel, pos;
-			if (left)
-			{
-				vel = Vec2(Rand<float>(BOULDER_VEL_MIN_X, BOULDER_VEL_MAX_X), Rand<float>(BOULDER_VEL_MIN_Y, BOULDER_VEL_MAX_Y));
-				pos = Vec2(-radius, SCR_HEIGHT - 100.0f);
-			}
-			else
-			{
-				vel = Vec2(-Rand<float>(BOULDER_VEL_MIN_X, BOULDER_VEL_MAX_X), Rand<float>(BOULDER_VEL_MIN_Y, BOULDER_VEL_MAX_Y));
-				pos = Vec2(SCR_WIDTH + radius, SCR_HEIGHT - 100.0f);
-			}
-			boulders.push_back(Boulder(vel, pos, rot, rotStep, radius, nSegments, health, colors[Rand<int>(0, sizeof(colors) / sizeof(Vec3) - 1)], &font));
-
-			boulderHealthMin += BOULDER_HEALTH_INC;
-			boulderRadiusMin += BOULDER_RADIUS_INC;
-			boulderSegmentsMin += BOULDER_SEGMENTS_INC;
-
-			damage += DAMAGE_INC;
-		}
-
-		double deg = Degrees(Atan2(input.getMousePos().getY() - cannonBarrelRenderable.getPosition().getY(), input.getMousePos().getX() - cannonBarrelRenderable.getPosition().getX()));
-		if (deg < 0) deg += 360;
-		deg -= 90;
-		if (deg > 180 && deg < 270) deg = -90;
-
-		if (ballSpawnTimer >= BALL_SPAWN_INTERVAL)
-		{
-			ballSpawnTimer = BALL_SPAWN_INTERVAL - ballSpawnTimer;
-			Vec2 pos(cannonBarrelRenderable.getPosition().getX(), cannonBarrelRenderable.getPosition().getY());
-			Vec2 dir = Vec2(Cos(Radians(Clamp(deg, -60, 60) + 90)), Sin(Radians(Clamp(deg, -60, 60) + 90))).getNormalized();
-			pos += dir * (3.0f * CANNON_BARREL_HEIGHT / 4.0f - BALL_RADIUS);
-			cannonBalls.push_back(CannonBall(dir * BALL_SPEED, pos, ballRotEnabled ? Rand<float>(0.0f, 360.0f) : 0.0f, ballRotEnabled ? Rand<float>(BALL_ROT_SPEED_MIN, BALL_ROT_SPEED_MAX) : 0.0f, &cannonBallRenderable));
-		}
-
-		input.update();
-		if (input.isKeyTapped(Key::Escape)) window.close();
-		if (input.isKeyTapped(Key::F1)) Renderer::ToggleWireframe();
-		if (input.isKeyDown(Key::A) || input.isKeyDown(Key::ArrowLeft))
-		{
-			cannonBodyRenderable.translate(Vec3(-STRAFE_SPEED * dt, 0.0f, 0.0f));
-			cannonBarrelRenderable.translate(Vec3(-STRAFE_SPEED * dt, 0.0f, 0.0f));
-			if (cannonBodyRenderable.getPosition().getX() < CANNON_BODY_WIDTH / 2) 
-			{
-				cannonBodyRenderable.setPosition(Vec3(CANNON_BODY_WIDTH / 2, cannonBodyRenderable.getPosition().getY(), 0.0f));
-				cannonBarrelRenderable.setPosition(Vec3(CANNON_BODY_WIDTH / 2, cannonBarrelRenderable.getPosition().getY(), 0.0f));
-			}
-		}
-		if (input.isKeyDown(Key::D) || input.isKeyDown(Key::ArrowRight))
-		{
-			cannonBodyRenderable.translate(Vec3(STRAFE_SPEED * dt, 0.0f, 0.0f));
-			cannonBarrelRenderable.translate(Vec3(STRAFE_SPEED * dt, 0.0f, 0.0f));
-			if (cannonBodyRenderable.getPosition().getX() > SCR_WIDTH - CANNON_BODY_WIDTH / 2)
-			{
-				cannonBodyRenderable.setPosition(Vec3(SCR_WIDTH - CANNON_BODY_WIDTH / 2, cannonBodyRenderable.getPosition().getY(), 0.0f));
-				cannonBarrelRenderable.setPosition(Vec3(SCR_WIDTH - CANNON_BODY_WIDTH / 2, cannonBarrelRenderable.getPosition().getY(), 0.0f));
-			}
-		}
+		m_pManager->pop();
+		return false;
+	}
 
-		cam.update();
+	m_font = m_fontHandle.get();
 
-		//std::cout << cannonBalls.size() << "\n";
+	m_nMissedText = AtlasText3D("0", m_font, Vec4::Red(0.8f));
+	m_nMissedText.setScale(BL_TEXT_SIZE / FONT_SIZE);
+	m_nMissedText.setPosition(Vec3(BL_TEXT_PADDING, BL_TEXT_PADDING, 0.1f));
 
-		cannonBarrelRenderable.setRotation(Vec3(0.0f, 0.0f, Clamp(deg, -60, 60)));
+	m_nDestroyedText = AtlasText3D("0", m_font, Vec4::White(0.8f));
+	m_nDestroyedText.setScale(BL_TEXT_SIZE / FONT_SIZE);
+	m_nDestroyedText.setPosition(Vec3(BL_TEXT_PADDING, BL_TEXT_PADDING + m_nMissedText.getHeight() + BL_TEXT_PADDING, 0.1f));
 
-		nMissedText.setText(std::to_string(nMissed));
-		nDestroyedText.setText(std::to_string(nDestroyed));
+	m_renderQueue.add(m_nMissedText);
+	m_renderQueue.add(m_nDestroyedText);
 
-		window.startRender();
-		renderer.render(); 
-		
-		auto ballIt = cannonBalls.begin();
-		while (ballIt != cannonBalls.end())
-		{
-			CannonBall& ball = *ballIt;
-			if (ball.pos.getX() > SCR_WIDTH + BALL_RADIUS || ball.pos.getX() < -BALL_RADIUS || ball.pos.getY() > SCR_HEIGHT + BALL_RADIUS)
-			{
-				cannonBalls.erase(ballIt++);
-			}
-			else
-			{
-				ball.update(dt);
-				ball.render(cam);
-				ballIt++;
-			}
-		}
+	for (uint i = 0; i < BOULDER_POOL_SIZE; i++) addTextSlot();
 
-		auto boulderIt = boulders.begin();
-		while (boulderIt != boulders.end())
-		{
-			Boulder& boulder = *boulderIt;
-			if (boulder.destroyed)
-			{
-				boulder.dispose();
-				boulders.erase(boulderIt++);
-			}
-			else
-			{
-				ballIt = cannonBalls.begin();
-				while (ballIt != cannonBalls.end())
-				{
-					CannonBall& ball = *ballIt;
-					if (boulder.collision(ball))
-					{
-						boulder.damage((int)damage);
-						cannonBalls.erase(ballIt++);
-					} 
-					else ballIt++;
-				}
-
-				if (boulder.destroyed)
-				{
-					boulder.dispose();
-					boulders.erase(boulderIt++);
-					nDestroyed++;
-				}
-				else if (boulder.pos.getY() < FLOOR_HEIGHT - boulder.radius)
-				{
-					boulder.dispose();
-					boulders.erase(boulderIt++);
-					nMissed++;
-				}
-				else
-				{
-					boulder.update(dt);
-					boulder.render(cam);
-					boulderIt++;
-				}
-			}
-		}
+	return true;
+}
 
-		window.endRender();
+void CannonGame::Game::update(double dt)
+{
+	m_input.update();
+	if (m_input.isKeyTapped(Key::Escape))
+	{
+		m_pManager->pop();
+		return;
 	}
+	if (m_input.isKeyTapped(Key::F1)) Renderer::ToggleWireframe();
 
-	window.dispose();
-	renderer.dispose();
-	crosshair.dispose();
-	font.dispose();
+	// the barrel pivots a quarter of the way up from its bottom, where it meets the top of the body
+	double deg = Degrees(Atan2(m_input.getMousePos().getY() - m_sim.getCannonY(), m_input.getMousePos().getX() - m_sim.getCannonX()));
+	if (deg < 0) deg += 360;
+	deg -= 90;
+	if (deg > 180 && deg < 270) deg = -90;
+	m_simInput.aim = Clamp(deg, -60, 60);
 
-	Onyx::Terminate();
+	m_simInput.strafe = 0;
+	if (m_input.isKeyDown(Key::A) || m_input.isKeyDown(Key::ArrowLeft)) m_simInput.strafe--;
+	if (m_input.isKeyDown(Key::D) || m_input.isKeyDown(Key::ArrowRight)) m_simInput.strafe++;
 
-	Launcher::GameHub::Launch();
+	m_cam.update();
 }
 
-CannonGame::CannonBall::CannonBall()
+void CannonGame::Game::tick(double dt)
 {
-	rot = rotStep = 0.0f;
-	renderable = nullptr;
-}
+	m_sim.step(m_simInput, dt);
 
-CannonGame::CannonBall::CannonBall(Vec2 vel, Vec2 pos, float rot, float rotStep, Renderable* renderable)
-{
-	this->vel = vel;
-	this->pos = pos;
-	this->rot = rot;
-	this->rotStep = rotStep;
-	this->renderable = renderable;
-}
+	for (uint slot : m_sim.getRemovedTags())
+	{
+		m_boulderTexts[slot].hide();
+		m_freeTexts.push_back(slot);
+	}
 
-void CannonGame::CannonBall::update(float dt)
-{
-	pos += vel * dt;
-	rot += rotStep * dt;
-	renderable->setPosition(Vec3(pos.getX(), pos.getY(), -0.5f));
-	renderable->setRotation(Vec3(0.0f, 0.0f, rot));
+	const Boulders& boulders = m_sim.getBoulders();
+	for (uint i = 0; i < boulders.size(); i++)
+	{
+		if (boulders.tags[i] == CannonSim::NO_TAG) m_sim.setTag(i, acquireText(boulders.radius[i]));
+	}
 }
 
-void CannonGame::CannonBall::render(const Camera& cam)
+void CannonGame::Game::render(double alpha)
 {
-	renderable->render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-}
+	static const Vec3 colors[] = { Vec3::Red(), Vec3::Orange(), Vec3::Green(), Vec3::Blue(), Vec3::Cyan(), Vec3::Magenta(), Vec3::Pink(), Vec3::Purple(), Vec3::Brown() };
+	static_assert(sizeof(colors) / sizeof(Vec3) == BOULDER_COLOR_COUNT);
 
-CannonGame::Boulder::Boulder()
-{
-	rot = rotStep = radius = 0.0f;
-	nSegments = health = 0;
-	font = nullptr;
-	destroyed = false;
-}
+	m_nMissedText.setText(std::to_string(m_sim.getMissedCount()));
+	m_nDestroyedText.setText(std::to_string(m_sim.getDestroyedCount()));
 
-CannonGame::Boulder::Boulder(Vec2 vel, Vec2 pos, float rot, float rotStep, float radius, int nSegments, int health, Vec3 color, Font* font)
-{
-	this->vel = vel;
-	this->pos = pos;
-	this->rot = rot;
-	this->rotStep = rotStep;
-	this->radius = radius;
-	this->nSegments = nSegments;
-	this->health = health;
-	this->color = color;
-	this->font = font;
-	destroyed = false;
-
-	outer = Renderable::ColoredCircle(radius * BOULDER_OUTLINE_RATIO, nSegments, Vec3::Black());
-	outer.setPosition(Vec3(pos.getX(), pos.getY(), -1.0f));
-	outer.setRotation(Vec3(0.0f, 0.0f, rot));
-
-	inner = Renderable::ColoredCircle(radius, nSegments, color);
-	inner.setPosition(Vec3(pos.getX(), pos.getY(), -0.9f));
-	inner.setRotation(Vec3(0.0f, 0.0f, rot));
-
-	text = TextRenderable3D(std::to_string(health), *font, Vec4::White(0.8f));
-	text.setPosition(Vec3(pos.getX() - text.getWidth() / 2.0f, pos.getY() - text.getHeight() / 2.0f, -0.7f));
-	text.setScale(radius / 50.0f * 32 / font->getSize());
-}
+	// everything that moves is drawn between its last two ticks, so it moves smoothly at any frame rate
+	Vec2 cannonPos(m_sim.getPrevCannonX() + (m_sim.getCannonX() - m_sim.getPrevCannonX()) * alpha, m_sim.getCannonY());
+	float barrelRot = m_simInput.aim;
 
-void CannonGame::Boulder::update(float dt)
-{
-	vel += Vec2(0.0f, GRAVITY * dt);
-	pos += vel * dt;
-	rot += rotStep * dt;
+	m_shapes.drawQuad(Vec3(SCR_WIDTH / 2, FLOOR_HEIGHT / 2, 0.0f), Vec2(SCR_WIDTH, FLOOR_HEIGHT), 0.0f, Vec4(0.5f, 0.8f, 0.0f, 1.0f));
+	m_shapes.drawQuad(Vec3(cannonPos.getX(), FLOOR_HEIGHT + CANNON_BODY_HEIGHT / 2, 0.0f), Vec2(CANNON_BODY_WIDTH, CANNON_BODY_HEIGHT), 0.0f, Vec4(Vec3::Brown(), 1.0f));
+	Vec2 barrelOffset = Vec2(-Sin(Radians(barrelRot)), Cos(Radians(barrelRot))) * (CANNON_BARREL_HEIGHT / 4.0f);
+	m_shapes.drawQuad(Vec3(cannonPos + barrelOffset, 0.0f), Vec2(CANNON_BARREL_WIDTH, CANNON_BARREL_HEIGHT), barrelRot, Vec4(Vec3::LightGray() * 0.65f, 1.0f));
 
-	outer.setPosition(Vec3(pos.getX(), pos.getY(), -1.0f));
-	outer.setRotation(Vec3(0.0f, 0.0f, rot));
+	const CannonBalls& balls = m_sim.getBalls();
+	for (uint i = 0; i < balls.size(); i++)
+	{
+		float x = balls.prevX[i] + (balls.posX[i] - balls.prevX[i]) * alpha;
+		float y = balls.prevY[i] + (balls.posY[i] - balls.prevY[i]) * alpha;
+		m_shapes.drawCircle(Vec3(x, y, -0.5f), BALL_RADIUS, BALL_SEGMENTS, balls.prevRot[i] + (balls.rot[i] - balls.prevRot[i]) * alpha, Vec4::Black());
+	}
 
-	inner.setPosition(Vec3(pos.getX(), pos.getY(), -0.9f));
-	inner.setRotation(Vec3(0.0f, 0.0f, rot));
+	const Boulders& boulders = m_sim.getBoulders();
+	for (uint i = 0; i < boulders.size(); i++)
+	{
+		float x = boulders.prevX[i] + (boulders.posX[i] - boulders.prevX[i]) * alpha;
+		float y = boulders.prevY[i] + (boulders.posY[i] - boulders.prevY[i]) * alpha;
+		float rot = boulders.prevRot[i] + (boulders.rot[i] - boulders.prevRot[i]) * alpha;
+		m_shapes.drawCircle(Vec3(x, y, -1.0f), boulders.radius[i] * BOULDER_OUTLINE_RATIO, boulders.nSegments[i], rot, Vec4::Black());
+		m_shapes.drawCircle(Vec3(x, y, -0.9f), boulders.radius[i], boulders.nSegments[i], rot, Vec4(colors[boulders.colors[i]], 1.0f));
+
+		uint slot = boulders.tags[i];
+		AtlasText3D& text = m_boulderTexts[slot];
+		if (m_textHealth[slot] != boulders.health[i])
+		{
+			m_textHealth[slot] = boulders.health[i];
+			text.setText(std::to_string(boulders.health[i]));
+		}
+		text.setPosition(Vec3(x - text.getWidth() / 2.0f, y - text.getHeight() / 2.0f, -0.7f));
+	}
 
-	text.setPosition(Vec3(pos.getX() - text.getWidth() / 2.0f, pos.getY() - text.getHeight() / 2.0f, -0.7f));
+	m_renderQueue.render();
 }
 
-void CannonGame::Boulder::render(const Camera& cam)
+double CannonGame::Game::getTickRate() const
 {
-	outer.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-	inner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-	text.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
+	return TICK_RATE;
 }
 
-void CannonGame::Boulder::damage(int amount)
+void CannonGame::Game::unload()
 {
-	health -= amount;
-	text.setText(std::to_string(health));
-	text.setPosition(Vec3(pos.getX() - text.getWidth() / 2.0f, pos.getY() - text.getHeight() / 2.0f, -0.7f));
+	AssetLoader::Cancel(m_assets);
+	// the boulder text is disposed along with the queue
+	m_renderQueue.dispose();
+	m_boulderTexts.clear();
+	m_freeTexts.clear();
+	m_textHealth.clear();
+	m_crosshair.dispose();
+	if (m_fontHandle.isLoaded()) m_fontHandle.get().dispose();
+}
 
-	if (health <= 0) destroyed = true;
+const RenderQueue* CannonGame::Game::getRenderQueue() const
+{
+	return &m_renderQueue;
 }
 
-bool CannonGame::Boulder::collision(const CannonBall& ball)
+void CannonGame::Game::addTextSlot()
 {
-	return (pos - ball.pos).magnitude() < radius + BALL_RADIUS;
+	// sized for six digits, so health going up never has to grow the text's buffer either
+	m_boulderTexts.emplace_back("000000", m_font, Vec4::White(0.8f));
+	m_boulderTexts.back().hide();
+	m_renderQueue.add(m_boulderTexts.back());
+	m_freeTexts.push_back(m_boulderTexts.size() - 1);
+	m_textHealth.push_back(-1);
 }
 
-void CannonGame::Boulder::dispose()
+uint CannonGame::Game::acquireText(float radius)
 {
-	outer.dispose();
-	inner.dispose();
-	text.dispose();
+	if (m_freeTexts.empty()) addTextSlot();
+
+	uint slot = m_freeTexts.back();
+	m_freeTexts.pop_back();
+
+	// the text itself is set the next time the boulder is drawn
+	m_textHealth[slot] = -1;
+	AtlasText3D& text = m_boulderTexts[slot];
+	text.setScale(radius / 50.0f * 32 / m_font.getSize());
+	text.show();
+	return slot;
 }
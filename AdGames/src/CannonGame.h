@@ -1,53 +1,62 @@
 #pragma once
 
-#include <initializer_list>
+#include <deque>
+#include <vector>
 #include <Onyx/Core.h>
 #include <Onyx/Renderer.h>
 #include <Onyx/Math.h>
+#include <Onyx/InputHandler.h>
 
-using Onyx::Renderable, Onyx::Camera, Onyx::Math::Vec2, Onyx::Math::Vec3, Onyx::TextRenderable3D, Onyx::Font;
+#include "engine/ShapeBatch.h"
+#include "engine/RenderQueue.h"
+#include "engine/SceneManager.h"
+#include "engine/AssetLoader.h"
+
+#include "CannonSim.h"
+
+using Onyx::ShapeBatch, Onyx::RenderQueue, Onyx::RenderHandle, Onyx::Camera, Onyx::Math::Vec2, Onyx::Math::Vec3, Onyx::AtlasText3D, Onyx::AtlasFont;
 
 namespace CannonGame
 {
-	void Run();
-
-	class CannonBall
+	class Game : public Onyx::Scene
 	{
 	public:
-		CannonBall();
-		CannonBall(Vec2 vel, Vec2 pos, float rot, float rotStep, Renderable* renderable);
-
-		void update(float dt);
-		void render(const Camera& cam);
-
-		Vec2 vel, pos;
-		float rot, rotStep;
+		Game();
 
-	private:
-		Renderable* renderable;
-	};
-
-	class Boulder
-	{
-	public:
-		Boulder();
-		Boulder(Vec2 vel, Vec2 pos, float rot, float rotStep, float radius, int nSegments, int health, Vec3 color, Font* font);
-
-		void update(float dt);
-		void render(const Camera& cam);
-		void damage(int amount);
-		bool collision(const CannonBall& ball);
-		void dispose();
-
-		Vec2 vel, pos;
-		float rot, rotStep, radius;
-		int nSegments, health;
-		Vec3 color;
-		Font* font;
-		bool destroyed;
+		void load(Onyx::SceneManager& manager) override;
+		bool finishLoad() override;
+		void update(double dt) override;
+		void tick(double dt) override;
+		void render(double alpha) override;
+		void unload() override;
+		double getTickRate() const override;
+		const RenderQueue* getRenderQueue() const override;
 
 	private:
-		Renderable outer, inner;
-		TextRenderable3D text;
+		Onyx::SceneManager* m_pManager;
+		Onyx::InputHandler m_input;
+		Camera m_cam;
+		RenderQueue m_renderQueue;
+		ShapeBatch m_shapes;
+		Onyx::Cursor m_crosshair;
+
+		CannonSim m_sim;
+		CannonInput m_simInput;
+
+		// every boulder text is created and queued once in finishLoad(), then hidden and reused, so spawning never touches GL objects
+		// a deque so the queue's pointers stay valid if the pool ever has to grow
+		std::deque<AtlasText3D> m_boulderTexts;
+		std::vector<uint> m_freeTexts;
+
+		std::vector<int> m_textHealth;
+
+		// every asset the game loads belongs to the group, so leaving while they load cancels only them
+		Onyx::AssetGroup m_assets;
+		Onyx::AssetHandle<AtlasFont> m_fontHandle;
+		AtlasFont m_font;
+		AtlasText3D m_nMissedText, m_nDestroyedText;
+
+		void addTextSlot();
+		uint acquireText(float radius);
 	};
 };
@@ -0,0 +1,434 @@
+#include "CannonSim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+const float BALL_SPAWN_INTERVAL = 0.1f;
+const float BOULDER_SPAWN_INTERVAL = 2.0f;
+const int	BOULDER_STARTING_HEALTH = 5, BOULDER_STARTING_RADIUS = 50, BOULDER_STARTING_SEGMENTS = 5;
+const float BOUDLER_HEALTH_RANGE = 5, BOULDER_HEALTH_INC = 5;
+const float BOULDER_RADIUS_RANGE = 25, BOULDER_RADIUS_INC = 0.3;
+const float BOULDER_SEGMENTS_RANGE = 2.0f, BOULDER_SEGMENTS_INC = 0.02f;
+const float DAMAGE_INC = 0.25f;
+
+// a few balls wide, so a boulder only looks at the handful of cells it covers
+const float BALL_CELL_SIZE = 64.0f;
+
+// roughly how long a ball lasts in the stress settings, leaving the screen or hitting a boulder, used to turn a number of balls into a spawn rate
+const float STRESS_BALL_LIFETIME = 0.85f;
+
+const float PI = 3.14159265358979f;
+
+// moves the last element into the removed one's place, so removing is constant time but doesn't keep the order
+template<typename T>
+static void SwapRemove(std::vector<T>& array, uint index)
+{
+	if (index + 1 != array.size()) array[index] = std::move(array.back());
+	array.pop_back();
+}
+
+// the arrays never overlap, and a plain loop over two float arrays is one the compiler vectorizes
+static void Integrate(float* __restrict pValues, const float* __restrict pRates, uint n, float dt)
+{
+	for (uint i = 0; i < n; i++) pValues[i] += pRates[i] * dt;
+}
+
+CannonGame::CannonSimSettings CannonGame::CannonSimSettings::Default()
+{
+	CannonSimSettings settings;
+	settings.ballSpawnInterval = BALL_SPAWN_INTERVAL;
+	settings.boulderSpawnInterval = BOULDER_SPAWN_INTERVAL;
+	settings.boulderStartingHealth = BOULDER_STARTING_HEALTH;
+	settings.boulderHealthRange = BOUDLER_HEALTH_RANGE;
+	settings.boulderHealthInc = BOULDER_HEALTH_INC;
+	settings.boulderStartingRadius = BOULDER_STARTING_RADIUS;
+	settings.boulderRadiusRange = BOULDER_RADIUS_RANGE;
+	settings.boulderRadiusInc = BOULDER_RADIUS_INC;
+	settings.boulderStartingSegments = BOULDER_STARTING_SEGMENTS;
+	settings.boulderSegmentsRange = BOULDER_SEGMENTS_RANGE;
+	settings.boulderSegmentsInc = BOULDER_SEGMENTS_INC;
+	settings.damageInc = DAMAGE_INC;
+	settings.ballRotEnabled = true;
+	return settings;
+}
+
+CannonGame::CannonSimSettings CannonGame::CannonSimSettings::Stress(uint nBalls)
+{
+	CannonSimSettings settings = Default();
+	settings.ballSpawnInterval = STRESS_BALL_LIFETIME / std::max(nBalls, 1u);
+	settings.boulderSpawnInterval = 1.0f;
+	settings.boulderStartingHealth = 100000;
+	settings.boulderHealthInc = 0.0f;
+	settings.boulderStartingRadius = 50.0f;
+	settings.boulderRadiusRange = 20.0f;
+	settings.boulderRadiusInc = 0.0f;
+	settings.boulderSegmentsInc = 0.0f;
+	settings.damageInc = 0.0f;
+	return settings;
+}
+
+CannonGame::CannonSim::CannonSim()
+	: CannonSim(0)
+{
+}
+
+CannonGame::CannonSim::CannonSim(ulonglong seed, const CannonSimSettings& settings)
+	: m_settings(settings), m_random(seed), m_ballHash(BALL_CELL_SIZE)
+{
+	m_cannonX = m_prevCannonX = SCR_WIDTH / 2;
+	m_boulderSpawnTimer = m_ballSpawnTimer = 0.0f;
+	m_boulderHealthMin = settings.boulderStartingHealth;
+	m_boulderRadiusMin = settings.boulderStartingRadius;
+	m_boulderSegmentsMin = settings.boulderStartingSegments;
+	m_damage = 1.0f;
+	m_nDestroyed = m_nMissed = 0;
+	m_steps = 0;
+}
+
+void CannonGame::CannonSim::step(const CannonInput& input, float dt)
+{
+	m_steps++;
+	m_removedTags.clear();
+
+	// the remainder carries over, so spawn rates hold at any tick rate, even when several spawns fall in one step
+	m_boulderSpawnTimer += dt;
+	while (m_boulderSpawnTimer >= m_settings.boulderSpawnInterval)
+	{
+		m_boulderSpawnTimer -= m_settings.boulderSpawnInterval;
+		spawnBoulder();
+	}
+
+	m_ballSpawnTimer += dt;
+	while (m_ballSpawnTimer >= m_settings.ballSpawnInterval)
+	{
+		m_ballSpawnTimer -= m_settings.ballSpawnInterval;
+		// what's left on the timer is how long ago in this step the ball was fired, so balls fired in the same step don't all start in the same spot
+		spawnBall(std::clamp(input.aim, -60.0f, 60.0f), m_ballSpawnTimer - dt);
+	}
+
+	m_prevCannonX = m_cannonX;
+	m_cannonX = std::clamp(m_cannonX + input.strafe * STRAFE_SPEED * dt, CANNON_BODY_WIDTH / 2.0f, SCR_WIDTH - CANNON_BODY_WIDTH / 2.0f);
+
+	m_balls.update(dt);
+	m_boulders.update(dt);
+
+	collide();
+	removeDead();
+}
+
+CannonGame::CannonInput CannonGame::CannonSim::SweepInput(ulonglong tick, double tickRate)
+{
+	// the barrel sweeps every 4 seconds and the cannon crosses the screen every 10, so the two never line up
+	double time = tick / tickRate;
+
+	CannonInput input;
+	input.aim = (float)(60.0 * std::sin(time * 2.0 * PI / 4.0));
+	input.strafe = std::fmod(time, 10.0) < 5.0 ? 1 : -1;
+	return input;
+}
+
+const CannonGame::CannonBalls& CannonGame::CannonSim::getBalls() const
+{
+	return m_balls;
+}
+
+const CannonGame::Boulders& CannonGame::CannonSim::getBoulders() const
+{
+	return m_boulders;
+}
+
+void CannonGame::CannonSim::setTag(uint boulder, uint tag)
+{
+	m_boulders.tags[boulder] = tag;
+}
+
+const std::vector<uint>& CannonGame::CannonSim::getRemovedTags() const
+{
+	return m_removedTags;
+}
+
+float CannonGame::CannonSim::getCannonX() const
+{
+	return m_cannonX;
+}
+
+float CannonGame::CannonSim::getPrevCannonX() const
+{
+	return m_prevCannonX;
+}
+
+float CannonGame::CannonSim::getCannonY() const
+{
+	return FLOOR_HEIGHT + CANNON_BODY_HEIGHT;
+}
+
+int CannonGame::CannonSim::getDestroyedCount() const
+{
+	return m_nDestroyed;
+}
+
+int CannonGame::CannonSim::getMissedCount() const
+{
+	return m_nMissed;
+}
+
+ulonglong CannonGame::CannonSim::getStepCount() const
+{
+	return m_steps;
+}
+
+const CannonGame::CannonSimSettings& CannonGame::CannonSim::getSettings() const
+{
+	return m_settings;
+}
+
+void CannonGame::CannonSim::spawnBoulder()
+{
+	bool left = m_random.range(0, 1);
+	float rot = m_random.range(0.0f, 360.0f);
+	float rotStep = m_random.range(BOULDER_ROT_SPEED_MIN, BOULDER_ROT_SPEED_MAX);
+	if (left) rotStep = -rotStep;
+	float radius = m_random.range(m_boulderRadiusMin, m_boulderRadiusMin + m_settings.boulderRadiusRange);
+	int nSegments = m_random.range((int)m_boulderSegmentsMin, (int)(m_boulderSegmentsMin + m_settings.boulderSegmentsRange));
+	int health = m_random.range((int)m_boulderHealthMin, (int)(m_boulderHealthMin + m_settings.boulderHealthRange));
+
+	float velX = m_random.range(BOULDER_VEL_MIN_X, BOULDER_VEL_MAX_X);
+	float velY = m_random.range(BOULDER_VEL_MIN_Y, BOULDER_VEL_MAX_Y);
+	float posX = left ? -radius : SCR_WIDTH + radius;
+	if (!left) velX = -velX;
+
+	m_boulders.spawn(velX, velY, posX, SCR_HEIGHT - 100.0f, rot, rotStep, radius, nSegments, health, m_random.range(0, BOULDER_COLOR_COUNT - 1));
+
+	m_boulderHealthMin += m_settings.boulderHealthInc;
+	m_boulderRadiusMin += m_settings.boulderRadiusInc;
+	m_boulderSegmentsMin += m_settings.boulderSegmentsInc;
+
+	m_damage += m_settings.damageInc;
+}
+
+void CannonGame::CannonSim::spawnBall(float aim, float lead)
+{
+	float angle = (aim + 90.0f) * PI / 180.0f;
+	float dirX = std::cos(angle), dirY = std::sin(angle);
+	float offset = 3.0f * CANNON_BARREL_HEIGHT / 4.0f - BALL_RADIUS;
+
+	float rot = m_settings.ballRotEnabled ? m_random.range(0.0f, 360.0f) : 0.0f;
+	float rotStep = m_settings.ballRotEnabled ? m_random.range(BALL_ROT_SPEED_MIN, BALL_ROT_SPEED_MAX) : 0.0f;
+	// the step's update moves every ball a whole step, so one fired partway through the step starts that much further back
+	offset += BALL_SPEED * lead;
+	m_balls.spawn(dirX * BALL_SPEED, dirY * BALL_SPEED, m_cannonX + dirX * offset, getCannonY() + dirY * offset, rot, rotStep);
+}
+
+void CannonGame::CannonSim::collide()
+{
+	m_ballHash.clear();
+	for (uint i = 0; i < m_balls.size(); i++) m_ballHash.insert(i, m_balls.posX[i], m_balls.posY[i]);
+	m_ballHash.build();
+	m_ballHit.assign(m_balls.size(), false);
+
+	for (uint b = 0; b < m_boulders.size(); b++)
+	{
+		// a ball is used up by the first boulder it hits, and a boulder keeps using up balls for the rest of the step once it's destroyed
+		float x = m_boulders.posX[b], y = m_boulders.posY[b];
+		float reach = m_boulders.radius[b] + BALL_RADIUS;
+		int hits = 0;
+		m_ballHash.query(x - reach, y - reach, x + reach, y + reach, [&](uint i)
+		{
+			float dx = m_balls.posX[i] - x, dy = m_balls.posY[i] - y;
+			if (m_ballHit[i] || dx * dx + dy * dy >= reach * reach) return;
+			m_ballHit[i] = true;
+			hits++;
+		});
+
+		m_boulders.health[b] -= hits * (int)m_damage;
+	}
+}
+
+void CannonGame::CannonSim::removeDead()
+{
+	// backwards, so whatever a removal moves into place has already been looked at
+	for (uint i = m_balls.size(); i-- > 0;)
+	{
+		float x = m_balls.posX[i], y = m_balls.posY[i];
+		if (m_ballHit[i] || x > SCR_WIDTH + BALL_RADIUS || x < -BALL_RADIUS || y > SCR_HEIGHT + BALL_RADIUS) m_balls.remove(i);
+	}
+
+	for (uint i = m_boulders.size(); i-- > 0;)
+	{
+		bool destroyed = m_boulders.health[i] <= 0;
+		bool missed = m_boulders.posY[i] < FLOOR_HEIGHT - m_boulders.radius[i];
+		if (!destroyed && !missed) continue;
+
+		if (destroyed) m_nDestroyed++;
+		else m_nMissed++;
+
+		if (m_boulders.tags[i] != NO_TAG) m_removedTags.push_back(m_boulders.tags[i]);
+		m_boulders.remove(i);
+	}
+}
+
+void CannonGame::CannonBalls::spawn(float velX, float velY, float posX, float posY, float rot, float rotStep)
+{
+	this->posX.push_back(posX);
+	this->posY.push_back(posY);
+	prevX.push_back(posX);
+	prevY.push_back(posY);
+	this->velX.push_back(velX);
+	this->velY.push_back(velY);
+	this->rot.push_back(rot);
+	prevRot.push_back(rot);
+	this->rotStep.push_back(rotStep);
+}
+
+void CannonGame::CannonBalls::remove(uint index)
+{
+	SwapRemove(posX, index);
+	SwapRemove(posY, index);
+	SwapRemove(prevX, index);
+	SwapRemove(prevY, index);
+	SwapRemove(velX, index);
+	SwapRemove(velY, index);
+	SwapRemove(rot, index);
+	SwapRemove(prevRot, index);
+	SwapRemove(rotStep, index);
+}
+
+void CannonGame::CannonBalls::update(float dt)
+{
+	prevX = posX;
+	prevY = posY;
+	prevRot = rot;
+	Integrate(posX.data(), velX.data(), size(), dt);
+	Integrate(posY.data(), velY.data(), size(), dt);
+	Integrate(rot.data(), rotStep.data(), size(), dt);
+}
+
+void CannonGame::CannonBalls::clear()
+{
+	for (std::vector<float>* pArray : { &posX, &posY, &prevX, &prevY, &velX, &velY, &rot, &prevRot, &rotStep }) pArray->clear();
+}
+
+uint CannonGame::CannonBalls::size() const
+{
+	return posX.size();
+}
+
+void CannonGame::Boulders::spawn(float velX, float velY, float posX, float posY, float rot, float rotStep, float radius, int nSegments, int health, uint color)
+{
+	this->posX.push_back(posX);
+	this->posY.push_back(posY);
+	prevX.push_back(posX);
+	prevY.push_back(posY);
+	this->velX.push_back(velX);
+	this->velY.push_back(velY);
+	this->rot.push_back(rot);
+	prevRot.push_back(rot);
+	this->rotStep.push_back(rotStep);
+	this->radius.push_back(radius);
+	this->nSegments.push_back(nSegments);
+	this->health.push_back(health);
+	colors.push_back(color);
+	tags.push_back(CannonSim::NO_TAG);
+}
+
+void CannonGame::Boulders::remove(uint index)
+{
+	SwapRemove(posX, index);
+	SwapRemove(posY, index);
+	SwapRemove(prevX, index);
+	SwapRemove(prevY, index);
+	SwapRemove(velX, index);
+	SwapRemove(velY, index);
+	SwapRemove(rot, index);
+	SwapRemove(prevRot, index);
+	SwapRemove(rotStep, index);
+	SwapRemove(radius, index);
+	SwapRemove(nSegments, index);
+	SwapRemove(health, index);
+	SwapRemove(colors, index);
+	SwapRemove(tags, index);
+}
+
+void CannonGame::Boulders::update(float dt)
+{
+	prevX = posX;
+	prevY = posY;
+	prevRot = rot;
+
+	float* pVelY = velY.data();
+	for (uint i = 0; i < size(); i++) pVelY[i] += GRAVITY * dt;
+
+	Integrate(posX.data(), velX.data(), size(), dt);
+	Integrate(posY.data(), velY.data(), size(), dt);
+	Integrate(rot.data(), rotStep.data(), size(), dt);
+}
+
+void CannonGame::Boulders::clear()
+{
+	for (std::vector<float>* pArray : { &posX, &posY, &prevX, &prevY, &velX, &velY, &rot, &prevRot, &rotStep, &radius }) pArray->clear();
+	nSegments.clear();
+	health.clear();
+	colors.clear();
+	tags.clear();
+}
+
+uint CannonGame::Boulders::size() const
+{
+	return posX.size();
+}
+
+int CannonGame::RunBenchmark(uint nBalls, double seconds, ulonglong seed)
+{
+	const double tickRate = 120.0;
+	const float dt = (float)(1.0 / tickRate);
+	// the number of balls in the air takes about one ball lifetime to level off, that ramp isn't timed
+	const ulonglong warmupSteps = (ulonglong)(2.0 * tickRate);
+	const ulonglong steps = (ulonglong)(seconds * tickRate);
+
+	CannonSim sim(seed, CannonSimSettings::Stress(nBalls));
+	for (ulonglong i = 0; i < warmupSteps; i++) sim.step(CannonSim::SweepInput(sim.getStepCount(), tickRate), dt);
+
+	double total = 0.0, worst = 0.0;
+	ulonglong ballSum = 0, boulderSum = 0;
+	for (ulonglong i = 0; i < steps; i++)
+	{
+		CannonInput input = CannonSim::SweepInput(sim.getStepCount(), tickRate);
+
+		auto start = std::chrono::steady_clock::now();
+		sim.step(input, dt);
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		total += elapsed;
+		worst = std::max(worst, elapsed);
+		ballSum += sim.getBalls().size();
+		boulderSum += sim.getBoulders().size();
+	}
+
+	// the same seed always gives the same checksum with the same build, to check a change didn't alter the simulation
+	ulonglong checksum = 14695981039346656037ull;
+	auto mix = [&](const std::vector<float>& values)
+	{
+		for (float value : values)
+		{
+			uint bits;
+			memcpy(&bits, &value, sizeof(bits));
+			checksum = (checksum ^ bits) * 1099511628211ull;
+		}
+	};
+	mix(sim.getBalls().posX);
+	mix(sim.getBalls().posY);
+	mix(sim.getBoulders().posX);
+	mix(sim.getBoulders().posY);
+
+	std::cout << "cannon benchmark: " << nBalls << " balls, seed " << seed << ", " << steps << " ticks at " << tickRate << " Hz" << std::endl;
+	std::cout << "  balls in the air:    " << (steps ? ballSum / steps : 0) << " on average" << std::endl;
+	std::cout << "  boulders in the air: " << (steps ? boulderSum / steps : 0) << " on average" << std::endl;
+	std::cout << "  tick:                " << (steps ? total / steps * 1e6 : 0.0) << " us on average, " << worst * 1e6 << " us at worst" << std::endl;
+	std::cout << "  destroyed " << sim.getDestroyedCount() << ", missed " << sim.getMissedCount() << std::endl;
+	std::cout << "  checksum " << std::hex << checksum << std::dec << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <initializer_list>
+#include <vector>
+
+#include <Onyx/Core.h>
+
+#include "engine/Random.h"
+#include "engine/SpatialHash.h"
+
+namespace CannonGame
+{
+	const int SCR_WIDTH = 1280, SCR_HEIGHT = 720;
+
+	const int FLOOR_HEIGHT = 150;
+	const int CANNON_BODY_WIDTH = 100, CANNON_BODY_HEIGHT = 50;
+	const int CANNON_BARREL_WIDTH = 30, CANNON_BARREL_HEIGHT = 100;
+
+	const int BALL_RADIUS = 10;
+	const float BALL_SPEED = 500.0f;
+	const float BALL_ROT_SPEED_MIN = 50.0f, BALL_ROT_SPEED_MAX = 200.0f;
+
+	const float BOULDER_VEL_MIN_X = 200.0f, BOULDER_VEL_MAX_X = 400.0f;
+	const float BOULDER_VEL_MIN_Y = 0.0f, BOULDER_VEL_MAX_Y = 50.0f;
+	const float BOULDER_ROT_SPEED_MIN = 20.0f, BOULDER_ROT_SPEED_MAX = 100.0f;
+	// boulders are given one of this many colors, the game picks the actual colors
+	const int BOULDER_COLOR_COUNT = 9;
+
+	const float STRAFE_SPEED = 200.0f;
+	const float GRAVITY = -100.0f;
+
+	/*
+		@brief What the player does during one tick.
+	 */
+	struct CannonInput
+	{
+		// the barrel's rotation in degrees, 0 is straight up, positive is to the left, clamped to [-60, 60]
+		float aim = 0.0f;
+		// -1 to move left, 1 to move right, 0 to stay put
+		int strafe = 0;
+	};
+
+	/*
+		@brief The spawn rates and boulder progression of a simulation.
+		The boulder values are a starting minimum, the range above the minimum they're picked from, and how much the minimum grows with every boulder spawned.
+	 */
+	struct CannonSimSettings
+	{
+		float ballSpawnInterval;
+		float boulderSpawnInterval;
+		float boulderStartingHealth, boulderHealthRange, boulderHealthInc;
+		float boulderStartingRadius, boulderRadiusRange, boulderRadiusInc;
+		float boulderStartingSegments, boulderSegmentsRange, boulderSegmentsInc;
+		float damageInc;
+		bool ballRotEnabled;
+
+		/*
+			@brief Gets the settings the game is played with.
+			@return The settings.
+		 */
+		static CannonSimSettings Default();
+
+		/*
+			@brief Gets settings that keep roughly the specified number of balls in the air, with large boulders that take a long time to destroy,
+				so collisions keep happening the whole time. For benchmarking the tick.
+			@param nBalls The number of balls to keep in the air.
+			@return The settings.
+		 */
+		static CannonSimSettings Stress(uint nBalls);
+	};
+
+	/*
+		@brief The cannon balls in flight, stored as a structure of arrays so the per-tick integration is one pass over contiguous floats.
+		Element i of every array belongs to ball i. The prev arrays hold the positions and rotations from before the last update, for interpolating between ticks.
+		Removing a ball moves the last one into its place, so indices change when balls are removed.
+	 */
+	class CannonBalls
+	{
+	public:
+		/*
+			@brief Adds a ball at the end of the arrays.
+			@param velX The x velocity, in pixels per second.
+			@param velY The y velocity, in pixels per second.
+			@param posX The x coordinate of the center.
+			@param posY The y coordinate of the center.
+			@param rot The rotation, in degrees.
+			@param rotStep The rotation speed, in degrees per second.
+		 */
+		void spawn(float velX, float velY, float posX, float posY, float rot, float rotStep);
+
+		/*
+			@brief Removes a ball, moving the last ball into its place.
+			@param index The index of the ball.
+		 */
+		void remove(uint index);
+
+		/*
+			@brief Moves and rotates every ball, after copying the current positions and rotations to the prev arrays.
+			@param dt The time to advance by, in seconds.
+		 */
+		void update(float dt);
+
+		/*
+			@brief Removes every ball, keeping the memory.
+		 */
+		void clear();
+
+		/*
+			@brief Gets the number of balls.
+			@return The number of balls.
+		 */
+		uint size() const;
+
+		std::vector<float> posX, posY, prevX, prevY;
+		std::vector<float> velX, velY;
+		std::vector<float> rot, prevRot, rotStep;
+	};
+
+	/*
+		@brief The boulders in the air, stored the same way as the cannon balls.
+		Each boulder has a tag the simulation doesn't use, for whoever draws it to keep track of what it created for it.
+	 */
+	class Boulders
+	{
+	public:
+		/*
+			@brief Adds a boulder at the end of the arrays, with CannonSim::NO_TAG as its tag.
+			@param velX The x velocity, in pixels per second.
+			@param velY The y velocity, in pixels per second.
+			@param posX The x coordinate of the center.
+			@param posY The y coordinate of the center.
+			@param rot The rotation, in degrees.
+			@param rotStep The rotation speed, in degrees per second.
+			@param radius The radius.
+			@param nSegments The number of sides of its polygon.
+			@param health The damage it takes to destroy it.
+			@param color The index of its color, less than BOULDER_COLOR_COUNT.
+		 */
+		void spawn(float velX, float velY, float posX, float posY, float rot, float rotStep, float radius, int nSegments, int health, uint color);
+
+		/*
+			@brief Removes a boulder, moving the last boulder into its place.
+			@param index The index of the boulder.
+		 */
+		void remove(uint index);
+
+		/*
+			@brief Applies gravity, then moves and rotates every boulder, after copying the current positions and rotations to the prev arrays.
+			@param dt The time to advance by, in seconds.
+		 */
+		void update(float dt);
+
+		/*
+			@brief Removes every boulder, keeping the memory.
+		 */
+		void clear();
+
+		/*
+			@brief Gets the number of boulders.
+			@return The number of boulders.
+		 */
+		uint size() const;
+
+		std::vector<float> posX, posY, prevX, prevY;
+		std::vector<float> velX, velY;
+		std::vector<float> rot, prevRot, rotStep;
+		std::vector<float> radius;
+		std::vector<int> nSegments, health;
+		std::vector<uint> colors;
+		std::vector<uint> tags;
+	};
+
+	/*
+		@brief Everything that happens in a game of Cannon, without a window, a GL context or anything else from Onyx that isn't in its headers.
+		The random numbers come from a seeded generator and the player's input is passed to every step, so a seed and a sequence of inputs always replay the same game.
+		Balls hitting boulders are found through a spatial hash rebuilt every step.
+	 */
+	class CannonSim
+	{
+	public:
+		/*
+			@brief The tag of a boulder that hasn't been given one yet.
+		 */
+		static const uint NO_TAG = 0xFFFFFFFF;
+
+		/*
+			@brief Default constructor, creates a simulation with seed 0 and the default settings.
+		 */
+		CannonSim();
+
+		/*
+			@brief Creates a simulation.
+			@param seed The seed of its random numbers.
+			@param settings The spawn rates and boulder progression.
+		 */
+		CannonSim(ulonglong seed, const CannonSimSettings& settings = CannonSimSettings::Default());
+
+		/*
+			@brief Advances the simulation. Steps should all be the same length for the simulation to be reproducible.
+			@param input What the player does during the step.
+			@param dt The time simulated by the step, in seconds.
+		 */
+		void step(const CannonInput& input, float dt);
+
+		/*
+			@brief Gets an input that sweeps the barrel from side to side and strafes back and forth, for playing a simulation without a player.
+			@param tick The number of the step the input is for.
+			@param tickRate The number of steps per second.
+			@return The input.
+		 */
+		static CannonInput SweepInput(ulonglong tick, double tickRate);
+
+		/*
+			@brief Gets the cannon balls in flight.
+			@return The balls.
+		 */
+		const CannonBalls& getBalls() const;
+
+		/*
+			@brief Gets the boulders in the air.
+			@return The boulders.
+		 */
+		const Boulders& getBoulders() const;
+
+		/*
+			@brief Tags a boulder. Boulders spawned during the last step have NO_TAG.
+			@param boulder The index of the boulder.
+			@param tag The tag, anything but NO_TAG.
+		 */
+		void setTag(uint boulder, uint tag);
+
+		/*
+			@brief Gets the tags of the boulders removed during the last step, destroyed or missed. Untagged boulders aren't included.
+			@return The tags.
+		 */
+		const std::vector<uint>& getRemovedTags() const;
+
+		/*
+			@brief Gets the x coordinate of the center of the cannon.
+			@return The x coordinate.
+		 */
+		float getCannonX() const;
+
+		/*
+			@brief Gets the x coordinate of the center of the cannon before the last step, for interpolating between ticks.
+			@return The x coordinate.
+		 */
+		float getPrevCannonX() const;
+
+		/*
+			@brief Gets the y coordinate the barrel pivots around.
+			@return The y coordinate.
+		 */
+		float getCannonY() const;
+
+		/*
+			@brief Gets the number of boulders destroyed so far.
+			@return The number of boulders.
+		 */
+		int getDestroyedCount() const;
+
+		/*
+			@brief Gets the number of boulders that fell past the floor so far.
+			@return The number of boulders.
+		 */
+		int getMissedCount() const;
+
+		/*
+			@brief Gets the number of steps taken so far.
+			@return The number of steps.
+		 */
+		ulonglong getStepCount() const;
+
+		/*
+			@brief Gets the settings the simulation was created with.
+			@return The settings.
+		 */
+		const CannonSimSettings& getSettings() const;
+
+	private:
+		CannonSimSettings m_settings;
+		Onyx::Random m_random;
+
+		CannonBalls m_balls;
+		Boulders m_boulders;
+		std::vector<uint> m_removedTags;
+
+		Onyx::SpatialHash m_ballHash;
+		std::vector<ubyte> m_ballHit;
+
+		float m_cannonX, m_prevCannonX;
+		float m_boulderSpawnTimer, m_ballSpawnTimer;
+		float m_boulderHealthMin, m_boulderRadiusMin, m_boulderSegmentsMin;
+		float m_damage;
+		int m_nDestroyed, m_nMissed;
+		ulonglong m_steps;
+
+		void spawnBoulder();
+		void spawnBall(float aim, float lead);
+		void collide();
+		void removeDead();
+	};
+
+	/*
+		@brief Runs a CannonSim with the stress settings as fast as it can, sweeping the cannon with CannonSim::SweepInput(), and prints how long the ticks took.
+		Needs no window or GL context.
+		@param nBalls The number of balls to keep in the air.
+		@param seconds The simulated time to measure, after a couple of seconds of warmup.
+		@param seed The seed of the simulation.
+		@return The exit code.
+	 */
+	int RunBenchmark(uint nBalls, double seconds, ulonglong seed);
+}
@@ -2,305 +2,272 @@
 
 #include "ConnectFour.h"
 
-#include "Launcher.h"
-
 #include <Onyx/Core.h>
 #include <Onyx/Window.h>
 #include <Onyx/InputHandler.h>
 #include <Onyx/Math.h>
 
-void onyx_add_malloc(void*, bool);
-
 using namespace Onyx;
 using namespace Onyx::Math;
 
-enum class Space
-{
-	Empty,
-	Red,
-	Yellow
-};
-
-enum class Player
-{
-	Red,
-	Yellow
-};
-
 const int SCR_SIZE = 1000;
 
-const int BOARD_WIDTH = 7, BOARD_HEIGHT = 6;
-Space board[BOARD_WIDTH][BOARD_HEIGHT];
-
 const float DISC_RADIUS = SCR_SIZE / 20;
+// pixels per tick, the disc falls at the same speed at any frame rate
 const float DISC_FALL_SPEED = 30.0f;
+const double TICK_RATE = 60.0;
 
-Player curPlayer = Player::Red;
+// the computer starts thinking as soon as the player's disc is dropped, so most of this is hidden by the disc falling
+const double COMPUTER_THINK_TIME = 0.5;
+
+using ConnectFour::BOARD_WIDTH;
+using ConnectFour::BOARD_HEIGHT;
+using ConnectFour::Position;
 
 Vec2 getSpacePosition(int i, int j)
 {
 	return Vec2(SCR_SIZE / BOARD_WIDTH * i + SCR_SIZE / BOARD_WIDTH / 2, (SCR_SIZE - 150) / BOARD_HEIGHT * j + SCR_SIZE / BOARD_HEIGHT / 2);
 }
 
-void render(Camera& cam, Renderable& emptyDisc, Renderable& redDiscOuter, Renderable& redDiscInner, Renderable& yellowDiscOuter, Renderable& yellowDiscInner, int hoveredColumn);
+Position::Cell getPlayerToMove(const Position& position)
+{
+	return position.getMoveCount() % 2 == 0 ? Position::Cell::Red : Position::Cell::Yellow;
+}
+
+void addDisc(InstancedRenderable& discsOuter, InstancedRenderable& discsInner, Vec2 pos, Position::Cell player, float brightness = 1.0f);
+void addBoard(InstancedRenderable& emptyDiscs, InstancedRenderable& discsOuter, InstancedRenderable& discsInner, const Position& position, int hoveredColumn);
 bool isMouseOnSpace(Vec2 mousePos, int* i, int* j);
 bool isMouseOnColumn(Vec2 mousePos, int* i);
-bool checkWinner(Player* player);
 
-void ConnectFour::Run()
+ConnectFour::Game::Game(bool vsComputer)
 {
-	Onyx::Init();
+	m_pManager = nullptr;
+	m_vsComputer = vsComputer;
+	m_over = m_discFalling = m_queuedWin = false;
+	m_queuedI = m_queuedJ = -1;
+	m_hoveredColumn = -1;
+	m_prevFallingY = 0.0f;
+}
 
-	for (int i = 0; i < BOARD_WIDTH; i++)
-	{
-		for (int j = 0; j < BOARD_HEIGHT; j++)
-		{
-			board[i][j] = Space::Empty;
-		}
-	}
+void ConnectFour::Game::load(SceneManager& manager)
+{
+	m_pManager = &manager;
+	Window& window = manager.getWindow();
 
-	Monitor monitor = Monitor::GetPrimary();
+	m_position = Position();
 
-	Window window(
+	Monitor monitor = Monitor::GetPrimary();
+	manager.configureWindow(
 		WindowProperties{
-			.title = "Connect Four",
+			.title = m_vsComputer ? "Connect Four - vs Computer (Tab for two players)" : "Connect Four - Two Players (Tab to play the computer)",
 			.width = SCR_SIZE,
 			.height = SCR_SIZE,
 			.position = IVec2(monitor.getDimensions().getX() / 2 - SCR_SIZE / 2, monitor.getDimensions().getY() / 2 - SCR_SIZE / 2),
 			.resizable = false,
 			.decorated = true,
-			.nSamplesMSAA = 16,
 			.backgroundColor = Vec3::NavyBlue() * 0.8f
 		}
 	);
 
-	window.init();
+	window.linkInputHandler(m_input);
 
-	Onyx::WindowIcon icon = Onyx::WindowIcon::Load({
-		Onyx::Resources("icons/icon-16x.png"),
-		Onyx::Resources("icons/icon-24x.png"),
-		Onyx::Resources("icons/icon-32x.png"),
-		Onyx::Resources("icons/icon-48x.png"),
-		Onyx::Resources("icons/icon-256x.png")
-	});
-	window.setIcon(icon);
-	icon.dispose();
-	
-	InputHandler input;
-	window.linkInputHandler(input);
+	m_cam = Camera(Projection::Orthographic(SCR_SIZE, SCR_SIZE));
+	window.linkCamera(m_cam);
 
-	Camera cam(Projection::Orthographic(SCR_SIZE, SCR_SIZE));
-	window.linkCamera(cam);
+	m_renderQueue = RenderQueue(window, m_cam);
 
-	Renderer renderer(cam);
-	window.linkRenderer(renderer);
+	// every disc of the same shape is drawn in one call, the color of each disc is per instance
+	m_emptyDiscs = InstancedRenderable(Mesh::Circle(DISC_RADIUS, 40), BOARD_WIDTH * BOARD_HEIGHT);
+	m_discsOuter = InstancedRenderable(Mesh::Circle(DISC_RADIUS, 40), BOARD_WIDTH * BOARD_HEIGHT + 2);
+	m_discsInner = InstancedRenderable(Mesh::Circle(DISC_RADIUS * 0.7f, 40), BOARD_WIDTH * BOARD_HEIGHT + 2);
+	m_renderQueue.add(m_emptyDiscs);
+	m_renderQueue.add(m_discsOuter);
+	m_renderQueue.add(m_discsInner);
 
-	Renderable emptyDisc = Renderable::ColoredCircle(DISC_RADIUS, 40, Vec4::Black(0.4f));
-	Renderable redDiscOuter = Renderable::ColoredCircle(DISC_RADIUS, 40, Vec4::Red());
-	Renderable redDiscInner = Renderable::ColoredCircle(DISC_RADIUS * 0.7f, 40, Vec4::Red() * 0.7f);
-	Renderable yellowDiscOuter = Renderable::ColoredCircle(DISC_RADIUS, 40, Vec4::Yellow());
-	Renderable yellowDiscInner = Renderable::ColoredCircle(DISC_RADIUS * 0.7f, 40, Vec4::Yellow() * 0.7f);
+	m_arrowCursor = Cursor::Standard(CursorType::Arrow);
+	m_handCursor = Cursor::Standard(CursorType::Hand);
+	window.setCursor(m_arrowCursor);
 
-	Cursor arrowCursor = Cursor::Standard(CursorType::Arrow);
-	Cursor handCursor = Cursor::Standard(CursorType::Hand);
-	window.setCursor(arrowCursor);
+	m_fontHandle = AssetLoader::LoadFont(Resources("fonts/Poppins/Poppins-Bold.ttf"), 72, false, m_assets);
 
-	Font font = Font::Load(Resources("fonts/Poppins/Poppins-Bold.ttf"), 72);
+	m_over = false;
+	m_discFalling = m_queuedWin = false;
 
-	Vec2 discFallingPos;
+	m_queuedI = m_queuedJ = -1;
+	m_hoveredColumn = -1;
+}
 
-	bool over = false;
-	bool discFalling = false;
+bool ConnectFour::Game::finishLoad()
+{
+	if (m_fontHandle.getState() == AssetState::Pending) return false;
+	if (m_fontHandle.isFailed())
+	{
+		m_pManager->pop();
+		return false;
+	}
 
-	int queuedI = -1, queuedJ = -1;
+	// only the result text uses the font, the board doesn't need it
+	m_font = m_fontHandle.get();
+	return true;
+}
 
-	while (window.isOpen())
-	{
-		input.update();
-		
-		if (input.isKeyTapped(Key::Escape)) window.close();
-		if (input.isKeyTapped(Key::F1)) Renderer::ToggleWireframe();
+void ConnectFour::Game::update(double dt)
+{
+	Window& window = m_pManager->getWindow();
 
-		cam.update();
+	m_input.update();
 
-		int i = -1;
-		if (!discFalling)
-		{
+	if (m_input.isKeyTapped(Key::Escape))
+	{
+		m_pManager->pop();
+		return;
+	}
+	if (m_input.isKeyTapped(Key::F1)) Renderer::ToggleWireframe();
+	if (m_input.isKeyTapped(Key::Tab))
+	{
+		m_pManager->replace(std::make_unique<Game>(!m_vsComputer));
+		return;
+	}
 
-			if (!over)
-			{
-				bool mouseOnColumn = isMouseOnColumn(input.getMousePos(), &i);
-
-				if (mouseOnColumn)
-				{
-					window.setCursor(handCursor);
-				}
-				else window.setCursor(arrowCursor);
-				if (input.isMouseButtonTapped(MouseButton::Left) && mouseOnColumn)
-				{
-					for (int j = 0; j < BOARD_HEIGHT; j++)
-					{
-						if (board[i][j] == Space::Empty)
-						{
-							queuedI = i;
-							queuedJ = j;
-							discFalling = true;
-							discFallingPos = getSpacePosition(i, BOARD_HEIGHT);
-							break;
-						}
-					}
-				}
-			}
+	m_cam.update();
 
-			if (!over)
-			{
-				Player winner;
-				if (checkWinner(&winner))
-				{
-					TextRenderable* text = new TextRenderable(winner == Player::Red ? "Red Wins!" : "Yellow Wins!", font, winner == Player::Red ? Vec4::Red() : Vec4::Yellow());
-					text->setPosition(Vec2(SCR_SIZE / 2 - text->getWidth() / 2, SCR_SIZE - 50.0f - text->getHeight()));
-					onyx_add_malloc(text, false);
-					renderer.add(*text);
-					over = true;
-					window.setCursor(arrowCursor);
-				}
-				else
-				{
-					bool draw = true;
-					for (int i = 0; i < BOARD_WIDTH; i++)
-					{
-						for (int j = 0; j < BOARD_HEIGHT; j++)
-						{
-							if (board[i][j] == Space::Empty)
-							{
-								draw = false;
-								break;
-							}
-						}
-					}
-
-					if (draw)
-					{
-						TextRenderable* text = new TextRenderable("Draw!", font, Vec4::White());
-						text->setPosition(Vec2(SCR_SIZE / 2 - text->getWidth() / 2, SCR_SIZE - 50.0f - text->getHeight()));
-						onyx_add_malloc(text, false);
-						renderer.add(*text);
-						over = true;
-						window.setCursor(arrowCursor);
-					}
-				}
-			}
+	int i = -1;
+	m_hoveredColumn = -1;
+	if (!m_discFalling && !m_over)
+	{
+		if (isComputerTurn())
+		{
+			window.setCursor(m_arrowCursor);
+			if (!m_ai.isThinking()) m_ai.think(m_position, COMPUTER_THINK_TIME);
+			if (m_ai.hasMove()) dropDisc(m_ai.takeMove().move);
 		}
-
-		window.startRender();
-		renderer.render();
-		render(cam, emptyDisc, redDiscOuter, redDiscInner, yellowDiscOuter, yellowDiscInner, i);
-		if (discFalling && curPlayer == Player::Red)
+		else
 		{
-			redDiscOuter.setPosition(Vec3(discFallingPos, 0));
-			redDiscInner.setPosition(Vec3(discFallingPos, 1));
-			redDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			redDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			discFallingPos.setY(discFallingPos.getY() - DISC_FALL_SPEED);
-			if (discFallingPos.getY() < getSpacePosition(queuedI, queuedJ).getY())
+			bool mouseOnColumn = isMouseOnColumn(m_input.getMousePos(), &i) && m_position.canPlay(i);
+
+			if (mouseOnColumn)
 			{
-				discFalling = false;
-				discFallingPos = getSpacePosition(i, BOARD_HEIGHT);
-				board[queuedI][queuedJ] = curPlayer == Player::Red ? Space::Red : Space::Yellow;
-				curPlayer = curPlayer == Player::Red ? Player::Yellow : Player::Red;
+				window.setCursor(m_handCursor);
 			}
+			else window.setCursor(m_arrowCursor);
+			if (m_input.isMouseButtonTapped(MouseButton::Left) && mouseOnColumn) dropDisc(i);
 		}
-		else if (discFalling && curPlayer == Player::Yellow)
+	}
+
+	m_hoveredColumn = i;
+}
+
+void ConnectFour::Game::tick(double fixedDt)
+{
+	if (!m_discFalling) return;
+
+	m_prevFallingY = m_discFallingPos.getY();
+	m_discFallingPos.setY(m_discFallingPos.getY() - DISC_FALL_SPEED);
+	if (m_discFallingPos.getY() < getSpacePosition(m_queuedI, m_queuedJ).getY())
+	{
+		m_discFalling = false;
+		Position::Cell player = getPlayerToMove(m_position);
+		m_position.play(m_queuedI);
+
+		if (m_queuedWin)
 		{
-			yellowDiscOuter.setPosition(Vec3(discFallingPos, 0));
-			yellowDiscInner.setPosition(Vec3(discFallingPos, 1));
-			yellowDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			yellowDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			discFallingPos.setY(discFallingPos.getY() - DISC_FALL_SPEED);
-			if (discFallingPos.getY() < getSpacePosition(queuedI, queuedJ).getY())
-			{
-				discFalling = false;
-				discFallingPos = getSpacePosition(i, BOARD_HEIGHT);
-				board[queuedI][queuedJ] = curPlayer == Player::Red ? Space::Red : Space::Yellow;
-				curPlayer = curPlayer == Player::Red ? Player::Yellow : Player::Red;
-			}
+			if (player == Position::Cell::Red) showResult("Red Wins!", Vec4::Red());
+			else showResult("Yellow Wins!", Vec4::Yellow());
 		}
-		window.endRender();
+		else if (m_position.isFull()) showResult("Draw!", Vec4::White());
 	}
+}
 
-	window.dispose();
-	renderer.dispose();
-	emptyDisc.dispose();
-	redDiscOuter.dispose();
-	redDiscInner.dispose();
-	yellowDiscOuter.dispose();
-	yellowDiscInner.dispose();
-	arrowCursor.dispose();
-	handCursor.dispose();
+void ConnectFour::Game::render(double alpha)
+{
+	m_emptyDiscs.clear();
+	m_discsOuter.clear();
+	m_discsInner.clear();
+	if (m_discFalling)
+	{
+		float y = m_prevFallingY + (m_discFallingPos.getY() - m_prevFallingY) * alpha;
+		addDisc(m_discsOuter, m_discsInner, Vec2(m_discFallingPos.getX(), y), getPlayerToMove(m_position));
+	}
+	addBoard(m_emptyDiscs, m_discsOuter, m_discsInner, m_position, m_hoveredColumn);
 
-	Onyx::Terminate();
+	m_renderQueue.render();
+}
+
+double ConnectFour::Game::getTickRate() const
+{
+	return TICK_RATE;
+}
+
+void ConnectFour::Game::unload()
+{
+	m_ai.cancel();
+	AssetLoader::Cancel(m_assets);
+	m_renderQueue.dispose();
+	if (m_fontHandle.isLoaded()) m_fontHandle.get().dispose();
+	m_arrowCursor.dispose();
+	m_handCursor.dispose();
+}
 
-	Launcher::GameHub::Launch();
+const Onyx::RenderQueue* ConnectFour::Game::getRenderQueue() const
+{
+	return &m_renderQueue;
+}
+
+bool ConnectFour::Game::isComputerTurn() const
+{
+	return m_vsComputer && getPlayerToMove(m_position) == Position::Cell::Yellow;
 }
 
-void render(Camera& cam, Renderable& emptyDisc, Renderable& redDiscOuter, Renderable& redDiscInner, Renderable& yellowDiscOuter, Renderable& yellowDiscInner, int hoveredColumn)
+void ConnectFour::Game::dropDisc(int column)
+{
+	m_queuedI = column;
+	m_queuedJ = 0;
+	while (m_position.getCell(column, m_queuedJ) != Position::Cell::Empty) m_queuedJ++;
+	m_queuedWin = m_position.isWinningMove(column);
+
+	m_discFalling = true;
+	m_discFallingPos = getSpacePosition(column, BOARD_HEIGHT);
+	m_prevFallingY = m_discFallingPos.getY();
+
+	// the computer thinks about its reply on its own thread while the player's disc falls
+	if (m_vsComputer && !isComputerTurn() && !m_queuedWin)
+	{
+		Position next = m_position;
+		next.play(column);
+		if (!next.isFull()) m_ai.think(next, COMPUTER_THINK_TIME);
+	}
+}
+
+void ConnectFour::Game::showResult(const std::string& text, const Vec4& color)
+{
+	m_resultText = AtlasText(text, m_font, color);
+	m_resultText.setPosition(Vec2(SCR_SIZE / 2 - m_resultText.getWidth() / 2, SCR_SIZE - 50.0f - m_resultText.getHeight()));
+	m_renderQueue.add(m_resultText);
+	m_over = true;
+	m_pManager->getWindow().setCursor(m_arrowCursor);
+}
+
+void addDisc(InstancedRenderable& discsOuter, InstancedRenderable& discsInner, Vec2 pos, Position::Cell player, float brightness)
+{
+	Vec4 color = player == Position::Cell::Red ? Vec4::Red() : Vec4::Yellow();
+	discsOuter.add(Vec3(pos, 0), color * brightness);
+	discsInner.add(Vec3(pos, 1), color * 0.7f * brightness);
+}
+
+void addBoard(InstancedRenderable& emptyDiscs, InstancedRenderable& discsOuter, InstancedRenderable& discsInner, const Position& position, int hoveredColumn)
 {
 	for (int i = 0; i < BOARD_WIDTH; i++)
 	{
 		for (int j = 0; j < BOARD_HEIGHT; j++)
 		{
-			emptyDisc.setPosition(Vec3(getSpacePosition(i, j), -1));
-			emptyDisc.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
+			emptyDiscs.add(Vec3(getSpacePosition(i, j), -1), Vec4::Black(0.4f));
 
-			if (board[i][j] == Space::Red)
-			{
-				redDiscOuter.setPosition(Vec3(getSpacePosition(i, j), 0));
-				redDiscInner.setPosition(Vec3(getSpacePosition(i, j), 1));
-				redDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-				redDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			}
-			else if (board[i][j] == Space::Yellow)
-			{
-				yellowDiscOuter.setPosition(Vec3(getSpacePosition(i, j), 0));
-				yellowDiscInner.setPosition(Vec3(getSpacePosition(i, j), 1));
-				yellowDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-				yellowDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-			}
-			else if (i == hoveredColumn)
-			{
-				if (curPlayer == Player::Red)
-				{
-					redDiscOuter.getShader()->use();
-					redDiscOuter.getShader()->setVec4("u_color", Vec4::Red() * 0.9f);
-					redDiscInner.getShader()->use();
-					redDiscInner.getShader()->setVec4("u_color", Vec4::Red() * 0.7f * 0.9f);
-					redDiscOuter.setPosition(Vec3(getSpacePosition(i, BOARD_HEIGHT), 0));
-					redDiscInner.setPosition(Vec3(getSpacePosition(i, BOARD_HEIGHT), 1));
-					redDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-					redDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-					redDiscOuter.getShader()->use();
-					redDiscOuter.getShader()->setVec4("u_color", Vec4::Red());
-					redDiscInner.getShader()->use();
-					redDiscInner.getShader()->setVec4("u_color", Vec4::Red() * 0.7f);
-				}
-				else
-				{
-					yellowDiscOuter.getShader()->use();
-					yellowDiscOuter.getShader()->setVec4("u_color", Vec4::Yellow() * 0.9f);
-					yellowDiscInner.getShader()->use();
-					yellowDiscInner.getShader()->setVec4("u_color", Vec4::Yellow() * 0.7f * 0.9f);
-					yellowDiscOuter.setPosition(Vec3(getSpacePosition(i, BOARD_HEIGHT), 0));
-					yellowDiscInner.setPosition(Vec3(getSpacePosition(i, BOARD_HEIGHT), 1));
-					yellowDiscOuter.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-					yellowDiscInner.render(cam.getViewMatrix(), cam.getProjectionMatrix(), cam.getPosition());
-					yellowDiscOuter.getShader()->use();
-					yellowDiscOuter.getShader()->setVec4("u_color", Vec4::Yellow());
-					yellowDiscInner.getShader()->use();
-					yellowDiscInner.getShader()->setVec4("u_color", Vec4::Yellow() * 0.7f);
-				}
-			}
+			Position::Cell cell = position.getCell(i, j);
+			if (cell != Position::Cell::Empty) addDisc(discsOuter, discsInner, getSpacePosition(i, j), cell);
 		}
 	}
+
+	if (hoveredColumn != -1 && position.canPlay(hoveredColumn)) addDisc(discsOuter, discsInner, getSpacePosition(hoveredColumn, BOARD_HEIGHT), getPlayerToMove(position), 0.9f);
 }
 
 bool isMouseOnSpace(Vec2 mousePos, int* i, int* j)
@@ -339,52 +306,3 @@ bool isMouseOnColumn(Vec2 mousePos, int* i)
 	*i = -1;
 	return false;
 }
-
-bool checkWinner(Player* player)
-{
-	for (int i = 0; i < BOARD_WIDTH; i++)
-	{
-		for (int j = 0; j < BOARD_HEIGHT; j++)
-		{
-			if (board[i][j] == Space::Empty) continue;
-
-			if (i + 3 < BOARD_WIDTH)
-			{
-				if (board[i][j] == board[i + 1][j] && board[i][j] == board[i + 2][j] && board[i][j] == board[i + 3][j])
-				{
-					*player = board[i][j] == Space::Red ? Player::Red : Player::Yellow;
-					return true;
-				}
-			}
-
-			if (j + 3 < BOARD_HEIGHT)
-			{
-				if (board[i][j] == board[i][j + 1] && board[i][j] == board[i][j + 2] && board[i][j] == board[i][j + 3])
-				{
-					*player = board[i][j] == Space::Red ? Player::Red : Player::Yellow;
-					return true;
-				}
-			}
-
-			if (i + 3 < BOARD_WIDTH && j + 3 < BOARD_HEIGHT)
-			{
-				if (board[i][j] == board[i + 1][j + 1] && board[i][j] == board[i + 2][j + 2] && board[i][j] == board[i + 3][j + 3])
-				{
-					*player = board[i][j] == Space::Red ? Player::Red : Player::Yellow;
-					return true;
-				}
-			}
-
-			if (i - 3 >= 0 && j + 3 < BOARD_HEIGHT)
-			{
-				if (board[i][j] == board[i - 1][j + 1] && board[i][j] == board[i - 2][j + 2] && board[i][j] == board[i - 3][j + 3])
-				{
-					*player = board[i][j] == Space::Red ? Player::Red : Player::Yellow;
-					return true;
-				}
-			}
-		}
-	}
-
-	return false;
-}
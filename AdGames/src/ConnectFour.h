@@ -1,6 +1,64 @@
 #pragma once
 
+#include <string>
+
+#include <Onyx/InputHandler.h>
+#include <Onyx/Camera.h>
+
+#include "engine/SceneManager.h"
+#include "engine/RenderQueue.h"
+#include "engine/InstancedRenderable.h"
+#include "engine/AssetLoader.h"
+
+#include "ConnectFourPosition.h"
+#include "ConnectFourAI.h"
+
 namespace ConnectFour
 {
-	void Run();
+	/*
+		Red against yellow, either two players taking turns or the player as red against the computer. Tab switches between the two and starts a new game.
+	 */
+	class Game : public Onyx::Scene
+	{
+	public:
+		Game(bool vsComputer = true);
+
+		void load(Onyx::SceneManager& manager) override;
+		bool finishLoad() override;
+		void update(double dt) override;
+		void tick(double fixedDt) override;
+		void render(double alpha) override;
+		void unload() override;
+		double getTickRate() const override;
+		const Onyx::RenderQueue* getRenderQueue() const override;
+
+	private:
+		Onyx::SceneManager* m_pManager;
+		Onyx::InputHandler m_input;
+		Onyx::Camera m_cam;
+		Onyx::RenderQueue m_renderQueue;
+
+		Onyx::InstancedRenderable m_emptyDiscs, m_discsOuter, m_discsInner;
+		Onyx::Cursor m_arrowCursor, m_handCursor;
+
+		// every asset the game loads belongs to the group, so leaving while they load cancels only them
+		Onyx::AssetGroup m_assets;
+		Onyx::AssetHandle<Onyx::AtlasFont> m_fontHandle;
+		Onyx::AtlasFont m_font;
+		Onyx::AtlasText m_resultText;
+
+		Position m_position;
+		bool m_vsComputer;
+		AIPlayer m_ai;
+
+		Onyx::Math::Vec2 m_discFallingPos;
+		float m_prevFallingY;
+		bool m_over, m_discFalling, m_queuedWin;
+		int m_queuedI, m_queuedJ;
+		int m_hoveredColumn;
+
+		bool isComputerTurn() const;
+		void dropDisc(int column);
+		void showResult(const std::string& text, const Onyx::Math::Vec4& color);
+	};
 }
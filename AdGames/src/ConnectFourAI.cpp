@@ -0,0 +1,464 @@
+#include "ConnectFourAI.h"
+
+#include <algorithm>
+#include <iostream>
+
+// the clock is only read this often, reading it every node would cost more than the nodes
+const ulonglong NODES_PER_CHECK = 1024;
+
+// deeper iterations that only guess from the heuristic cost more than solving the position outright
+const int HEURISTIC_DEPTH_MAX = 12;
+
+// 2^24 entries of 16 bytes, so a solve from early in the game doesn't keep overwriting what it needs
+const uint BENCHMARK_TABLE_SIZE_LOG2 = 24;
+
+const int CELL_COUNT = ConnectFour::BOARD_WIDTH * ConnectFour::BOARD_HEIGHT;
+const int SCORE_INFINITY = ConnectFour::SCORE_WIN + 1;
+// the lowest score of a won game, no score is between this and a draw
+const int SCORE_WIN_MIN = ConnectFour::SCORE_WIN - CELL_COUNT;
+
+// ties between moves that make as many threats go to the one closer to the center
+const int COLUMN_ORDER[ConnectFour::BOARD_WIDTH] = { 3, 2, 4, 1, 5, 0, 6 };
+
+// helper thread i skips depth d when ((d + SKIP_PHASE[i]) / SKIP_SIZE[i]) is odd, so at any time the helpers are spread over the next few depths
+const int SKIP_PATTERN_SIZE = 20;
+const int SKIP_SIZE[SKIP_PATTERN_SIZE] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+const int SKIP_PHASE[SKIP_PATTERN_SIZE] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+// an entry is packed as 16 bits of score, 8 of depth, 2 of bound and 4 of move plus one
+static ulonglong PackEntry(int score, int depth, ConnectFour::TranspositionTable::Bound bound, int move)
+{
+	return (ulonglong)(score + 32768) | (ulonglong)depth << 16 | (ulonglong)bound << 24 | (ulonglong)(move + 1) << 26;
+}
+
+static ConnectFour::TranspositionTable::Entry UnpackEntry(ulonglong data)
+{
+	return ConnectFour::TranspositionTable::Entry{
+		(int)(data & 0xFFFF) - 32768,
+		(int)(data >> 16 & 0xFF),
+		(ConnectFour::TranspositionTable::Bound)(data >> 24 & 0x3),
+		(int)(data >> 26 & 0xF) - 1
+	};
+}
+
+// one core is left for the main thread
+static uint AIThreadCount()
+{
+	uint nThreads = std::thread::hardware_concurrency();
+	return nThreads > 1 ? nThreads - 1 : 1;
+}
+
+ConnectFour::TranspositionTable::TranspositionTable(uint log2Size)
+{
+	m_slots = std::make_unique<Slot[]>(1ull << log2Size);
+	m_mask = (1ull << log2Size) - 1;
+	clear();
+}
+
+bool ConnectFour::TranspositionTable::probe(ulonglong key, Entry* entry) const
+{
+	const Slot& slot = m_slots[key & m_mask];
+	ulonglong data = slot.data.load(std::memory_order_relaxed);
+	ulonglong check = slot.check.load(std::memory_order_relaxed);
+
+	// another thread writing the slot between the two loads leaves them mismatched, which reads as a miss
+	if ((check ^ data) != key) return false;
+
+	*entry = UnpackEntry(data);
+	return true;
+}
+
+void ConnectFour::TranspositionTable::store(ulonglong key, int score, int depth, Bound bound, int move)
+{
+	Slot& slot = m_slots[key & m_mask];
+	ulonglong data = PackEntry(score, depth, bound, move);
+	slot.check.store(key ^ data, std::memory_order_relaxed);
+	slot.data.store(data, std::memory_order_relaxed);
+}
+
+void ConnectFour::TranspositionTable::clear()
+{
+	// an empty slot reads as an entry of depth 0 for the empty board's key of 0, which never cuts a search short
+	for (ulonglong i = 0; i <= m_mask; i++)
+	{
+		m_slots[i].check.store(0, std::memory_order_relaxed);
+		m_slots[i].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+ConnectFour::Solver::Solver(uint nThreads, uint log2TableSize)
+	: m_table(log2TableSize)
+{
+	m_nThreads = std::max(nThreads, 1u);
+	m_timed = m_heuristic = false;
+	m_stop = nullptr;
+	m_done = false;
+}
+
+ConnectFour::SearchResult ConnectFour::Solver::search(const Position& position, double seconds, const std::atomic<bool>* stop)
+{
+	return run(position, seconds, true, stop);
+}
+
+ConnectFour::SearchResult ConnectFour::Solver::solve(const Position& position, double seconds, const std::atomic<bool>* stop)
+{
+	return run(position, seconds, false, stop);
+}
+
+void ConnectFour::Solver::clear()
+{
+	m_table.clear();
+}
+
+uint ConnectFour::Solver::getThreadCount() const
+{
+	return m_nThreads;
+}
+
+ConnectFour::SearchResult ConnectFour::Solver::run(const Position& position, double seconds, bool heuristic, const std::atomic<bool>* stop)
+{
+	auto start = std::chrono::steady_clock::now();
+	m_timed = seconds > 0.0;
+	m_deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+	m_heuristic = heuristic;
+	m_stop = stop;
+	m_done = false;
+
+	SearchResult result;
+	int moveCount = position.getMoveCount();
+
+	// the rest of the search assumes the player to move can't win straight away
+	for (int column : COLUMN_ORDER)
+	{
+		if (position.canPlay(column) && position.isWinningMove(column))
+		{
+			result.move = column;
+			result.score = SCORE_WIN - (moveCount + 1);
+			result.exact = true;
+			return result;
+		}
+	}
+
+	// every move loses, so any move will do
+	if (position.getNonLosingMoves() == 0)
+	{
+		for (int column : COLUMN_ORDER)
+		{
+			if (!position.canPlay(column)) continue;
+
+			result.move = column;
+			result.score = -(SCORE_WIN - (moveCount + 2));
+			result.exact = true;
+			return result;
+		}
+	}
+
+	std::vector<Worker> workers(m_nThreads);
+	for (uint i = 0; i < m_nThreads; i++)
+	{
+		workers[i].index = i;
+		workers[i].nodes = 0;
+		workers[i].aborted = false;
+	}
+
+	std::vector<std::thread> helpers;
+	for (uint i = 1; i < m_nThreads; i++) helpers.emplace_back([this, &workers, &position, i]() { iterate(workers[i], position); });
+	iterate(workers[0], position);
+	m_done = true;
+	for (std::thread& helper : helpers) helper.join();
+
+	// a proven result from any thread, otherwise the deepest iteration that finished
+	for (const Worker& worker : workers)
+	{
+		if (worker.result.move == -1) continue;
+		if (result.move == -1 || (worker.result.exact && !result.exact) || (worker.result.exact == result.exact && worker.result.depth > result.depth)) result = worker.result;
+	}
+
+	result.nodes = 0;
+	for (const Worker& worker : workers) result.nodes += worker.nodes;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+void ConnectFour::Solver::iterate(Worker& worker, const Position& position)
+{
+	int emptyCells = CELL_COUNT - position.getMoveCount();
+	for (int depth = m_heuristic ? 1 : emptyCells; depth <= emptyCells; depth++)
+	{
+		if (depth > HEURISTIC_DEPTH_MAX) depth = emptyCells;
+		if (worker.index > 0 && depth < emptyCells)
+		{
+			int pattern = (worker.index - 1) % SKIP_PATTERN_SIZE;
+			if ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern] % 2) continue;
+		}
+
+		int move = -1;
+		int score = depth == emptyCells ? solveExact(worker, position, &move) : negamax(worker, position, depth, -SCORE_INFINITY, SCORE_INFINITY, &move);
+		if (worker.aborted) return;
+
+		worker.result.move = move;
+		worker.result.score = score;
+		worker.result.depth = depth;
+		worker.result.exact = depth == emptyCells || score >= SCORE_HEURISTIC_MAX || score <= -SCORE_HEURISTIC_MAX;
+		if (worker.result.exact)
+		{
+			m_done = true;
+			return;
+		}
+	}
+}
+
+int ConnectFour::Solver::solveExact(Worker& worker, const Position& position, int* bestMove)
+{
+	int depth = CELL_COUNT - position.getMoveCount();
+	int lo = -(SCORE_WIN - (position.getMoveCount() + 4));
+	int hi = SCORE_WIN - (position.getMoveCount() + 3);
+	int move = -1;
+
+	// first whether it's a win, then whether it's a draw, then how quick the win or loss is
+	while (lo < hi)
+	{
+		int med = lo + (hi - lo) / 2;
+		if (lo < 0 && hi > 0) med = 0;
+		else if (lo < 0 && hi == 0) med = -1;
+
+		int searchMove = -1;
+		int score = negamax(worker, position, depth, med, med + 1, &searchMove);
+		if (worker.aborted) return 0;
+
+		if (score > med)
+		{
+			lo = score > 0 ? std::max(score, SCORE_WIN_MIN) : score;
+			move = searchMove;
+		}
+		else hi = score < 0 ? std::min(score, -SCORE_WIN_MIN) : score;
+	}
+
+	// nothing ever did better than the quickest possible loss, so every move loses as quickly
+	if (move == -1)
+	{
+		ulonglong moves = position.getNonLosingMoves();
+		for (int column : COLUMN_ORDER)
+		{
+			if (moves & Position::ColumnMask(column))
+			{
+				move = column;
+				break;
+			}
+		}
+	}
+
+	*bestMove = move;
+	return lo;
+}
+
+int ConnectFour::Solver::negamax(Worker& worker, const Position& position, int depth, int alpha, int beta, int* bestMove)
+{
+	if (++worker.nodes % NODES_PER_CHECK == 0) checkAbort(worker);
+	if (worker.aborted) return 0;
+
+	ulonglong moves = position.getNonLosingMoves();
+	int moveCount = position.getMoveCount();
+	if (moves == 0) return -(SCORE_WIN - (moveCount + 2));
+
+	// with two cells left, neither of them wins, or the checks above would have caught it
+	if (moveCount >= CELL_COUNT - 2) return 0;
+
+	// the opponent can't win with their next stone, and this player can't with this one, which bounds the score
+	int minScore = -(SCORE_WIN - (moveCount + 4));
+	if (alpha < minScore)
+	{
+		alpha = minScore;
+		if (alpha >= beta) return alpha;
+	}
+	int maxScore = SCORE_WIN - (moveCount + 3);
+	if (beta > maxScore)
+	{
+		beta = maxScore;
+		if (alpha >= beta) return beta;
+	}
+
+	if (depth <= 0) return Evaluate(position);
+
+	// searching deeper than the board has room for gives the same result, so those entries are stored as that deep
+	depth = std::min(depth, CELL_COUNT - moveCount);
+
+	int tableMove = -1;
+	TranspositionTable::Entry entry;
+	if (m_table.probe(position.getKey(), &entry))
+	{
+		tableMove = entry.move;
+		if (entry.depth >= depth && !bestMove)
+		{
+			if (entry.bound == TranspositionTable::Bound::Exact) return entry.score;
+			if (entry.bound == TranspositionTable::Bound::Lower && entry.score >= beta) return entry.score;
+			if (entry.bound == TranspositionTable::Bound::Upper && entry.score <= alpha) return entry.score;
+		}
+	}
+
+	// the table's move first, then the moves that make the most threats
+	int columns[BOARD_WIDTH], keys[BOARD_WIDTH];
+	ulonglong cells[BOARD_WIDTH];
+	int nMoves = 0;
+	for (int column : COLUMN_ORDER)
+	{
+		ulonglong move = moves & Position::ColumnMask(column);
+		if (!move) continue;
+
+		int key = column == tableMove ? SCORE_INFINITY : position.getMoveScore(move);
+		int i = nMoves++;
+		for (; i > 0 && keys[i - 1] < key; i--)
+		{
+			columns[i] = columns[i - 1];
+			keys[i] = keys[i - 1];
+			cells[i] = cells[i - 1];
+		}
+		columns[i] = column;
+		keys[i] = key;
+		cells[i] = move;
+	}
+
+	// each helper starts from a different root move, so the threads don't all search the same subtree first
+	int first = bestMove ? worker.index % nMoves : 0;
+
+	int alphaOrig = alpha;
+	int best = -SCORE_INFINITY, bestColumn = columns[first];
+	for (int n = 0; n < nMoves; n++)
+	{
+		int i = (first + n) % nMoves;
+		Position child = position;
+		child.playMove(cells[i]);
+		int score = -negamax(worker, child, depth - 1, -beta, -alpha);
+		if (worker.aborted) return 0;
+
+		if (score > best)
+		{
+			best = score;
+			bestColumn = columns[i];
+			if (score > alpha) alpha = score;
+			if (alpha >= beta) break;
+		}
+	}
+
+	TranspositionTable::Bound bound = TranspositionTable::Bound::Exact;
+	if (best <= alphaOrig) bound = TranspositionTable::Bound::Upper;
+	else if (best >= beta) bound = TranspositionTable::Bound::Lower;
+	m_table.store(position.getKey(), best, depth, bound, bestColumn);
+
+	if (bestMove) *bestMove = bestColumn;
+	return best;
+}
+
+void ConnectFour::Solver::checkAbort(Worker& worker)
+{
+	if (m_done.load(std::memory_order_relaxed) || (m_stop && m_stop->load(std::memory_order_relaxed))) worker.aborted = true;
+	// the first thread always finishes its first iteration of a search, so there is a move to play
+	else if (m_timed && (worker.index > 0 || !m_heuristic || worker.result.depth > 0) && std::chrono::steady_clock::now() >= m_deadline) worker.aborted = true;
+}
+
+int ConnectFour::Solver::Evaluate(const Position& position)
+{
+	int score = position.getThreatBalance() * 8 + position.getColumnBalance(BOARD_WIDTH / 2) * 2;
+	return std::clamp(score, -(SCORE_HEURISTIC_MAX - 1), SCORE_HEURISTIC_MAX - 1);
+}
+
+ConnectFour::AIPlayer::AIPlayer()
+{
+	m_stop = m_done = false;
+	m_thinking = false;
+}
+
+ConnectFour::AIPlayer::~AIPlayer()
+{
+	cancel();
+}
+
+void ConnectFour::AIPlayer::think(const Position& position, double seconds)
+{
+	cancel();
+
+	m_stop = m_done = false;
+	m_thinking = true;
+	m_thread = std::thread([this, position, seconds]()
+		{
+			// the table is only allocated once there's something to search, and on this thread so the frame it starts on doesn't wait for it
+			if (!m_pSolver) m_pSolver = std::make_unique<Solver>(AIThreadCount());
+			m_result = m_pSolver->search(position, seconds, &m_stop);
+			m_done.store(true, std::memory_order_release);
+		});
+}
+
+bool ConnectFour::AIPlayer::isThinking() const
+{
+	return m_thinking;
+}
+
+bool ConnectFour::AIPlayer::hasMove() const
+{
+	return m_thinking && m_done.load(std::memory_order_acquire);
+}
+
+ConnectFour::SearchResult ConnectFour::AIPlayer::takeMove()
+{
+	m_thread.join();
+	m_thinking = false;
+	return m_result;
+}
+
+void ConnectFour::AIPlayer::cancel()
+{
+	if (m_thread.joinable())
+	{
+		m_stop = true;
+		m_thread.join();
+	}
+	m_thinking = false;
+}
+
+int ConnectFour::RunBenchmark(const std::string& moves, uint maxThreads, double seconds)
+{
+	Position position;
+	for (char c : moves)
+	{
+		int column = c - '1';
+		if (column < 0 || column >= BOARD_WIDTH || !position.canPlay(column) || position.isWinningMove(column))
+		{
+			std::cerr << "Invalid position " << moves << std::endl;
+			return 1;
+		}
+		position.play(column);
+	}
+	if (position.isFull())
+	{
+		std::cerr << "The position is already over" << std::endl;
+		return 1;
+	}
+
+	std::cout << "connect four benchmark: solving \"" << moves << "\", " << position.getMoveCount() << " stones in, " << seconds << " s limit" << std::endl;
+
+	std::vector<uint> threadCounts;
+	for (uint nThreads = 1; nThreads < maxThreads; nThreads *= 2) threadCounts.push_back(nThreads);
+	threadCounts.push_back(std::max(maxThreads, 1u));
+
+	double baseSeconds = 0.0;
+	for (uint nThreads : threadCounts)
+	{
+		// a new solver each time, so no run starts from what the last one left in the table
+		Solver solver(nThreads, BENCHMARK_TABLE_SIZE_LOG2);
+		SearchResult result = solver.solve(position, seconds);
+		if (nThreads == 1 && result.move != -1) baseSeconds = result.seconds;
+
+		std::cout << "  " << nThreads << " threads: ";
+		if (result.move == -1) std::cout << "gave up after " << result.seconds << " s";
+		else
+		{
+			std::cout << "score " << result.score << ", move " << result.move + 1 << " in " << result.seconds << " s";
+			if (nThreads > 1 && baseSeconds > 0.0) std::cout << " (" << baseSeconds / result.seconds << "x as fast)";
+		}
+		// a position decided by its next move is answered without searching
+		if (result.nodes > 0) std::cout << ", " << result.nodes << " nodes, " << result.nodes / result.seconds / 1e6 << " M nodes/s";
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
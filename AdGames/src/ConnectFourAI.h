@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Onyx/Core.h>
+
+#include "ConnectFourPosition.h"
+
+namespace ConnectFour
+{
+	/*
+		@brief A won game scores SCORE_WIN minus the number of stones on the board when it was won, so quicker wins score higher.
+		Scores from the heuristic are always strictly between -SCORE_HEURISTIC_MAX and SCORE_HEURISTIC_MAX, so any score outside of them is a proven result.
+	 */
+	const int SCORE_WIN = 1000;
+	const int SCORE_HEURISTIC_MAX = 100;
+
+	/*
+		@brief What a search found.
+	 */
+	struct SearchResult
+	{
+		// the column to play, -1 if there is none
+		int move = -1;
+		// the score of the position for the player to move
+		int score = 0;
+		// the depth of the last iteration that finished
+		int depth = 0;
+		// whether the score is the game's actual result with perfect play, rather than a guess from the heuristic
+		bool exact = false;
+		// the number of positions searched, by every thread
+		ulonglong nodes = 0;
+		// how long the search took
+		double seconds = 0.0;
+	};
+
+	/*
+		@brief A fixed size table of searched positions, indexed by their Zobrist key, that any number of threads can read and write at once without locks.
+		Each slot is two 64-bit words, the entry packed into one and the key XORed with it in the other. A read whose words came from two different writes
+		fails the XOR check and is a miss, so a torn entry is never used. A new entry always replaces the one in its slot.
+		Scores only depend on the position and not on the path that led to it, so an entry can be reused from any search, including earlier ones.
+	 */
+	class TranspositionTable
+	{
+	public:
+		/*
+			@brief How an entry's score relates to the position's actual score.
+			Lower means the actual score is at least the entry's, Upper that it's at most the entry's.
+		 */
+		enum class Bound : ubyte
+		{
+			Exact,
+			Lower,
+			Upper
+		};
+
+		/*
+			@brief A searched position.
+		 */
+		struct Entry
+		{
+			int score;
+			int depth;
+			Bound bound;
+			int move;
+		};
+
+		/*
+			@brief Creates an empty table.
+			@param log2Size The base 2 logarithm of the number of entries.
+		 */
+		TranspositionTable(uint log2Size);
+
+		/*
+			@brief Looks up a position.
+			@param key The Zobrist key of the position.
+			@param entry A pointer to an entry that is set to the position's, if it was found.
+			@return True if the position was found, false if not.
+		 */
+		bool probe(ulonglong key, Entry* entry) const;
+
+		/*
+			@brief Stores a position, replacing whatever was in its slot.
+			@param key The Zobrist key of the position.
+			@param score The score found for it.
+			@param depth The depth it was searched to.
+			@param bound How the score relates to the actual score.
+			@param move The best move found, or -1.
+		 */
+		void store(ulonglong key, int score, int depth, Bound bound, int move);
+
+		/*
+			@brief Empties the table. Not safe while a search is using it.
+		 */
+		void clear();
+
+	private:
+		struct Slot
+		{
+			std::atomic<ulonglong> check;
+			std::atomic<ulonglong> data;
+		};
+
+		std::unique_ptr<Slot[]> m_slots;
+		ulonglong m_mask;
+	};
+
+	/*
+		@brief Finds the best move of a position with a negamax alpha-beta search, on one or more threads.
+		Iterative deepening runs deeper and deeper searches that score their leaves with a heuristic, then solves the position outright, until the time is up or the result is proven.
+		Each iteration tries the previous one's best moves first through the transposition table.
+		Only moves that don't let the opponent win straight away are searched, and the rest are ordered by the number of threats they make, then from the center out.
+		Depths are counted in stones, and the solve searches to the end of the game, narrowing the score down with null window searches.
+		With more than one thread the search is a lazy SMP: every thread runs its own iterative deepening and they only share the transposition table.
+		The helper threads skip some depths in a staggered pattern so they run ahead of each other, and start from a different move at the root,
+		which fills the table with results the other threads then don't have to search.
+		The table is kept between searches, so each move of a game starts from what was found thinking about the last one.
+	 */
+	class Solver
+	{
+	public:
+		/*
+			@brief Creates a solver with an empty transposition table.
+			@param nThreads The number of threads to search with, at least 1. The calling thread is one of them.
+			@param log2TableSize The base 2 logarithm of the number of transposition table entries, of 16 bytes each.
+		 */
+		Solver(uint nThreads = 1, uint log2TableSize = 20);
+
+		/*
+			@brief Searches a position that isn't over yet.
+			@param position The position.
+			@param seconds The time budget. The first iteration always finishes, so there is always a move.
+			@param stop Set from another thread to stop the search, even during the first iteration. It then returns the last iteration that finished, if any.
+			@return What the search found.
+		 */
+		SearchResult search(const Position& position, double seconds, const std::atomic<bool>* stop = nullptr);
+
+		/*
+			@brief Solves a position that isn't over yet, skipping the iterations that only guess from the heuristic.
+			@param position The position.
+			@param seconds The time limit, after which it gives up, 0 for no limit.
+			@param stop Set from another thread to give up.
+			@return The solution, with no move if it gave up.
+		 */
+		SearchResult solve(const Position& position, double seconds = 0.0, const std::atomic<bool>* stop = nullptr);
+
+		/*
+			@brief Forgets everything searched so far.
+		 */
+		void clear();
+
+		/*
+			@brief Gets the number of threads the solver searches with.
+			@return The number of threads.
+		 */
+		uint getThreadCount() const;
+
+	private:
+		// each thread's own state, aligned so the node counters of different threads are never on the same cache line
+		struct alignas(64) Worker
+		{
+			uint index;
+			ulonglong nodes;
+			bool aborted;
+			SearchResult result;
+		};
+
+		TranspositionTable m_table;
+		uint m_nThreads;
+		bool m_timed, m_heuristic;
+		std::chrono::steady_clock::time_point m_deadline;
+		const std::atomic<bool>* m_stop;
+		// set once a thread has proven the result, or the first thread has run out of time, to stop the others
+		std::atomic<bool> m_done;
+
+		SearchResult run(const Position& position, double seconds, bool heuristic, const std::atomic<bool>* stop);
+		void iterate(Worker& worker, const Position& position);
+		int solveExact(Worker& worker, const Position& position, int* bestMove);
+		int negamax(Worker& worker, const Position& position, int depth, int alpha, int beta, int* bestMove = nullptr);
+		void checkAbort(Worker& worker);
+		static int Evaluate(const Position& position);
+	};
+
+	/*
+		@brief A computer opponent that searches on worker threads, every core but one, so the game keeps running at full frame rate while it thinks.
+		The solver and its transposition table are created on the first think(), so a player that never thinks costs nothing.
+	 */
+	class AIPlayer
+	{
+	public:
+		/*
+			@brief Default constructor, creates a player that isn't thinking.
+		 */
+		AIPlayer();
+
+		/*
+			@brief Destructor, stops the search if there is one.
+		 */
+		~AIPlayer();
+
+		AIPlayer(const AIPlayer&) = delete;
+		AIPlayer& operator=(const AIPlayer&) = delete;
+
+		/*
+			@brief Starts searching for a move, cancelling the search already running if there is one. The position is copied, so it can change while the search runs.
+			@param position The position to move in, which isn't over yet.
+			@param seconds The time to think for.
+		 */
+		void think(const Position& position, double seconds);
+
+		/*
+			@brief Gets whether a search was started and its move hasn't been taken yet.
+			@return True if the player is thinking, false if not.
+		 */
+		bool isThinking() const;
+
+		/*
+			@brief Gets whether the search has finished and its move can be taken.
+			@return True if there is a move, false if not.
+		 */
+		bool hasMove() const;
+
+		/*
+			@brief Takes the result of the search, once hasMove() returns true.
+			@return What the search found.
+		 */
+		SearchResult takeMove();
+
+		/*
+			@brief Stops the search, if there is one, and throws its result away.
+		 */
+		void cancel();
+
+	private:
+		std::unique_ptr<Solver> m_pSolver;
+		std::thread m_thread;
+		std::atomic<bool> m_stop, m_done;
+		SearchResult m_result;
+		bool m_thinking;
+	};
+
+	/*
+		@brief Solves a position from scratch with 1, 2, 4... up to the specified number of threads, and prints how long it took and how many nodes per second were searched.
+		@param moves The position as the columns played from the empty board, from 1 to 7, like "4453".
+		@param maxThreads The largest number of threads to try.
+		@param seconds The time limit of each solve, after which the nodes per second are still printed.
+		@return The exit code.
+	 */
+	int RunBenchmark(const std::string& moves, uint maxThreads, double seconds);
+}
@@ -0,0 +1,158 @@
+#include "ConnectFourPosition.h"
+
+#include <bit>
+
+#include "engine/Random.h"
+
+const int COLUMN_BITS = ConnectFour::BOARD_HEIGHT + 1;
+
+static constexpr ulonglong BottomMask()
+{
+	ulonglong mask = 0;
+	for (int column = 0; column < ConnectFour::BOARD_WIDTH; column++) mask |= 1ull << (column * COLUMN_BITS);
+	return mask;
+}
+
+const ulonglong BOTTOM_MASK = BottomMask();
+const ulonglong BOARD_MASK = BOTTOM_MASK * ((1ull << ConnectFour::BOARD_HEIGHT) - 1);
+
+// one random key per player per bit, from a fixed seed so keys are the same every run
+struct ZobristKeys
+{
+	ulonglong keys[2][64];
+
+	ZobristKeys()
+	{
+		Onyx::Random random(0xC4);
+		for (int player = 0; player < 2; player++)
+		{
+			for (int bit = 0; bit < 64; bit++) keys[player][bit] = random.next();
+		}
+	}
+};
+
+static const ZobristKeys ZOBRIST;
+
+ConnectFour::Position::Position()
+{
+	m_current = m_mask = 0;
+	m_moves = 0;
+	m_key = 0;
+}
+
+bool ConnectFour::Position::canPlay(int column) const
+{
+	return (m_mask & (1ull << (BOARD_HEIGHT - 1 + column * COLUMN_BITS))) == 0;
+}
+
+void ConnectFour::Position::play(int column)
+{
+	playMove((m_mask + (1ull << (column * COLUMN_BITS))) & ColumnMask(column));
+}
+
+void ConnectFour::Position::playMove(ulonglong move)
+{
+	m_key ^= ZOBRIST.keys[m_moves & 1][std::countr_zero(move)];
+
+	// the opponent's stones become the stones of the player to move
+	m_current ^= m_mask;
+	m_mask |= move;
+	m_moves++;
+}
+
+bool ConnectFour::Position::isWinningMove(int column) const
+{
+	return (WinningCells(m_current, m_mask) & getPossible() & ColumnMask(column)) != 0;
+}
+
+bool ConnectFour::Position::canWinNext() const
+{
+	return (WinningCells(m_current, m_mask) & getPossible()) != 0;
+}
+
+ulonglong ConnectFour::Position::getNonLosingMoves() const
+{
+	ulonglong possible = getPossible();
+	ulonglong opponentWins = WinningCells(m_current ^ m_mask, m_mask);
+
+	// a move the opponent would win with has to be blocked, and if there are two the game is lost
+	ulonglong forced = possible & opponentWins;
+	if (forced)
+	{
+		if (forced & (forced - 1)) return 0;
+		possible = forced;
+	}
+
+	// nor may a stone go right under a cell the opponent would win with
+	return possible & ~(opponentWins >> 1);
+}
+
+int ConnectFour::Position::getMoveScore(ulonglong move) const
+{
+	return std::popcount(WinningCells(m_current | move, m_mask | move));
+}
+
+int ConnectFour::Position::getThreatBalance() const
+{
+	return std::popcount(WinningCells(m_current, m_mask)) - std::popcount(WinningCells(m_current ^ m_mask, m_mask));
+}
+
+int ConnectFour::Position::getColumnBalance(int column) const
+{
+	return std::popcount(m_current & ColumnMask(column)) - std::popcount((m_current ^ m_mask) & ColumnMask(column));
+}
+
+ConnectFour::Position::Cell ConnectFour::Position::getCell(int column, int row) const
+{
+	ulonglong bit = 1ull << (column * COLUMN_BITS + row);
+	if (!(m_mask & bit)) return Cell::Empty;
+
+	// m_current holds red's stones when an even number of moves have been played
+	bool red = ((m_current & bit) != 0) == (m_moves % 2 == 0);
+	return red ? Cell::Red : Cell::Yellow;
+}
+
+bool ConnectFour::Position::isFull() const
+{
+	return m_moves == BOARD_WIDTH * BOARD_HEIGHT;
+}
+
+int ConnectFour::Position::getMoveCount() const
+{
+	return m_moves;
+}
+
+ulonglong ConnectFour::Position::getKey() const
+{
+	return m_key;
+}
+
+ulonglong ConnectFour::Position::ColumnMask(int column)
+{
+	return ((1ull << BOARD_HEIGHT) - 1) << (column * COLUMN_BITS);
+}
+
+ulonglong ConnectFour::Position::getPossible() const
+{
+	// adding a column's bottom bit carries up to its lowest empty cell
+	return (m_mask + BOTTOM_MASK) & BOARD_MASK;
+}
+
+ulonglong ConnectFour::Position::WinningCells(ulonglong stones, ulonglong mask)
+{
+	// vertical, only upwards since nothing can be above an empty cell
+	ulonglong cells = (stones << 1) & (stones << 2) & (stones << 3);
+
+	// horizontal, then both diagonals: each looks for three of four cells filled either side of the empty one
+	for (int shift : { COLUMN_BITS, COLUMN_BITS - 1, COLUMN_BITS + 1 })
+	{
+		ulonglong pair = (stones << shift) & (stones << 2 * shift);
+		cells |= pair & (stones << 3 * shift);
+		cells |= pair & (stones >> shift);
+		pair = (stones >> shift) & (stones >> 2 * shift);
+		cells |= pair & (stones << shift);
+		cells |= pair & (stones >> 3 * shift);
+	}
+
+	return cells & (BOARD_MASK ^ mask);
+}
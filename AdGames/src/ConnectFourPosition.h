@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Onyx/Core.h>
+
+namespace ConnectFour
+{
+	const int BOARD_WIDTH = 7, BOARD_HEIGHT = 6;
+
+	/*
+		@brief A Connect Four position stored as two 64-bit bitboards: the stones of the player to move, and every stone on the board.
+		Each column takes BOARD_HEIGHT + 1 bits, bottom to top, the extra bit on top stays empty so shifts never carry from one column into the next.
+		Playing a move, checking for a win and finding the moves that don't lose on the spot are a few shifts and masks, with no loops over the board.
+		The position also keeps a Zobrist key, updated as moves are played, to look it up in a transposition table.
+		Red always moves first.
+	 */
+	class Position
+	{
+	public:
+		/*
+			@brief The contents of a cell.
+		 */
+		enum class Cell
+		{
+			Empty,
+			Red,
+			Yellow
+		};
+
+		/*
+			@brief Default constructor, creates the empty board.
+		 */
+		Position();
+
+		/*
+			@brief Gets whether a column has room for another stone.
+			@param column The column, from 0 to BOARD_WIDTH - 1.
+			@return True if the column isn't full, false if it is.
+		 */
+		bool canPlay(int column) const;
+
+		/*
+			@brief Drops a stone of the player to move in a column. The other player is then to move.
+			@param column The column, which must not be full.
+		 */
+		void play(int column);
+
+		/*
+			@brief Plays a move of the player to move.
+			@param move A bitboard with the single bit of the cell the stone lands in.
+		 */
+		void playMove(ulonglong move);
+
+		/*
+			@brief Gets whether dropping a stone in a column makes four in a row for the player to move.
+			@param column The column, which must not be full.
+			@return True if the move wins, false if not.
+		 */
+		bool isWinningMove(int column) const;
+
+		/*
+			@brief Gets whether the player to move has a winning move.
+			@return True if any move wins, false if not.
+		 */
+		bool canWinNext() const;
+
+		/*
+			@brief Gets the moves of the player to move that don't let the opponent win on their next move.
+			@return A bitboard of the cells the stones would land in, empty if every move loses.
+		 */
+		ulonglong getNonLosingMoves() const;
+
+		/*
+			@brief Gets the number of cells where the player to move would have four in a row after playing a move, to try the most threatening moves first.
+			@param move A bitboard with the single bit of the cell the stone lands in.
+			@return The number of cells.
+		 */
+		int getMoveScore(ulonglong move) const;
+
+		/*
+			@brief Gets the number of open cells that would complete four in a row for the player to move, minus the same for the opponent.
+			@return The difference.
+		 */
+		int getThreatBalance() const;
+
+		/*
+			@brief Gets the number of stones the player to move has in a column, minus the opponent's.
+			@param column The column, from 0 to BOARD_WIDTH - 1.
+			@return The difference.
+		 */
+		int getColumnBalance(int column) const;
+
+		/*
+			@brief Gets the contents of a cell.
+			@param column The column, from 0 to BOARD_WIDTH - 1.
+			@param row The row, from 0 at the bottom to BOARD_HEIGHT - 1.
+			@return The contents of the cell.
+		 */
+		Cell getCell(int column, int row) const;
+
+		/*
+			@brief Gets whether every cell has a stone in it.
+			@return True if the board is full, false if not.
+		 */
+		bool isFull() const;
+
+		/*
+			@brief Gets the number of stones played.
+			@return The number of stones.
+		 */
+		int getMoveCount() const;
+
+		/*
+			@brief Gets the Zobrist key of the position. Two positions with the same stones have the same key, however they were played.
+			@return The key.
+		 */
+		ulonglong getKey() const;
+
+		/*
+			@brief Gets the bitboard of a column's cells.
+			@param column The column, from 0 to BOARD_WIDTH - 1.
+			@return The bitboard.
+		 */
+		static ulonglong ColumnMask(int column);
+
+	private:
+		ulonglong m_current;
+		ulonglong m_mask;
+		int m_moves;
+		ulonglong m_key;
+
+		ulonglong getPossible() const;
+		static ulonglong WinningCells(ulonglong stones, ulonglong mask);
+	};
+}
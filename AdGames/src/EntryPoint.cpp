@@ -1,9 +1,45 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
 #include <Onyx/Core.h>
 
 #include "Application.h"
+#include "CannonSim.h"
+#include "ConnectFourAI.h"
+#include "engine/MeshFile.h"
 
-int main()
+int main(int argc, char** argv)
 {
+	// offline mesh cooking: AdGames --cook <in.obj> <out.omesh>
+	if (argc == 4 && strcmp(argv[1], "--cook") == 0)
+	{
+		if (Onyx::MeshFile::Cook(argv[2], argv[3])) return 0;
+
+		std::cerr << "Failed to cook " << argv[2] << std::endl;
+		return 1;
+	}
+
+	// headless Cannon benchmark, no window or GL context: AdGames --bench-cannon <balls> [seconds] [seed]
+	if (argc >= 3 && strcmp(argv[1], "--bench-cannon") == 0)
+	{
+		uint nBalls = (uint)strtoul(argv[2], nullptr, 10);
+		double seconds = argc >= 4 ? atof(argv[3]) : 10.0;
+		ulonglong seed = argc >= 5 ? strtoull(argv[4], nullptr, 10) : 1;
+		return CannonGame::RunBenchmark(nBalls, seconds, seed);
+	}
+
+	// headless Connect Four solver benchmark, the moves are columns from 1 to 7: AdGames --bench-connect-four <moves|-> [threads] [seconds]
+	if (argc >= 3 && strcmp(argv[1], "--bench-connect-four") == 0)
+	{
+		std::string moves = strcmp(argv[2], "-") == 0 ? "" : argv[2];
+		uint maxThreads = argc >= 4 ? (uint)strtoul(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+		double seconds = argc >= 5 ? atof(argv[4]) : 600.0;
+		return ConnectFour::RunBenchmark(moves, maxThreads, seconds);
+	}
+
 	Application app;
 	app.run();
 	app.dispose();
@@ -1,6 +1,9 @@
 #pragma warning(disable: 4244)
 
 #include "Launcher.h"
+#include "engine/ShaderCache.h"
+#include "engine/SharedUniforms.h"
+#include "engine/ImageCache.h"
 
 #include "SpikeDodge.h"
 #include "MathGates.h"
@@ -20,152 +23,143 @@ const int SCR_HEIGHT = WIDGET_HEIGHT * N_ROWS + WIDGET_PADDING * (N_ROWS + 1);
 const int IMAGE_WIDTH = WIDGET_WIDTH - 2 * WIDGET_PADDING;
 const int IMAGE_HEIGHT = 3 * IMAGE_WIDTH / 4;
 
-void Launcher::GameHub::Launch()
+Launcher::GameHub::GameHub()
 {
-	Onyx::Init();
+	manager = nullptr;
+	iconSet = false;
+}
 
+Onyx::WindowProperties Launcher::GameHub::GetWindowProperties()
+{
 	Monitor monitor = Monitor::GetPrimary();
 
-	window = Window(
-		WindowProperties{
-			.title = "Launcher",
-			.width = SCR_WIDTH,
-			.height = SCR_HEIGHT,
-			.position = Vec2(monitor.getWidth() / 2 - SCR_WIDTH / 2, monitor.getHeight() / 2 - SCR_HEIGHT / 2),
-			.resizable = false,
-			.nSamplesMSAA = 16,
-			.backgroundColor = Vec3::DarkGray() * 0.6f,
-		}
-	);
-
-	window.init();
+	return WindowProperties{
+		.title = "Launcher",
+		.width = SCR_WIDTH,
+		.height = SCR_HEIGHT,
+		.position = Vec2(monitor.getWidth() / 2 - SCR_WIDTH / 2, monitor.getHeight() / 2 - SCR_HEIGHT / 2),
+		.resizable = false,
+		.nSamplesMSAA = 16,
+		.backgroundColor = Vec3::DarkGray() * 0.6f,
+	};
+}
 
-	Onyx::WindowIcon icon = Onyx::WindowIcon::Load({
-		Onyx::Resources("icons/icon-16x.png"),
-		Onyx::Resources("icons/icon-24x.png"),
-		Onyx::Resources("icons/icon-32x.png"),
-		Onyx::Resources("icons/icon-48x.png"),
-		Onyx::Resources("icons/icon-256x.png")
-	});
-	window.setIcon(icon);
-	icon.dispose();
+void Launcher::GameHub::load(SceneManager& manager)
+{
+	this->manager = &manager;
+	Window& window = manager.getWindow();
+	manager.configureWindow(GetWindowProperties());
+
+	// everything read from disk is loaded in the background, the first frames are drawn without it and it pops in once it's uploaded
+	iconPaths = {
+		Resources("icons/icon-16x.png"),
+		Resources("icons/icon-24x.png"),
+		Resources("icons/icon-32x.png"),
+		Resources("icons/icon-48x.png"),
+		Resources("icons/icon-256x.png")
+	};
+	iconSet = false;
 
 	arrowCursor = Cursor::Standard(CursorType::Arrow);
 	handCursor = Cursor::Standard(CursorType::Hand);
 
-	InputHandler input;
 	window.linkInputHandler(input);
 
-	Camera cam(Projection::Orthographic(SCR_WIDTH, SCR_HEIGHT));
+	cam = Camera(Projection::Orthographic(SCR_WIDTH, SCR_HEIGHT));
 	window.linkCamera(cam);
 
-	renderer = Renderer(cam);
-	window.linkRenderer(renderer);
+	// the widget backgrounds and images are drawn into one batch, and each widget's text is one more draw
+	shapes = ShapeBatch(256);
 
-	Font font = Font::Load(Resources("fonts/Roboto/Roboto-Regular.ttf"), 18);
+	font = AssetLoader::LoadFont(Resources("fonts/Roboto/Roboto-Regular.ttf"), 18, false, assets);
 
-	widgets.push_back(GameWidget("Spike Dodge", Resources("textures/spike_dodge_image.png"), 0, LaunchSpikeDodge, &font));
-	widgets.push_back(GameWidget("Math Gates", Resources("textures/math_gates_image.png"), 1, LaunchMathGates, &font));
-	widgets.push_back(GameWidget("Connect Four", Resources("textures/connect_four_image.png"), 2, LaunchConnectFour, &font));
-	widgets.push_back(GameWidget("Cannon", Resources("textures/cannon_image.png"), 3, LaunchCannon, &font));
+	widgets.push_back(GameWidget("Spike Dodge", Resources("textures/spike_dodge_image.png"), 0, []() -> std::unique_ptr<Scene> { return std::make_unique<SpikeDodge::Game>(); }, assets));
+	widgets.push_back(GameWidget("Math Gates", Resources("textures/math_gates_image.png"), 1, []() -> std::unique_ptr<Scene> { return std::make_unique<MathGates::Game>(); }, assets));
+	widgets.push_back(GameWidget("Connect Four", Resources("textures/connect_four_image.png"), 2, []() -> std::unique_ptr<Scene> { return std::make_unique<ConnectFour::Game>(); }, assets));
+	widgets.push_back(GameWidget("Cannon", Resources("textures/cannon_image.png"), 3, []() -> std::unique_ptr<Scene> { return std::make_unique<CannonGame::Game>(); }, assets));
+}
 
-	for (GameWidget& widget : widgets) widget.addToRenderer(renderer);
+void Launcher::GameHub::update(double dt)
+{
+	Window& window = manager->getWindow();
 
-	while (window.isOpen())
-	{
-		input.update();
+	input.update();
 
-		if (input.isKeyPressed(Key::Escape)) window.close();
-		bool hovered = false;
+	if (!iconSet) iconSet = ImageCache::SetWindowIcon(window, iconPaths, false);
+
+	if (font.isLoaded())
 		for (GameWidget& widget : widgets)
-		{
-			Vec2 pos = input.getMousePos();
-			if (pos.getX() >= widget.getMid().getX() - WIDGET_WIDTH / 2 && pos.getX() <= widget.getMid().getX() + WIDGET_WIDTH / 2 &&
-				pos.getY() >= widget.getMid().getY() - WIDGET_HEIGHT / 2 && pos.getY() <= widget.getMid().getY() + WIDGET_HEIGHT / 2)
-			{
-				widget.mouseEnter();
-				hovered = true;
-				if (input.isMouseButtonTapped(MouseButton::Left)) widget.mouseClick();
-			}
-			else widget.mouseExit();
+			if (!widget.hasText()) widget.createText(font.get());
 
+	if (input.isKeyPressed(Key::Escape)) manager->pop();
+	bool hovered = false;
+	for (GameWidget& widget : widgets)
+	{
+		Vec2 pos = input.getMousePos();
+		if (pos.getX() >= widget.getMid().getX() - WIDGET_WIDTH / 2 && pos.getX() <= widget.getMid().getX() + WIDGET_WIDTH / 2 &&
+			pos.getY() >= widget.getMid().getY() - WIDGET_HEIGHT / 2 && pos.getY() <= widget.getMid().getY() + WIDGET_HEIGHT / 2)
+		{
+			widget.mouseEnter();
+			hovered = true;
+			// the launcher stays loaded under the game, so coming back to it is instant
+			if (input.isMouseButtonTapped(MouseButton::Left)) manager->push(widget.mouseClick());
 		}
-		if (hovered) window.setCursor(handCursor);
-		else window.setCursor(arrowCursor);
-
-		cam.update();
+		else widget.mouseExit();
 
-		window.startRender();
-		renderer.render();
-		window.endRender();
 	}
+	if (hovered) window.setCursor(handCursor);
+	else window.setCursor(arrowCursor);
 
-	window.dispose();
-	renderer.dispose();
-	arrowCursor.dispose();
-	handCursor.dispose();
-	widgets.clear();
+	cam.update();
 
-	Onyx::Terminate();
-	exit(0);
+	for (GameWidget& widget : widgets) widget.draw(shapes);
 }
 
-void Launcher::GameHub::Dispose()
+void Launcher::GameHub::render(double alpha)
 {
-	window.close();
-	window.dispose();
-	renderer.dispose();
-	arrowCursor.dispose();
-	handCursor.dispose();
-	widgets.clear();
-
-	Onyx::Terminate();
+	// drawn before the text, since the text's quads would otherwise hide what's behind them from the depth test
+	SharedUniforms::SetCamera(cam);
+	shapes.render();
+	for (GameWidget& widget : widgets) widget.renderText();
 }
 
-void Launcher::GameHub::LaunchSpikeDodge()
+void Launcher::GameHub::unload()
 {
-	Dispose();
-	SpikeDodge::Run();
-}
-
-void Launcher::GameHub::LaunchMathGates()
-{
-	Dispose();
-	MathGates::Run();
-}
-
-void Launcher::GameHub::LaunchConnectFour()
-{
-	Dispose();
-	ConnectFour::Run();
+	// nothing still loading may be uploaded after what it belongs to is gone, loads started by anyone else carry on
+	AssetLoader::Cancel(assets);
+	shapes.dispose();
+	for (GameWidget& widget : widgets) widget.dispose();
+	if (font.isLoaded()) font.get().dispose();
+	arrowCursor.dispose();
+	handCursor.dispose();
+	widgets.clear();
 }
 
-void Launcher::GameHub::LaunchCannon()
+void Launcher::GameHub::resume()
 {
-	Dispose();
-	CannonGame::Run();
+	Window& window = manager->getWindow();
+	manager->configureWindow(GetWindowProperties());
+	window.linkInputHandler(input);
+	window.linkCamera(cam);
+	input.setCursorLock(false);
 }
 
-Onyx::Window Launcher::GameHub::window;
-Onyx::Renderer Launcher::GameHub::renderer;
-Onyx::Cursor Launcher::GameHub::arrowCursor;
-Onyx::Cursor Launcher::GameHub::handCursor;
-std::vector<Launcher::GameWidget> Launcher::GameHub::widgets;
-
 Launcher::GameWidget::GameWidget()
 {
-	launchFunc = nullptr;
+	createScene = nullptr;
+	hovered = false;
+	textCreated = false;
 }
 
-Launcher::GameWidget::GameWidget(const std::string& name, const std::string& imagePath, int index, void (*launchFunc)(), Font* font)
+Launcher::GameWidget::GameWidget(const std::string& name, const std::string& imagePath, int index, std::unique_ptr<Onyx::Scene>(*createScene)(), const AssetGroup& assets)
 {
 	this->name = name;
 	this->imagePath = imagePath;
-	this->launchFunc = launchFunc;
+	this->createScene = createScene;
+	hovered = false;
+	textCreated = false;
 
-	background = Renderable::ColoredQuad(WIDGET_WIDTH, WIDGET_HEIGHT, Vec4::LightGray() * 0.5f);
-	image = Renderable::TexturedQuad(IMAGE_WIDTH, IMAGE_HEIGHT, Texture::Load(imagePath));
-	text = TextRenderable3D(name, *font, Vec4::White());
+	image = ImageCache::GetTexture(imagePath, TextureWrap::Repeat, TextureFilter::Nearest, TextureFilter::Linear, assets);
 
 	Vec2 mid(WIDGET_PADDING + WIDGET_WIDTH / 2, SCR_HEIGHT - WIDGET_PADDING - WIDGET_HEIGHT / 2);
 	if (index % WIDGETS_PER_ROW != 0)
@@ -175,39 +169,57 @@ Launcher::GameWidget::GameWidget(const std::string& name, const std::string& ima
 		for (int i = 0; i < index / WIDGETS_PER_ROW; i++) mid.setY(mid.getY() - WIDGET_PADDING - WIDGET_HEIGHT);
 
 	this->mid = mid;
+}
 
-	background.setPosition(Vec3(mid, -1.0f));
-	image.setPosition(Vec3(mid.getX(), mid.getY() + (WIDGET_HEIGHT - IMAGE_HEIGHT) / 2 - WIDGET_PADDING, -0.9f));
+void Launcher::GameWidget::createText(AtlasFont& font)
+{
+	text = AtlasText3D(name, font, Vec4::White());
 	text.setPosition(Vec3(mid.getX() - text.getWidth() / 2, mid.getY() - WIDGET_HEIGHT / 2 + WIDGET_PADDING, -0.8f));
+	textCreated = true;
+}
+
+bool Launcher::GameWidget::hasText() const
+{
+	return textCreated;
 }
 
-void Launcher::GameWidget::addToRenderer(Renderer& renderer)
+void Launcher::GameWidget::draw(ShapeBatch& shapes)
 {
-	renderer.add(background);
-	renderer.add(image);
-	renderer.add(text);
+	shapes.drawQuad(Vec3(mid, -1.0f), Vec2(WIDGET_WIDTH, WIDGET_HEIGHT), 0.0f, Vec4::LightGray() * (hovered ? 0.6f : 0.5f));
+	Vec3 imageCenter(mid.getX(), mid.getY() + (WIDGET_HEIGHT - IMAGE_HEIGHT) / 2 - WIDGET_PADDING, -0.9f);
+
+	// a dark placeholder until the thumbnail is uploaded
+	if (image.isLoaded()) shapes.drawTexturedQuad(image.get(), imageCenter, Vec2(IMAGE_WIDTH, IMAGE_HEIGHT), 0.0f);
+	else shapes.drawQuad(imageCenter, Vec2(IMAGE_WIDTH, IMAGE_HEIGHT), 0.0f, Vec4::DarkGray());
+}
+
+void Launcher::GameWidget::renderText()
+{
+	if (textCreated) text.render();
 }
 
 void Launcher::GameWidget::mouseEnter()
 {
-	Shader* shader = background.getShader();
-	shader->use();
-	shader->setVec4("u_color", Vec4::LightGray() * 0.6f);
+	hovered = true;
 }
 
 void Launcher::GameWidget::mouseExit()
 {
-	Shader* shader = background.getShader();
-	shader->use();
-	shader->setVec4("u_color", Vec4::LightGray() * 0.5f);
+	hovered = false;
 }
 
-void Launcher::GameWidget::mouseClick()
+std::unique_ptr<Onyx::Scene> Launcher::GameWidget::mouseClick()
 {
-	launchFunc();
+	return createScene();
 }
 
 const Vec2& Launcher::GameWidget::getMid() const
 {
 	return mid;
 }
+
+void Launcher::GameWidget::dispose()
+{
+	if (image.isLoaded()) image.get().dispose();
+	if (textCreated) text.dispose();
+}
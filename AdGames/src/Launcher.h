@@ -3,52 +3,71 @@
 #include <iostream>
 #include <vector>
 
-#include <Onyx/Renderable.h>
-#include <Onyx/TextRenderable.h>
+#include <Onyx/Window.h>
 #include <Onyx/Camera.h>
+#include <Onyx/InputHandler.h>
 #include <Onyx/Math.h>
 
+#include "engine/ShapeBatch.h"
+#include "engine/AtlasFont.h"
+#include "engine/AtlasText3D.h"
+#include "engine/AssetLoader.h"
+#include "engine/SceneManager.h"
+
 namespace Launcher
 {
 	class GameWidget
 	{
 	public:
 		GameWidget();
-		GameWidget(const std::string& name, const std::string& imagePath, int index, void(*launchFunc)(), Onyx::Font* font);
+		GameWidget(const std::string& name, const std::string& imagePath, int index, std::unique_ptr<Onyx::Scene>(*createScene)(), const Onyx::AssetGroup& assets);
+
+		void createText(Onyx::AtlasFont& font);
+		bool hasText() const;
 
-		void addToRenderer(Onyx::Renderer& renderer);
+		void draw(Onyx::ShapeBatch& shapes);
+		void renderText();
 		void mouseEnter();
 		void mouseExit();
-		void mouseClick();
+		std::unique_ptr<Onyx::Scene> mouseClick();
 
 		const Onyx::Math::Vec2& getMid() const;
 
+		void dispose();
+
 	private:
 		std::string name, imagePath;
-		void (*launchFunc)();
+		std::unique_ptr<Onyx::Scene>(*createScene)();
 		Onyx::Math::Vec2 mid;
+		bool hovered, textCreated;
 
-		Onyx::Renderable background, image;
-		Onyx::TextRenderable3D text;
+		Onyx::AssetHandle<Onyx::Texture2D> image;
+		Onyx::AtlasText3D text;
 	};
 
-	class GameHub
+	class GameHub : public Onyx::Scene
 	{
 	public:
+		GameHub();
 
-		static void Launch();
+		void load(Onyx::SceneManager& manager) override;
+		void update(double dt) override;
+		void render(double alpha) override;
+		void unload() override;
+		void resume() override;
 
-	private:
-		static void Dispose();
-
-		static void LaunchSpikeDodge();
-		static void LaunchMathGates();
-		static void LaunchConnectFour();
-		static void LaunchCannon();
+		static Onyx::WindowProperties GetWindowProperties();
 
-		static Onyx::Window window;
-		static Onyx::Renderer renderer;
-		static Onyx::Cursor arrowCursor, handCursor;
-		static std::vector<GameWidget> widgets;
+	private:
+		Onyx::SceneManager* manager;
+		Onyx::InputHandler input;
+		Onyx::Camera cam;
+		Onyx::ShapeBatch shapes;
+		Onyx::AssetGroup assets;
+		Onyx::AssetHandle<Onyx::AtlasFont> font;
+		Onyx::Cursor arrowCursor, handCursor;
+		std::vector<GameWidget> widgets;
+		std::vector<std::string> iconPaths;
+		bool iconSet;
 	};
 }
@@ -2,7 +2,9 @@
 
 #include "MathGates.h"
 
-#include "Launcher.h"
+#include "engine/ShaderCache.h"
+#include "engine/PrimitiveCache.h"
+#include "engine/FontCache.h"
 
 #include <Onyx/Core.h>
 #include <Onyx/Window.h>
@@ -13,67 +15,91 @@
 
 using Onyx::Math::Vec2, Onyx::Math::Vec3, Onyx::Math::Vec4, Onyx::Math::IVec2, Onyx::Math::Rand;
 
-void onyx_add_malloc(void*, bool);
+// the gate numbers are about a world unit tall, the font is an SDF font so a small atlas stays sharp at that size
+const uint GATE_FONT_SIZE = 48;
+const float GATE_TEXT_SIZE = 0.9728f;
 
-void MathGates::Run()
+const double CAM_SPEED = 6.0f;
+const double PLAYER_SPEED = 1.0f;
+const double CAM_SENS = 50.0f;
+
+const double PLAYER_STRAFE_LIMIT = 3.0f;
+
+const bool ALLOW_FULL_MOVEMENT = false;
+
+MathGates::Game::Game()
+{
+	m_pManager = nullptr;
+	m_score = 0;
+	m_running = false;
+}
+
+void MathGates::Game::load(Onyx::SceneManager& manager)
 {
-	Onyx::Init();
+	m_pManager = &manager;
+	Onyx::Window& window = manager.getWindow();
 
-	Onyx::Window window(
+	Onyx::Monitor monitor = Onyx::Monitor::GetPrimary();
+	manager.configureWindow(
 		Onyx::WindowProperties{
 			.title = "Math Gates",
 			.width = 1280,
 			.height = 720,
-			.position = IVec2(2560 / 2 - 1280 / 2, 1440 / 2 - 720 / 2),
-			.nSamplesMSAA = 16
+			.position = IVec2(monitor.getDimensions().getX() / 2 - 1280 / 2, monitor.getDimensions().getY() / 2 - 720 / 2),
+			.backgroundColor = Vec3::LightBlue()
 		}
 	);
 
-	window.init();
-	window.setBackgroundColor(Vec3::LightBlue());
-	Onyx::Monitor monitor = Onyx::Monitor::GetPrimary();
-	window.setPosition(IVec2(monitor.getDimensions().getX() / 2 - window.getWidth() / 2, monitor.getDimensions().getY() / 2 - window.getHeight() / 2));
+	window.linkInputHandler(m_input);
 
-	Onyx::WindowIcon icon = Onyx::WindowIcon::Load({
-		Onyx::Resources("icons/icon-16x.png"),
-		Onyx::Resources("icons/icon-24x.png"),
-		Onyx::Resources("icons/icon-32x.png"),
-		Onyx::Resources("icons/icon-48x.png"),
-		Onyx::Resources("icons/icon-256x.png")
-	});
-	window.setIcon(icon);
-	icon.dispose();
+	m_cam = Onyx::Camera(Onyx::Projection::Perspective(60.0f, 1280, 720));
+	window.linkCamera(m_cam);
+	m_cam.translate(Vec3(1.0f, 0.2f, -20.0f));
 
-	Onyx::InputHandler input;
-	window.linkInputHandler(input);
+	m_lighting = Onyx::Lighting(Vec3::White(), 0.3f, Vec3(0.2f, -1.0f, -0.3f));
+	m_fog = Onyx::Fog(Vec3::LightBlue(), 20.0f, 40.0f);
 
-	Onyx::Camera cam(Onyx::Projection::Perspective(60.0f, 1280, 720));
-	window.linkCamera(cam);
-	cam.translate(Vec3(1.0f, 0.2f, -20.0f));
+	m_renderQueue = Onyx::RenderQueue(window, m_cam, m_lighting, m_fog);
 
-	Onyx::Lighting lighting(Vec3::White(), 0.3f, Vec3(0.2f, -1.0f, -0.3f));
-	Onyx::Fog fog(Vec3::LightBlue(), 20.0f, 40.0f);
+	m_floor = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_floor.setScale(Vec3(5.0f, 0.2f, 200.0f));
+	m_floor.translate(Vec3(1.1f, -0.9f, -90.0f));
+	m_floorHandle = m_renderQueue.add(m_floor, Vec4::White());
 
-	Onyx::Renderer renderer(cam, lighting, fog);
-	window.linkRenderer(renderer);
+	m_poppinsHandle = Onyx::FontCache::Load(Onyx::Resources("fonts/Poppins/Poppins-Regular.ttf"), 32);
+	m_poppinsBoldHandle = Onyx::FontCache::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 64);
+	m_gateFontHandle = Onyx::FontCache::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), GATE_FONT_SIZE, true);
+
+	m_score = 0;
+
+	m_input.setCursorLock(true);
+
+	m_running = true;
+}
+
+bool MathGates::Game::finishLoad()
+{
+	for (Onyx::AssetState state : { m_poppinsHandle.getState(), m_poppinsBoldHandle.getState(), m_gateFontHandle.getState() })
+	{
+		if (state == Onyx::AssetState::Pending) return false;
+		if (state == Onyx::AssetState::Failed)
+		{
+			m_pManager->pop();
+			return false;
+		}
+	}
+
+	m_poppins = m_poppinsHandle.get();
+	m_poppinsBold = m_poppinsBoldHandle.get();
 
 	Gate::Operator ops[5] = {
 		Gate::Operator::Add, Gate::Operator::Subtract, Gate::Operator::Multiply, Gate::Operator::Divide, Gate::Operator::Power
 	};
 
-	Onyx::Renderable floor = Onyx::Renderable::ColoredRectPrism(5.0f, 0.2f, 200.0f, Vec4::White());
-	floor.translate(Vec3(1.1f, -0.9f, -90.0f));
-	renderer.add(floor);
-
-	Onyx::Font poppins = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Regular.ttf"), 32);
-	Onyx::Font poppinsBold = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 64);
-
-	Onyx::TextRenderable scoreText = Onyx::TextRenderable("Score: 0", poppins, Vec4::White());
+	m_scoreText = Onyx::AtlasText("Score: 0", m_poppins, Vec4::White());
 
 	srand(time(nullptr));
 
-	std::vector<Gate*> pGates;
-
 	bool squared = false;
 	for (int i = 20; i >= 0; i--)
 	{
@@ -97,106 +123,106 @@ void MathGates::Run()
 			Vec3 color;
 			if (op == Gate::Operator::Add || op == Gate::Operator::Multiply || op == Gate::Operator::Power) color = Vec3::Green();
 			else color = Vec3::Red();
-			Gate* gate = new Gate(num, op, color);
-			onyx_add_malloc(gate, false);
-			gate->translate(Vec3(j * 2.0f, 0.0f, -i * 7.5f));
-			gate->addToRenderer(renderer);
-			pGates.push_back(gate);
+			Gate& gate = m_gates.emplace_back(num, op, color);
+			gate.translate(Vec3(j * 2.0f, 0.0f, -i * 7.5f));
+			gate.addToRenderQueue(m_renderQueue);
 		}
 	}
 
-	renderer.add(scoreText);
-
-	const double CAM_SPEED = 6.0f;
-	const double PLAYER_SPEED = 1.0f;
-	const double CAM_SENS = 50.0f;
-
-	const double PLAYER_STRAFE_LIMIT = 3.0f;
+	m_scoreTextHandle = m_renderQueue.add(m_scoreText);
 
-	const bool ALLOW_FULL_MOVEMENT = false;
-
-	long long score = 0.0f;
+	return true;
+}
 
-	input.setCursorLock(true);
+void MathGates::Game::update(double dt)
+{
+	Onyx::Window& window = m_pManager->getWindow();
 
-	bool running = true;
+	m_input.update();
 
-	while (window.isOpen())
+	if (m_input.isKeyTapped(Onyx::Key::Escape))
 	{
-		double dt = window.getDeltaTime();
-
-		input.update();
-
-		if (input.isKeyTapped(Onyx::Key::Escape)) window.close();
-		if (input.isKeyTapped(Onyx::Key::F1)) Onyx::Renderer::ToggleWireframe();
-		if (input.isKeyTapped(Onyx::Key::F12)) window.toggleFullscreen();
+		m_pManager->pop();
+		return;
+	}
+	if (m_input.isKeyTapped(Onyx::Key::F1)) Onyx::Renderer::ToggleWireframe();
+	if (m_input.isKeyTapped(Onyx::Key::F12)) window.toggleFullscreen();
 
-		if (running)
+	if (m_running)
+	{
+		if (ALLOW_FULL_MOVEMENT)
 		{
-			if (ALLOW_FULL_MOVEMENT)
-			{
-				if (input.isKeyDown(Onyx::Key::W)) cam.translateFB(CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::A)) cam.translateLR(-CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::S)) cam.translateFB(-CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::D)) cam.translateLR(CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::Space)) cam.translateUD(CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::C)) cam.translateUD(-CAM_SPEED * dt * PLAYER_SPEED);
-
-				cam.rotate(input.getMouseDeltas().getX() / 200.0f * CAM_SENS, input.getMouseDeltas().getY() / 200.0f * CAM_SENS);
-			}
-			else
-			{
-				cam.translateFB(CAM_SPEED * dt * PLAYER_SPEED);
-				if (input.isKeyDown(Onyx::Key::A)) cam.translateLR(-CAM_SPEED * dt);
-				if (input.isKeyDown(Onyx::Key::D)) cam.translateLR(CAM_SPEED * dt);
-
-				if (cam.getPosition().getX() < 0.2f - PLAYER_STRAFE_LIMIT) cam.setPosition(Vec3(0.2f - PLAYER_STRAFE_LIMIT, cam.getPosition().getY(), cam.getPosition().getZ()));
-				else if (cam.getPosition().getX() > 0.2f + PLAYER_STRAFE_LIMIT) cam.setPosition(Vec3(0.2f + PLAYER_STRAFE_LIMIT, cam.getPosition().getY(), cam.getPosition().getZ()));
-			}
+			if (m_input.isKeyDown(Onyx::Key::W)) m_cam.translateFB(CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::A)) m_cam.translateLR(-CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::S)) m_cam.translateFB(-CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::D)) m_cam.translateLR(CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::Space)) m_cam.translateUD(CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::C)) m_cam.translateUD(-CAM_SPEED * dt * PLAYER_SPEED);
+
+			m_cam.rotate(m_input.getMouseDeltas().getX() / 200.0f * CAM_SENS, m_input.getMouseDeltas().getY() / 200.0f * CAM_SENS);
+		}
+		else
+		{
+			m_cam.translateFB(CAM_SPEED * dt * PLAYER_SPEED);
+			if (m_input.isKeyDown(Onyx::Key::A)) m_cam.translateLR(-CAM_SPEED * dt);
+			if (m_input.isKeyDown(Onyx::Key::D)) m_cam.translateLR(CAM_SPEED * dt);
 
-			for (Gate* gate : pGates)
-			{
-				if (gate->collision(cam.getPosition()))
-				{
-					gate->changeScore(&score);
-				}
-			}
+			if (m_cam.getPosition().getX() < 0.2f - PLAYER_STRAFE_LIMIT) m_cam.setPosition(Vec3(0.2f - PLAYER_STRAFE_LIMIT, m_cam.getPosition().getY(), m_cam.getPosition().getZ()));
+			else if (m_cam.getPosition().getX() > 0.2f + PLAYER_STRAFE_LIMIT) m_cam.setPosition(Vec3(0.2f + PLAYER_STRAFE_LIMIT, m_cam.getPosition().getY(), m_cam.getPosition().getZ()));
+		}
 
-			if (cam.getPosition().getZ() < -155.0f)
+		for (Gate& gate : m_gates)
+		{
+			if (gate.collision(m_cam.getPosition()))
 			{
-				running = false;
-				Onyx::TextRenderable finalScore("SCORE: " + std::to_string(score), poppinsBold, score > 0 ? Vec4::Green() : Vec4::Red());
-				Onyx::TextRenderable* pFinalScore = new Onyx::TextRenderable(finalScore);
-				onyx_add_malloc(pFinalScore, false);
-				pFinalScore->setPosition(Vec2(1280 / 2 - pFinalScore->getWidth() / 2, 720 / 2 - pFinalScore->getHeight() / 2));
-				renderer.add(*pFinalScore);
-				scoreText.hide();
-				floor.hide();
+				gate.changeScore(&m_score);
 			}
-
-			scoreText.setText("Score: " + std::to_string(score));
-			float w = window.getBufferWidth(), h = window.getBufferHeight();
-			float tw = scoreText.getWidth(), th = scoreText.getHeight();
-			scoreText.setPosition(Vec2((w - tw) / 2.0f, h - th - 50.0f));
 		}
 
-		cam.update();
+		if (m_cam.getPosition().getZ() < -155.0f)
+		{
+			m_running = false;
+			m_finalScoreText = Onyx::AtlasText("SCORE: " + std::to_string(m_score), m_poppinsBold, m_score > 0 ? Vec4::Green() : Vec4::Red());
+			m_finalScoreText.setPosition(Vec2(1280 / 2 - m_finalScoreText.getWidth() / 2, 720 / 2 - m_finalScoreText.getHeight() / 2));
+			m_renderQueue.add(m_finalScoreText);
+			m_renderQueue.remove(m_scoreTextHandle);
+			m_renderQueue.remove(m_floorHandle);
+		}
 
-		window.startRender();
-		renderer.render();
-		window.endRender();
+		m_scoreText.setText("Score: " + std::to_string(m_score));
+		float w = window.getBufferWidth(), h = window.getBufferHeight();
+		float tw = m_scoreText.getWidth(), th = m_scoreText.getHeight();
+		m_scoreText.setPosition(Vec2((w - tw) / 2.0f, h - th - 50.0f));
 	}
 
-	renderer.dispose();
-	window.dispose();
+	m_cam.update();
+}
 
-	Onyx::Terminate();
+void MathGates::Game::render(double alpha)
+{
+	m_renderQueue.render();
+}
 
-	Launcher::GameHub::Launch();
+void MathGates::Game::unload()
+{
+	m_renderQueue.dispose();
+	if (!m_running)
+	{
+		m_scoreText.dispose();
+		Onyx::ShaderCache::DisposeRenderable(m_floor);
+	}
+	for (Gate& gate : m_gates) gate.dispose();
+	m_gates.clear();
+	Onyx::FontCache::Release(m_poppinsHandle);
+	Onyx::FontCache::Release(m_poppinsBoldHandle);
+	Onyx::FontCache::Release(m_gateFontHandle);
+	m_input.setCursorLock(false);
 }
 
-Onyx::Font MathGates::Gate::sm_font;
-bool MathGates::Gate::sm_fontCreated = false;
+const Onyx::RenderQueue* MathGates::Game::getRenderQueue() const
+{
+	return &m_renderQueue;
+}
 
 MathGates::Gate::Gate()
 {
@@ -225,30 +251,32 @@ MathGates::Gate::Gate(int val, Operator op, Vec3 color)
 
 	m_text += std::to_string(val);
 
-#ifndef GATE_FONT_CREATED
-#define GATE_FONT_CREATED
-	sm_font = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 512);
-#endif
+	// every gate shares one atlas, only the first gate actually rasterizes it
+	m_font = Onyx::FontCache::GetSDF(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), GATE_FONT_SIZE);
 
-	m_textRenderable = Onyx::TextRenderable3D(m_text, sm_font, Vec4::White());
-	m_textRenderable.scale(0.0019f);
+	m_textRenderable = Onyx::AtlasText3D(m_text, m_font, Vec4::White());
+	m_textRenderable.scale(GATE_TEXT_SIZE / GATE_FONT_SIZE);
 
 	if (m_text.length() > 2)
 	{
-		float h = sm_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY();
+		float h = m_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY();
 		m_textRenderable.scale(2.0f / m_text.length());
-		m_textRenderable.translate(Vec3(0.0f, (h - sm_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY()) / 2.0f, 0.0f));
+		m_textRenderable.translate(Vec3(0.0f, (h - m_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY()) / 2.0f, 0.0f));
 	}
 
 	m_textRenderable.translate(Vec3(-m_textRenderable.getWidth() / 2.0f, -0.22f, 0.055f));
 
-	m_leftPost = Onyx::Renderable::ColoredRectPrism(0.2f, 1.5f, 0.2f, Vec4::LightGray());
+	// every gate shares the unit cube, sized by its scale
+	m_leftPost = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_leftPost.setScale(Vec3(0.2f, 1.5f, 0.2f));
 	m_leftPost.translate(Vec3(-1.0f, 0.0f, 0.0f));
 
-	m_rightPost = Onyx::Renderable::ColoredRectPrism(0.2f, 1.5f, 0.2f, Vec4::LightGray());
+	m_rightPost = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_rightPost.setScale(Vec3(0.2f, 1.5f, 0.2f));
 	m_rightPost.translate(Vec3(1.0f, 0.0f, 0.0f));
 
-	m_screen = Onyx::Renderable::ColoredRectPrism(1.8f, 1.2f, 0.1f, Vec4(m_color, 0.5f));
+	m_screen = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_screen.setScale(Vec3(1.8f, 1.2f, 0.1f));
 	m_screen.translate(Vec3(0.0f, 0.14f, 0.0f));
 }
 
@@ -260,12 +288,12 @@ void MathGates::Gate::translate(const Vec3& translation)
 	m_textRenderable.translate(translation);
 }
 
-void MathGates::Gate::addToRenderer(Onyx::Renderer& renderer)
+void MathGates::Gate::addToRenderQueue(Onyx::RenderQueue& renderQueue)
 {
-	renderer.add(m_textRenderable);
-	renderer.add(m_leftPost);
-	renderer.add(m_rightPost);
-	renderer.add(m_screen);
+	renderQueue.add(m_textRenderable);
+	renderQueue.add(m_leftPost, Vec4::LightGray());
+	renderQueue.add(m_rightPost, Vec4::LightGray());
+	renderQueue.add(m_screen, Vec4(m_color, 0.5f), Onyx::RenderPass::Transparent);
 }
 
 bool MathGates::Gate::collision(const Onyx::Math::Vec3& camPos)
@@ -329,9 +357,9 @@ void MathGates::Gate::setColor(const Vec3& color)
 void MathGates::Gate::refresh()
 {
 	m_textRenderable.dispose();
-	m_leftPost.dispose();
-	m_rightPost.dispose();
-	m_screen.dispose();
+	Onyx::ShaderCache::DisposeRenderable(m_leftPost);
+	Onyx::ShaderCache::DisposeRenderable(m_rightPost);
+	Onyx::ShaderCache::DisposeRenderable(m_screen);
 
 	m_text = "";
 	switch (m_op)
@@ -346,30 +374,41 @@ void MathGates::Gate::refresh()
 
 	m_text += std::to_string(m_val);
 
-	if (!sm_fontCreated)
-	{
-		sm_fontCreated = true;
-		sm_font = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 512);
-	}
+	// a gate made with the default constructor doesn't hold the font yet
+	if (!Onyx::FontCache::Contains(m_font)) m_font = Onyx::FontCache::GetSDF(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), GATE_FONT_SIZE);
 
-	m_textRenderable = Onyx::TextRenderable3D(m_text, sm_font, Vec4::White());
-	m_textRenderable.scale(0.0019f);
+	m_textRenderable = Onyx::AtlasText3D(m_text, m_font, Vec4::White());
+	m_textRenderable.scale(GATE_TEXT_SIZE / GATE_FONT_SIZE);
 
 	if (m_text.length() > 2)
 	{
-		float h = sm_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY();
+		float h = m_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY();
 		m_textRenderable.scale(2.0f / m_text.length());
-		m_textRenderable.translate(Vec3(0.0f, (h - sm_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY()) / 2.0f, 0.0f));
+		m_textRenderable.translate(Vec3(0.0f, (h - m_font.getStringDimensions("A").getY() * m_textRenderable.getScale().getY()) / 2.0f, 0.0f));
 	}
 
 	m_textRenderable.translate(Vec3(-m_textRenderable.getWidth() / 2.0f, -0.22f, 0.055f));
 
-	m_leftPost = Onyx::Renderable::ColoredRectPrism(0.2f, 1.5f, 0.2f, Vec4::LightGray());
+	// every gate shares the unit cube, sized by its scale
+	m_leftPost = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_leftPost.setScale(Vec3(0.2f, 1.5f, 0.2f));
 	m_leftPost.translate(Vec3(-1.0f, 0.0f, 0.0f));
 
-	m_rightPost = Onyx::Renderable::ColoredRectPrism(0.2f, 1.5f, 0.2f, Vec4::LightGray());
+	m_rightPost = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_rightPost.setScale(Vec3(0.2f, 1.5f, 0.2f));
 	m_rightPost.translate(Vec3(1.0f, 0.0f, 0.0f));
 
-	m_screen = Onyx::Renderable::ColoredRectPrism(1.8f, 1.2f, 0.1f, Vec4(m_color, 0.5f));
+	m_screen = Onyx::Renderable(Onyx::PrimitiveCache::Cube(), Onyx::ShaderCache::P_Color());
+	m_screen.setScale(Vec3(1.8f, 1.2f, 0.1f));
 	m_screen.translate(Vec3(0.0f, 0.14f, 0.0f));
 }
+
+void MathGates::Gate::dispose()
+{
+	m_textRenderable.dispose();
+	Onyx::ShaderCache::DisposeRenderable(m_leftPost);
+	Onyx::ShaderCache::DisposeRenderable(m_rightPost);
+	Onyx::ShaderCache::DisposeRenderable(m_screen);
+	Onyx::FontCache::Release(m_font);
+	m_font = Onyx::AtlasFont();
+}
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <list>
+
 #include <Onyx/Renderer.h>
+#include <Onyx/InputHandler.h>
+#include <Onyx/Camera.h>
+#include <Onyx/Lighting.h>
+#include <Onyx/Fog.h>
+
+#include "engine/RenderQueue.h"
+#include "engine/SceneManager.h"
+#include "engine/AssetLoader.h"
 
 namespace MathGates
 {
-	void Run();
-
 	class Gate
 	{
 	public:
@@ -23,7 +31,7 @@ namespace MathGates
 		Gate(int val, Operator op, Onyx::Math::Vec3 color);
 
 		void translate(const Onyx::Math::Vec3& translation);
-		void addToRenderer(Onyx::Renderer& renderer);
+		void addToRenderQueue(Onyx::RenderQueue& renderQueue);
 
 		bool collision(const Onyx::Math::Vec3& camPos);
 
@@ -39,21 +47,22 @@ namespace MathGates
 
 		void refresh();
 
+		void dispose();
+
 	private:
 		std::string m_text;
 		int m_val;
 		Operator m_op;
 		Onyx::Math::Vec3 m_color;
 
-		Onyx::TextRenderable3D m_textRenderable;
+		Onyx::AtlasText3D m_textRenderable;
 		Onyx::Renderable m_leftPost;
 		Onyx::Renderable m_rightPost;
 		Onyx::Renderable m_screen;
 
 		bool m_collided;
 
-		static bool sm_fontCreated;
-		static Onyx::Font sm_font;
+		Onyx::AtlasFont m_font;
 
 	};
 
@@ -62,4 +71,40 @@ namespace MathGates
 	public:
 
 	};
+
+	class Game : public Onyx::Scene
+	{
+	public:
+		Game();
+
+		void load(Onyx::SceneManager& manager) override;
+		bool finishLoad() override;
+		void update(double dt) override;
+		void render(double alpha) override;
+		void unload() override;
+		const Onyx::RenderQueue* getRenderQueue() const override;
+
+	private:
+		Onyx::SceneManager* m_pManager;
+		Onyx::InputHandler m_input;
+		Onyx::Camera m_cam;
+		Onyx::Lighting m_lighting;
+		Onyx::Fog m_fog;
+		Onyx::RenderQueue m_renderQueue;
+
+		Onyx::Renderable m_floor;
+		Onyx::RenderHandle m_floorHandle;
+
+		// loaded through the FontCache, the gate font is held here only so the gates find it already loaded
+		Onyx::AssetHandle<Onyx::AtlasFont> m_poppinsHandle, m_poppinsBoldHandle, m_gateFontHandle;
+		Onyx::AtlasFont m_poppins, m_poppinsBold;
+		Onyx::AtlasText m_scoreText, m_finalScoreText;
+		Onyx::RenderHandle m_scoreTextHandle;
+
+		// gates are never moved once created, the render queue points into them
+		std::list<Gate> m_gates;
+
+		long long m_score;
+		bool m_running;
+	};
 }
@@ -2,8 +2,6 @@
 
 #include "SpikeDodge.h"
 
-#include "Launcher.h"
-
 #include <Onyx/Core.h>
 #include <Onyx/Window.h>
 #include <Onyx/InputHandler.h>
@@ -13,256 +11,284 @@
 
 using Onyx::Math::Vec2, Onyx::Math::Vec3, Onyx::Math::Vec4, Onyx::Math::IVec2;
 
-bool collision(const Onyx::ModelRenderable& player, const Onyx::ModelRenderable& spike);
+bool collision(const Onyx::CookedModel& player, const Onyx::CookedModel& spike);
+
+const double CAM_SPEED = 6.0f;
+const double CAM_SENS = 50.0f;
+
+const float PLAYER_STRAFE_LIMIT = 4.25f;
+
+const bool CAM_MOVEMENT = false;
+
+const float DEAD_ZONE_LEFT = 0.1f;
+const float DEAD_ZONE_RIGHT = 0.1f;
 
-void SpikeDodge::Run()
+SpikeDodge::Game::Game()
 {
-	Onyx::Init();
+	m_pManager = nullptr;
+	m_playerSpeed = m_spikeSpeed = 0.0f;
+	m_score = m_highScore = 0.0f;
+	m_dead = false;
+}
+
+void SpikeDodge::Game::load(Onyx::SceneManager& manager)
+{
+	m_pManager = &manager;
+	Onyx::Window& window = manager.getWindow();
 
-	Onyx::Window window(
+	Onyx::Monitor monitor = Onyx::Monitor::GetPrimary();
+	manager.configureWindow(
 		Onyx::WindowProperties{
 			.title = "Spike Dodge",
 			.width = 1280,
 			.height = 720,
-			.position = IVec2(2560 / 2 - 1280 / 2, 1440 / 2 - 720 / 2),
-			.nSamplesMSAA = 4
+			.position = IVec2(monitor.getDimensions().getX() / 2 - 1280 / 2, monitor.getDimensions().getY() / 2 - 720 / 2),
+			.backgroundColor = Vec3::LightBlue()
 		}
 	);
 
-	window.init();
-	window.setBackgroundColor(Vec3::LightBlue());
-	Onyx::Monitor monitor = Onyx::Monitor::GetPrimary();
-	window.setPosition(IVec2(monitor.getDimensions().getX() / 2 - window.getWidth() / 2, monitor.getDimensions().getY() / 2 - window.getHeight() / 2));
+	window.linkInputHandler(m_input);
 
-	Onyx::WindowIcon icon = Onyx::WindowIcon::Load({
-		Onyx::Resources("icons/icon-16x.png"),
-		Onyx::Resources("icons/icon-24x.png"),
-		Onyx::Resources("icons/icon-32x.png"),
-		Onyx::Resources("icons/icon-48x.png"),
-		Onyx::Resources("icons/icon-256x.png")
-	});
-	window.setIcon(icon);
-	icon.dispose();
+	m_cam = Onyx::Camera(Onyx::Projection::Perspective(60.0f, 1280, 720));
+	window.linkCamera(m_cam);
+	m_cam.translateFB(-5.0f);
+	m_cam.translateUD(3.0f);
+	m_cam.pitch(-15.0f);
 
-	Onyx::InputHandler input;
-	window.linkInputHandler(input);
+	m_lighting = Onyx::Lighting(Vec3::White(), 0.3f, Vec3(0.2f, -1.0f, -0.3f));
+	m_fog = Onyx::Fog(Vec3::LightBlue(), 40.0f, 90.0f);
 
-	Onyx::Camera cam(Onyx::Projection::Perspective(60.0f, 1280, 720));
-	window.linkCamera(cam);
-	cam.translateFB(-5.0f);
-	cam.translateUD(3.0f);
-	cam.pitch(-15.0f);
+	m_renderQueue = Onyx::RenderQueue(window, m_cam, m_lighting, m_fog);
 
-	Onyx::Lighting lighting(Vec3::White(), 0.3f, Vec3(0.2f, -1.0f, -0.3f));
-	Onyx::Fog fog(Vec3::LightBlue(), 40.0f, 90.0f);
+	// cooked to .omesh next to the .obj on first load
+	m_playerModel = Onyx::AssetLoader::LoadModel(Onyx::Resources("models/capsule.obj"), m_assets);
+	m_spikeModel = Onyx::AssetLoader::LoadModel(Onyx::Resources("models/spike.obj"), m_assets);
+	m_fontRegHandle = Onyx::AssetLoader::LoadFont(Onyx::Resources("fonts/Poppins/Poppins-Regular.ttf"), 48, true, m_assets);
+	m_fontBoldHandle = Onyx::AssetLoader::LoadFont(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 48, true, m_assets);
 
-	Onyx::Renderer renderer(cam, lighting, fog);
-	window.linkRenderer(renderer);
+	m_floor = Onyx::Renderable::ColoredQuad(10.0f, 1000.0f, Vec4::White());
+	m_floor.rotate(Vec3(90.0f, 0.0f, 0.0f));
+	m_floor.translate(Vec3(0.0f, -0.001f, -40.0f));
 
-	Onyx::Model playerModel = Onyx::Model::LoadOBJ(Onyx::Resources("models/capsule.obj"));
-	Onyx::Model spikeModel = Onyx::Model::LoadOBJ(Onyx::Resources("models/spike.obj"));
+	m_playerSpeed = 5.0f;
+	m_spikeSpeed = 10.0f;
 
-	Onyx::Renderable floor = Onyx::Renderable::ColoredQuad(10.0f, 1000.0f, Vec4::White());
-	floor.rotate(Vec3(90.0f, 0.0f, 0.0f));
-	floor.translate(Vec3(0.0f, -0.001f, -40.0f));
+	m_score = 0.0f;
+	if (Onyx::FileUtils::FileExists("data.txt"))
+	{
+		std::vector<std::string> data = Onyx::FileUtils::ReadLines("data.txt");
+		m_highScore = std::stof(data[0]);
+	}
+	else m_highScore = 0.0f;
 
-	Onyx::ModelRenderable player(playerModel);
-	player.translate(Vec3(0.0f, 0.2f, -0.0f));
-	player.scale(0.5f);
+	m_input.setCursorLock(true);
+
+	m_dead = false;
+}
+
+bool SpikeDodge::Game::finishLoad()
+{
+	for (Onyx::AssetState state : { m_playerModel.getState(), m_spikeModel.getState(), m_fontRegHandle.getState(), m_fontBoldHandle.getState() })
+	{
+		if (state == Onyx::AssetState::Pending) return false;
+		if (state == Onyx::AssetState::Failed)
+		{
+			m_pManager->pop();
+			return false;
+		}
+	}
+
+	m_player = m_playerModel.get();
+	const Onyx::CookedModel& spikeModel = m_spikeModel.get();
+
+	m_player.translate(Vec3(0.0f, 0.2f, -0.0f));
+	m_player.scale(0.5f);
 
 
 	srand(time(nullptr));
 
-	std::vector<Onyx::ModelRenderable> spikes;
+	m_spikes.clear();
 	for (int i = 0; i < 20; i++)
-    {
-        Onyx::ModelRenderable spike = Onyx::ModelRenderable(spikeModel);
-        spike.translate(Vec3((rand() % 900) / 100.0f - 4.5f, 0.0f, -20.0f - i * 5.0f));
+	{
+		Onyx::CookedModel spike = spikeModel;
+		spike.translate(Vec3((rand() % 900) / 100.0f - 4.5f, 0.0f, -20.0f - i * 5.0f));
 		spike.scale(0.5f);
 		spike.rotate(Vec3(0, rand() % 360, 0));
-        spikes.push_back(spike);
-    }
-
-	Onyx::Font fontReg = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Regular.ttf"), 96);
-	Onyx::Font fontBold = Onyx::Font::Load(Onyx::Resources("fonts/Poppins/Poppins-Bold.ttf"), 96);
-	Onyx::TextRenderable scoreText("0", fontReg, Vec3(0.2f));
-	scoreText.setScale(0.5f);
-	scoreText.setPosition(Vec2(20, 720 - 60));
-
-	Onyx::TextRenderable highScoreText("High Score: 0", fontReg, Vec4(Vec3(0.2f), 0.5f));
-	highScoreText.setScale(0.3f);
-	highScoreText.setPosition(Vec2(20, 720 - 20 - highScoreText.getHeight()));
-
-	Onyx::TextRenderable gameOverText("GAME OVER", fontBold, Vec4::Red());
-	Onyx::TextRenderable gameOverSubText("[R] to restart, [ESC] to exit", fontReg, Vec4::Red());
-	gameOverText.setScale(0.6f);
-	gameOverSubText.setScale(0.3f);
-	gameOverText.hide();
-	gameOverSubText.hide();
-
-	renderer.add(floor);
-	renderer.add(player);
-	for (auto& spike : spikes) renderer.add(spike);
-	renderer.add(scoreText);
-	renderer.add(highScoreText);
-	renderer.add(gameOverText);
-	renderer.add(gameOverSubText);
-
-	const double CAM_SPEED = 6.0f;
-	const double CAM_SENS = 50.0f;
-
-	float spawnInterval = 1.0f;
-
-	float playerSpeed = 5.0f;
-	const float PLAYER_STRAFE_LIMIT = 4.25f;
-
-	float spikeSpeed = 10.0f;
-
-	const bool CAM_MOVEMENT = false; 
-	
-	const float DEAD_ZONE_LEFT = 0.1f;
-	const float DEAD_ZONE_RIGHT = 0.1f;
-
-	float score = 0.0f;
-	float highScore;
-	if (Onyx::FileUtils::FileExists("data.txt"))
+		m_spikes.push_back(spike);
+	}
+
+	m_fontReg = m_fontRegHandle.get();
+	m_fontBold = m_fontBoldHandle.get();
+	m_scoreText = Onyx::AtlasText("0", m_fontReg, Vec4(Vec3(0.2f), 1.0f));
+	m_scoreText.setScale(1.0f);
+	m_scoreText.setPosition(Vec2(20, 720 - 60));
+
+	m_highScoreText = Onyx::AtlasText("High Score: 0", m_fontReg, Vec4(Vec3(0.2f), 0.5f));
+	m_highScoreText.setScale(0.6f);
+	m_highScoreText.setPosition(Vec2(20, 720 - 20 - m_highScoreText.getHeight()));
+
+	m_gameOverText = Onyx::AtlasText("GAME OVER", m_fontBold, Vec4::Red());
+	m_gameOverSubText = Onyx::AtlasText("[R] to restart, [ESC] to exit", m_fontReg, Vec4::Red());
+	m_gameOverText.setScale(1.2f);
+	m_gameOverSubText.setScale(0.6f);
+	m_gameOverText.hide();
+	m_gameOverSubText.hide();
+
+	// spikes past the end of the fog or behind the camera are culled by the render queue
+	m_renderQueue.add(m_floor);
+	for (auto& part : m_player.getParts()) m_renderQueue.add(part.renderable, part.color, part.bounds);
+	for (auto& spike : m_spikes)
 	{
-		std::vector<std::string> data = Onyx::FileUtils::ReadLines("data.txt");
-		highScore = std::stof(data[0]);
+		for (auto& part : spike.getParts()) m_renderQueue.add(part.renderable, part.color, part.bounds);
 	}
-	else highScore = 0.0f;
+	m_renderQueue.add(m_scoreText);
+	m_renderQueue.add(m_highScoreText);
+	m_renderQueue.add(m_gameOverText);
+	m_renderQueue.add(m_gameOverSubText);
 
-	input.setCursorLock(true);
+	return true;
+}
 
-	bool dead = false;
+void SpikeDodge::Game::update(double dt)
+{
+	Onyx::Window& window = m_pManager->getWindow();
 
-	bool restart = false;
-	while (window.isOpen())
-	{
-		double dt = window.getDeltaTime();
-		float lsx = 0.0f, lsy = 0.0f, rsx = 0.0f, rsy = 0.0f;
-		bool a = false, b = false, x = false, y = false, rs = false;
+	float lsx = 0.0f, lsy = 0.0f, rsx = 0.0f, rsy = 0.0f;
+	bool a = false, b = false, x = false, y = false, rs = false;
 
-		input.update();
+	m_input.update();
 
-		if (CAM_MOVEMENT)
-		{
-			if (input.isKeyDown(Onyx::Key::W)) cam.translateFB(CAM_SPEED * dt);
-			if (input.isKeyDown(Onyx::Key::A)) cam.translateLR(-CAM_SPEED * dt);
-			if (input.isKeyDown(Onyx::Key::S)) cam.translateFB(-CAM_SPEED * dt);
-			if (input.isKeyDown(Onyx::Key::D)) cam.translateLR(CAM_SPEED * dt);
-			if (input.isKeyDown(Onyx::Key::Space)) cam.translateUD(CAM_SPEED * dt);
-			if (input.isKeyDown(Onyx::Key::C)) cam.translateUD(-CAM_SPEED * dt);
-
-			cam.rotate(input.getMouseDeltas().getX() / 200.0f * CAM_SENS, input.getMouseDeltas().getY() / 200.0f * CAM_SENS);
+	if (CAM_MOVEMENT)
+	{
+		if (m_input.isKeyDown(Onyx::Key::W)) m_cam.translateFB(CAM_SPEED * dt);
+		if (m_input.isKeyDown(Onyx::Key::A)) m_cam.translateLR(-CAM_SPEED * dt);
+		if (m_input.isKeyDown(Onyx::Key::S)) m_cam.translateFB(-CAM_SPEED * dt);
+		if (m_input.isKeyDown(Onyx::Key::D)) m_cam.translateLR(CAM_SPEED * dt);
+		if (m_input.isKeyDown(Onyx::Key::Space)) m_cam.translateUD(CAM_SPEED * dt);
+		if (m_input.isKeyDown(Onyx::Key::C)) m_cam.translateUD(-CAM_SPEED * dt);
+
+		m_cam.rotate(m_input.getMouseDeltas().getX() / 200.0f * CAM_SENS, m_input.getMouseDeltas().getY() / 200.0f * CAM_SENS);
+	}
+	else if (!m_dead)
+	{
+		if (m_input.isKeyDown(Onyx::Key::A) || m_input.isKeyDown(Onyx::Key::ArrowLeft)) {
+			m_player.translate(Vec3(-m_playerSpeed * dt, 0.0f, 0.0f));
 		}
-		else if (!dead)
+		if (m_input.isKeyDown(Onyx::Key::D) || m_input.isKeyDown(Onyx::Key::ArrowRight)) {
+			m_player.translate(Vec3(m_playerSpeed * dt, 0.0f, 0.0f));
+		}
+
+		for (const Onyx::Gamepad& gp : m_input.getGamepads())
 		{
-			if (input.isKeyDown(Onyx::Key::A) || input.isKeyDown(Onyx::Key::ArrowLeft)) {
-				player.translate(Vec3(-playerSpeed * dt, 0.0f, 0.0f));
-			}
-			if (input.isKeyDown(Onyx::Key::D) || input.isKeyDown(Onyx::Key::ArrowRight)) {
-				player.translate(Vec3(playerSpeed * dt, 0.0f, 0.0f));
-			}
+			if (abs(gp.getAxis(Onyx::GamepadAxis::LeftX)) > lsx) lsx = gp.getAxis(Onyx::GamepadAxis::LeftX);
+			if (abs(gp.getAxis(Onyx::GamepadAxis::LeftY)) > lsy) lsy = gp.getAxis(Onyx::GamepadAxis::LeftY);
+			if (abs(gp.getAxis(Onyx::GamepadAxis::RightX)) > rsx) rsx = gp.getAxis(Onyx::GamepadAxis::RightX);
+			if (abs(gp.getAxis(Onyx::GamepadAxis::RightY)) > rsy) rsy = gp.getAxis(Onyx::GamepadAxis::RightY);
+			if (gp.isButtonDown(Onyx::GamepadButton::A)) a = true;
+			if (gp.isButtonDown(Onyx::GamepadButton::B)) b = true;
+			if (gp.isButtonDown(Onyx::GamepadButton::X)) x = true;
+			if (gp.isButtonDown(Onyx::GamepadButton::Y)) y = true;
+			if (gp.isButtonDown(Onyx::GamepadButton::RightStick)) rs = true;
+		}
 
-			for (const Onyx::Gamepad& gp : input.getGamepads())
-			{
-				if (abs(gp.getAxis(Onyx::GamepadAxis::LeftX)) > lsx) lsx = gp.getAxis(Onyx::GamepadAxis::LeftX);
-				if (abs(gp.getAxis(Onyx::GamepadAxis::LeftY)) > lsy) lsy = gp.getAxis(Onyx::GamepadAxis::LeftY);
-				if (abs(gp.getAxis(Onyx::GamepadAxis::RightX)) > rsx) rsx = gp.getAxis(Onyx::GamepadAxis::RightX);
-				if (abs(gp.getAxis(Onyx::GamepadAxis::RightY)) > rsy) rsy = gp.getAxis(Onyx::GamepadAxis::RightY);
-				if (gp.isButtonDown(Onyx::GamepadButton::A)) a = true;
-				if (gp.isButtonDown(Onyx::GamepadButton::B)) b = true;
-				if (gp.isButtonDown(Onyx::GamepadButton::X)) x = true;
-				if (gp.isButtonDown(Onyx::GamepadButton::Y)) y = true;
-				if (gp.isButtonDown(Onyx::GamepadButton::RightStick)) rs = true;
-			}
+		lsx = abs(lsx) < DEAD_ZONE_LEFT ? 0.0f : lsx;
+		lsy = abs(lsy) < DEAD_ZONE_LEFT ? 0.0f : lsy;
+		rsx = abs(rsx) < DEAD_ZONE_RIGHT ? 0.0f : rsx;
+		rsy = abs(rsy) < DEAD_ZONE_RIGHT ? 0.0f : rsy;
 
-			lsx = abs(lsx) < DEAD_ZONE_LEFT ? 0.0f : lsx;
-			lsy = abs(lsy) < DEAD_ZONE_LEFT ? 0.0f : lsy;
-			rsx = abs(rsx) < DEAD_ZONE_RIGHT ? 0.0f : rsx;
-			rsy = abs(rsy) < DEAD_ZONE_RIGHT ? 0.0f : rsy;
+		m_player.translate(Vec3(lsx * m_playerSpeed * dt, 0.0f, 0.0f));
 
-			player.translate(Vec3(lsx * playerSpeed * dt, 0.0f, 0.0f));
+		if (m_player.getPosition().getX() < -PLAYER_STRAFE_LIMIT) m_player.setPosition(Vec3(-PLAYER_STRAFE_LIMIT, m_player.getPosition().getY(), m_player.getPosition().getZ()));
+		else if (m_player.getPosition().getX() > PLAYER_STRAFE_LIMIT) m_player.setPosition(Vec3(PLAYER_STRAFE_LIMIT, m_player.getPosition().getY(), m_player.getPosition().getZ()));
+	}
+	else if (m_input.isKeyDown(Onyx::Key::R))
+	{
+		// a fresh game in place of this one, the stack doesn't grow however many times it restarts
+		m_pManager->replace(std::make_unique<Game>());
+		return;
+	}
+	m_cam.update();
 
-			if (player.getPosition().getX() < -PLAYER_STRAFE_LIMIT) player.setPosition(Vec3(-PLAYER_STRAFE_LIMIT, player.getPosition().getY(), player.getPosition().getZ()));
-			else if (player.getPosition().getX() > PLAYER_STRAFE_LIMIT) player.setPosition(Vec3(PLAYER_STRAFE_LIMIT, player.getPosition().getY(), player.getPosition().getZ()));
+	if (m_input.isKeyTapped(Onyx::Key::Escape))
+	{
+		m_pManager->pop();
+		return;
+	}
+	if (m_input.isKeyTapped(Onyx::Key::F12))
+	{
+		Onyx::Monitor monitor = Onyx::Monitor::GetPrimary();
+		window.toggleFullscreen(1280, 720, IVec2(monitor.getDimensions().getX() / 2 - 1280 / 2, monitor.getDimensions().getY() / 2 - 720 / 2));
+		if (window.isFullscreen())
+		{
+			m_scoreText.setScale(window.getBufferWidth() / 1280.0f * 1.0f);
+			m_highScoreText.setScale(window.getBufferWidth() / 1280.0f * 0.6f);
 		}
-		else if (input.isKeyDown(Onyx::Key::R))
+		else
 		{
-			restart = true;
-			window.close();
+			m_scoreText.setScale(1.0f);
+			m_highScoreText.setScale(0.6f);
 		}
-		cam.update();
+	}
+	if (m_input.isKeyTapped(Onyx::Key::F1)) Onyx::Renderer::ToggleWireframe();
 
-		if (input.isKeyTapped(Onyx::Key::Escape)) window.close();
-		if (input.isKeyTapped(Onyx::Key::F12))
+	if (!m_dead)
+	{
+		for (auto& spike : m_spikes)
 		{
-			window.toggleFullscreen(1280, 720, IVec2(monitor.getDimensions().getX() / 2 - 1280 / 2, monitor.getDimensions().getY() / 2 - 720 / 2));
-			if (window.isFullscreen())
-			{
-				scoreText.setScale(window.getBufferWidth() / 1280.0f * 0.5f);
-				highScoreText.setScale(window.getBufferWidth() / 1280.0f * 0.3f);
-			}
-			else
+			spike.translate(Vec3(0.0f, 0.0f, m_spikeSpeed * dt));
+			if (spike.getPosition().getZ() > 10.0f)
 			{
-				scoreText.setScale(0.5f);
-				highScoreText.setScale(0.3f);
+				spike.setPosition(Vec3((rand() % 900) / 100.0f - 4.5f, 0.0f, -90.0f));
 			}
-		}
-		if (input.isKeyTapped(Onyx::Key::F1)) renderer.ToggleWireframe();
 
-		if (!dead)
-		{
-			for (auto& spike : spikes)
+			if (collision(m_player, spike))
 			{
-				spike.translate(Vec3(0.0f, 0.0f, spikeSpeed * dt));
-				if (spike.getPosition().getZ() > 10.0f)
-				{
-					spike.setPosition(Vec3((rand() % 900) / 100.0f - 4.5f, 0.0f, -90.0f));
-				}
-
-				if (collision(player, spike))
-				{
-					dead = true;
-					gameOverText.show();
-					gameOverSubText.show();
-				}
+				m_dead = true;
+				m_gameOverText.show();
+				m_gameOverSubText.show();
 			}
-
-			score += dt * 20.0f;
-			if (score > highScore) highScore = score;
 		}
 
-		scoreText.setText(std::to_string((int)score));
-		scoreText.setPosition(Vec2(window.getBufferWidth() / 2 - scoreText.getWidth() / 2, window.getBufferHeight() - 100.0f - scoreText.getHeight()));
-
-		highScoreText.setText("High Score: " + std::to_string((int)highScore));
-		highScoreText.setPosition(Vec2(20.0f, window.getBufferHeight() - 20.0f - highScoreText.getHeight()));
+		m_score += dt * 20.0f;
+		if (m_score > m_highScore) m_highScore = m_score;
+	}
 
-		gameOverText.setPosition(Vec2(window.getBufferWidth() / 2 - gameOverText.getWidth() / 2, window.getBufferHeight() / 2 - gameOverText.getHeight() / 2));
-		gameOverSubText.setPosition(Vec2(window.getBufferWidth() / 2 - gameOverSubText.getWidth() / 2, gameOverText.getPosition().getY() - 50.0f));
+	m_scoreText.setText(std::to_string((int)m_score));
+	m_scoreText.setPosition(Vec2(window.getBufferWidth() / 2 - m_scoreText.getWidth() / 2, window.getBufferHeight() - 100.0f - m_scoreText.getHeight()));
 
-		spikeSpeed += dt * 0.1f;
-		playerSpeed += dt * 0.05f;
+	m_highScoreText.setText("High Score: " + std::to_string((int)m_highScore));
+	m_highScoreText.setPosition(Vec2(20.0f, window.getBufferHeight() - 20.0f - m_highScoreText.getHeight()));
 
-		window.startRender();
-		renderer.render();
-		window.endRender();
-	}
+	m_gameOverText.setPosition(Vec2(window.getBufferWidth() / 2 - m_gameOverText.getWidth() / 2, window.getBufferHeight() / 2 - m_gameOverText.getHeight() / 2));
+	m_gameOverSubText.setPosition(Vec2(window.getBufferWidth() / 2 - m_gameOverSubText.getWidth() / 2, m_gameOverText.getPosition().getY() - 50.0f));
 
-	window.dispose();
-	renderer.dispose();
+	m_spikeSpeed += dt * 0.1f;
+	m_playerSpeed += dt * 0.05f;
+}
 
-	Onyx::FileUtils::Write("data.txt", std::to_string(highScore), false);
+void SpikeDodge::Game::render(double alpha)
+{
+	m_renderQueue.render();
+}
 
-	Onyx::Terminate();
-	if (restart) Run();
+void SpikeDodge::Game::unload()
+{
+	// the cooked meshes stay cached for the next time the game is played
+	Onyx::AssetLoader::Cancel(m_assets);
+	m_renderQueue.dispose();
+	if (m_fontRegHandle.isLoaded()) m_fontRegHandle.get().dispose();
+	if (m_fontBoldHandle.isLoaded()) m_fontBoldHandle.get().dispose();
+	m_input.setCursorLock(false);
+
+	Onyx::FileUtils::Write("data.txt", std::to_string(m_highScore), false);
+}
 
-	Launcher::GameHub::Launch();
+const Onyx::RenderQueue* SpikeDodge::Game::getRenderQueue() const
+{
+	return &m_renderQueue;
 }
 
-bool collision(const Onyx::ModelRenderable& player, const Onyx::ModelRenderable& spike)
+bool collision(const Onyx::CookedModel& player, const Onyx::CookedModel& spike)
 {
 	float dist = (player.getPosition() - spike.getPosition()).magnitude();
 	return dist < (1.0f * player.getScale().getX() + 0.8f * spike.getScale().getX());
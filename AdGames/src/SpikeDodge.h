@@ -1,6 +1,53 @@
 #pragma once
 
+#include <vector>
+
+#include <Onyx/InputHandler.h>
+#include <Onyx/Camera.h>
+#include <Onyx/Lighting.h>
+#include <Onyx/Fog.h>
+
+#include "engine/SceneManager.h"
+#include "engine/RenderQueue.h"
+#include "engine/CookedModel.h"
+#include "engine/AssetLoader.h"
+
 namespace SpikeDodge
 {
-    void Run();
+	class Game : public Onyx::Scene
+	{
+	public:
+		Game();
+
+		void load(Onyx::SceneManager& manager) override;
+		bool finishLoad() override;
+		void update(double dt) override;
+		void render(double alpha) override;
+		void unload() override;
+		const Onyx::RenderQueue* getRenderQueue() const override;
+
+	private:
+		Onyx::SceneManager* m_pManager;
+		Onyx::InputHandler m_input;
+		Onyx::Camera m_cam;
+		Onyx::Lighting m_lighting;
+		Onyx::Fog m_fog;
+		Onyx::RenderQueue m_renderQueue;
+
+		// every asset the game loads belongs to the group, so leaving while they load cancels only them
+		Onyx::AssetGroup m_assets;
+		Onyx::AssetHandle<Onyx::CookedModel> m_playerModel, m_spikeModel;
+		Onyx::AssetHandle<Onyx::AtlasFont> m_fontRegHandle, m_fontBoldHandle;
+
+		Onyx::Renderable m_floor;
+		Onyx::CookedModel m_player;
+		std::vector<Onyx::CookedModel> m_spikes;
+
+		Onyx::AtlasFont m_fontReg, m_fontBold;
+		Onyx::AtlasText m_scoreText, m_highScoreText, m_gameOverText, m_gameOverSubText;
+
+		float m_playerSpeed, m_spikeSpeed;
+		float m_score, m_highScore;
+		bool m_dead;
+	};
 }
@@ -0,0 +1,319 @@
+#include "AssetLoader.h"
+
+#include <chrono>
+
+std::vector<std::thread> Onyx::AssetLoader::sm_workers;
+std::deque<Onyx::AssetLoader::Job> Onyx::AssetLoader::sm_jobs;
+std::deque<Onyx::AssetLoader::Job> Onyx::AssetLoader::sm_uploads;
+std::mutex Onyx::AssetLoader::sm_jobMutex;
+std::mutex Onyx::AssetLoader::sm_uploadMutex;
+std::condition_variable Onyx::AssetLoader::sm_jobAvailable;
+std::condition_variable Onyx::AssetLoader::sm_uploadAvailable;
+std::atomic<uint> Onyx::AssetLoader::sm_pending = 0;
+uint Onyx::AssetLoader::sm_generation = 0;
+bool Onyx::AssetLoader::sm_stopping = false;
+
+Onyx::AssetGroup::AssetGroup()
+	: m_cancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+bool Onyx::AssetGroup::isCancelled() const
+{
+	return *m_cancelled;
+}
+
+// loading is mostly waiting on the disk and decoding a handful of files, more workers than this wouldn't finish any sooner
+const uint MAX_WORKERS = 4;
+
+Onyx::AssetHandle<Onyx::Image> Onyx::AssetLoader::DecodeImage(const std::string& filepath, bool flipVertically, const AssetGroup& group)
+{
+	AssetHandle<Image> handle;
+	auto state = std::make_shared<AssetHandle<Image>::State>();
+	handle.m_state = state;
+
+	Submit(Job{
+		[state, filepath, flipVertically]()
+		{
+			bool loaded = false;
+			state->asset = Image::Load(filepath, flipVertically, &loaded);
+			return loaded;
+		},
+		nullptr,
+		[state](bool loaded) { state->state.store(loaded ? AssetState::Loaded : AssetState::Failed, std::memory_order_release); }
+	}, group);
+
+	return handle;
+}
+
+Onyx::AssetHandle<Onyx::Texture2D> Onyx::AssetLoader::LoadTexture(const std::string& filepath, TextureWrap textureWrap, TextureFilter minFilter, TextureFilter magFilter, const AssetGroup& group)
+{
+	AssetHandle<Texture2D> handle;
+	auto state = std::make_shared<AssetHandle<Texture2D>::State>();
+	handle.m_state = state;
+
+	auto image = std::make_shared<Image>();
+
+	Submit(Job{
+		[image, filepath]()
+		{
+			bool loaded = false;
+			// flipped, so the first row is the bottom of the texture like with Onyx's Texture
+			*image = Image::Load(filepath, true, &loaded);
+			return loaded;
+		},
+		[state, image, textureWrap, minFilter, magFilter]()
+		{
+			state->asset = Texture2D::Create(*image, textureWrap, minFilter, magFilter);
+			*image = Image();
+			return true;
+		},
+		[state](bool loaded) { state->state.store(loaded ? AssetState::Loaded : AssetState::Failed, std::memory_order_release); }
+	}, group);
+
+	return handle;
+}
+
+Onyx::AssetHandle<Onyx::Texture2D> Onyx::AssetLoader::UploadTexture(const AssetHandle<Image>& image, TextureWrap textureWrap, TextureFilter minFilter, TextureFilter magFilter, const AssetGroup& group)
+{
+	AssetHandle<Texture2D> handle;
+	auto state = std::make_shared<AssetHandle<Texture2D>::State>();
+	handle.m_state = state;
+
+	Submit(Job{
+		[image]()
+		{
+			// the image's own job was queued first, so it is already running or done and this never waits long
+			image.wait();
+			return image.isLoaded();
+		},
+		[state, image, textureWrap, minFilter, magFilter]()
+		{
+			state->asset = Texture2D::Create(image.get(), textureWrap, minFilter, magFilter);
+			return true;
+		},
+		[state](bool loaded) { state->state.store(loaded ? AssetState::Loaded : AssetState::Failed, std::memory_order_release); }
+	}, group);
+
+	return handle;
+}
+
+Onyx::AssetHandle<Onyx::AtlasFont> Onyx::AssetLoader::LoadFont(const std::string& ttfFilePath, uint size, bool sdf, const AssetGroup& group)
+{
+	AssetHandle<AtlasFont> handle;
+	auto state = std::make_shared<AssetHandle<AtlasFont>::State>();
+	handle.m_state = state;
+
+	auto atlas = std::make_shared<std::vector<ubyte>>();
+
+	Submit(Job{
+		[state, atlas, ttfFilePath, size, sdf]()
+		{
+			return AtlasFont::Rasterize(ttfFilePath, size, sdf, state->asset, *atlas);
+		},
+		[state, atlas]()
+		{
+			state->asset.upload(*atlas);
+			atlas->clear();
+			atlas->shrink_to_fit();
+			return true;
+		},
+		[state](bool loaded) { state->state.store(loaded ? AssetState::Loaded : AssetState::Failed, std::memory_order_release); }
+	}, group);
+
+	return handle;
+}
+
+Onyx::AssetHandle<Onyx::CookedModel> Onyx::AssetLoader::LoadModel(const std::string& objPath, const AssetGroup& group)
+{
+	if (CookedModel::IsLoaded(objPath)) return AssetHandle<CookedModel>(CookedModel::Load(objPath));
+
+	AssetHandle<CookedModel> handle;
+	auto state = std::make_shared<AssetHandle<CookedModel>::State>();
+	handle.m_state = state;
+
+	auto file = std::make_shared<MeshFile>();
+
+	Submit(Job{
+		[file, objPath]()
+		{
+			return CookedModel::Open(objPath, *file, true);
+		},
+		[state, file, objPath]()
+		{
+			return CookedModel::Upload(objPath, *file, state->asset);
+		},
+		[state, file](bool loaded)
+		{
+			// a cancelled load still has its file mapped
+			file->dispose();
+			state->state.store(loaded ? AssetState::Loaded : AssetState::Failed, std::memory_order_release);
+		}
+	}, group);
+
+	return handle;
+}
+
+void Onyx::AssetLoader::Update(double budgetMs)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	while (true)
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(sm_uploadMutex);
+			if (sm_uploads.empty()) return;
+			job = std::move(sm_uploads.front());
+			sm_uploads.pop_front();
+		}
+
+		Complete(job, job.upload());
+
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		if (elapsed.count() >= budgetMs) return;
+	}
+}
+
+void Onyx::AssetLoader::Finish()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(sm_uploadMutex);
+			sm_uploadAvailable.wait(lock, []() { return !sm_uploads.empty() || sm_pending == 0; });
+			if (sm_uploads.empty()) return;
+		}
+
+		Update(1e9);
+	}
+}
+
+void Onyx::AssetLoader::Cancel(const AssetGroup& group)
+{
+	std::lock_guard<std::mutex> jobLock(sm_jobMutex);
+	std::lock_guard<std::mutex> uploadLock(sm_uploadMutex);
+
+	// set under both locks, so a worker finishing one of the group's jobs right now sees it before queuing the upload
+	*group.m_cancelled = true;
+
+	for (std::deque<Job>* pQueue : { &sm_jobs, &sm_uploads })
+	{
+		for (auto it = pQueue->begin(); it != pQueue->end();)
+		{
+			if (it->cancelled != group.m_cancelled)
+			{
+				++it;
+				continue;
+			}
+
+			Complete(*it, false);
+			it = pQueue->erase(it);
+		}
+	}
+}
+
+void Onyx::AssetLoader::Cancel()
+{
+	std::lock_guard<std::mutex> jobLock(sm_jobMutex);
+	std::lock_guard<std::mutex> uploadLock(sm_uploadMutex);
+
+	for (Job& job : sm_jobs) Complete(job, false);
+	for (Job& job : sm_uploads) Complete(job, false);
+	sm_jobs.clear();
+	sm_uploads.clear();
+
+	// jobs that are running right now see the new generation when they finish, and fail instead of queuing their upload
+	sm_generation++;
+}
+
+void Onyx::AssetLoader::Shutdown()
+{
+	Cancel();
+
+	{
+		std::lock_guard<std::mutex> lock(sm_jobMutex);
+		sm_stopping = true;
+	}
+	sm_jobAvailable.notify_all();
+
+	for (std::thread& worker : sm_workers) worker.join();
+	sm_workers.clear();
+
+	sm_stopping = false;
+}
+
+uint Onyx::AssetLoader::GetPendingCount()
+{
+	return sm_pending;
+}
+
+uint Onyx::AssetLoader::GetThreadCount()
+{
+	return sm_workers.size();
+}
+
+void Onyx::AssetLoader::Submit(Job job, const AssetGroup& group)
+{
+	if (group.isCancelled())
+	{
+		job.complete(false);
+		return;
+	}
+
+	Start();
+
+	sm_pending++;
+	{
+		std::lock_guard<std::mutex> lock(sm_jobMutex);
+		job.generation = sm_generation;
+		job.cancelled = group.m_cancelled;
+		sm_jobs.push_back(std::move(job));
+	}
+	sm_jobAvailable.notify_one();
+}
+
+void Onyx::AssetLoader::Start()
+{
+	if (!sm_workers.empty()) return;
+
+	// one core is left for the main thread
+	uint nThreads = std::thread::hardware_concurrency();
+	nThreads = nThreads > 2 ? nThreads - 1 : 1;
+	if (nThreads > MAX_WORKERS) nThreads = MAX_WORKERS;
+
+	for (uint i = 0; i < nThreads; i++) sm_workers.emplace_back(WorkerLoop);
+}
+
+void Onyx::AssetLoader::WorkerLoop()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(sm_jobMutex);
+			sm_jobAvailable.wait(lock, []() { return sm_stopping || !sm_jobs.empty(); });
+			if (sm_stopping) return;
+
+			job = std::move(sm_jobs.front());
+			sm_jobs.pop_front();
+		}
+
+		bool loaded = job.work();
+
+		{
+			std::lock_guard<std::mutex> lock(sm_uploadMutex);
+
+			bool cancelled = job.generation != sm_generation || *job.cancelled;
+			if (loaded && !cancelled && job.upload) sm_uploads.push_back(std::move(job));
+			else Complete(job, loaded && !cancelled);
+		}
+		sm_uploadAvailable.notify_all();
+	}
+}
+
+void Onyx::AssetLoader::Complete(Job& job, bool loaded)
+{
+	job.complete(loaded);
+	sm_pending--;
+}
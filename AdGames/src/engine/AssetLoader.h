@@ -0,0 +1,301 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+#include <Onyx/Core.h>
+
+#include "Image.h"
+#include "Texture2D.h"
+#include "AtlasFont.h"
+#include "CookedModel.h"
+
+namespace Onyx
+{
+	/*
+		@brief The state of an asset requested from the AssetLoader.
+	 */
+	enum class AssetState
+	{
+		Pending,
+		Loaded,
+		Failed
+	};
+
+	/*
+		@brief A handle to an asset requested from the AssetLoader, which fills it in once the asset is loaded.
+		Copies refer to the same asset. A default constructed handle is never loaded.
+	 */
+	template<typename T>
+	class AssetHandle
+	{
+		friend class AssetLoader;
+	public:
+		/*
+			@brief Default constructor, creates a handle that is never loaded.
+		 */
+		AssetHandle() = default;
+
+		/*
+			@brief Creates a handle to an asset that is already loaded, for caches that hand out handles but already have the asset.
+			@param asset The asset.
+		 */
+		AssetHandle(const T& asset);
+
+		/*
+			@brief Gets the state of the asset.
+			@return Pending until the asset is loaded or has failed to load.
+		 */
+		AssetState getState() const;
+
+		/*
+			@brief Gets whether the asset is loaded and can be used.
+			@return True if the asset is loaded, false if it is pending or failed.
+		 */
+		bool isLoaded() const;
+
+		/*
+			@brief Gets whether the asset failed to load, or its load was cancelled.
+			@return True if the asset failed, false if not.
+		 */
+		bool isFailed() const;
+
+		/*
+			@brief Blocks until the asset is loaded or has failed.
+			Assets that need a GL upload are only loaded once AssetLoader::Update() has run, so never wait for those on the thread that calls it.
+		 */
+		void wait() const;
+
+		/*
+			@brief Gets the asset. Only valid once isLoaded() returns true.
+			@return The asset.
+		 */
+		T& get() const;
+
+		/*
+			@brief Gets whether two handles refer to the same asset.
+			@param other The other handle.
+			@return True if one is a copy of the other, false if not.
+		 */
+		bool operator==(const AssetHandle& other) const;
+
+	private:
+		struct State
+		{
+			std::atomic<AssetState> state = AssetState::Pending;
+			T asset;
+		};
+
+		std::shared_ptr<State> m_state;
+	};
+
+	/*
+		@brief A set of loads that can be cancelled together, without touching loads anyone else started.
+		Copies refer to the same group. A scene keeps one, passes it to every load it starts, and cancels it in unload().
+		Loads started in a group that was already cancelled fail straight away.
+	 */
+	class AssetGroup
+	{
+		friend class AssetLoader;
+	public:
+		/*
+			@brief Creates a new group.
+		 */
+		AssetGroup();
+
+		/*
+			@brief Gets whether the group was cancelled.
+			@return True if AssetLoader::Cancel() was called with the group, false if not.
+		 */
+		bool isCancelled() const;
+
+	private:
+		std::shared_ptr<std::atomic<bool>> m_cancelled;
+	};
+
+	/*
+		@brief A pool of worker threads that load assets in the background.
+		File I/O, image decoding and font rasterization happen on the workers, and only the final GL upload is left for the main thread,
+		which does as many of them as fit in a time budget each time Update() is called. A frame never has to wait on the disk.
+		The SceneManager calls Update() every frame, so scenes only start loads and check their handles.
+		Assets that need no GL objects (images) are loaded as soon as their worker finishes.
+		The workers are started by the first load and keep running until Shutdown(), independent of Onyx::Init() and Onyx::Terminate().
+		Whoever starts loads that create GL objects cancels their AssetGroup once it no longer wants them, so nothing is uploaded for it afterwards.
+		Call Cancel() before the GL context is destroyed, so no uploads end up in the next one.
+	 */
+	class AssetLoader
+	{
+	public:
+		/*
+			@brief Decodes an image on a worker thread.
+			@param filepath The path of the image.
+			@param flipVertically Whether the first row should be the bottom of the image, which is what OpenGL textures expect.
+			@param group The group the load belongs to.
+			@return The handle to the image.
+		 */
+		static AssetHandle<Image> DecodeImage(const std::string& filepath, bool flipVertically = false, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Decodes an image on a worker thread and uploads it to a texture in a later Update().
+			@param filepath The path of the image.
+			@param textureWrap The texture wrap option. Repeat by default.
+			@param minFilter The minification filter (applied when the texture is shrunk). Nearest by default.
+			@param magFilter The magnification filter (applied when the texture is enlarged). Linear by default.
+			@param group The group the load belongs to.
+			@return The handle to the texture.
+		 */
+		static AssetHandle<Texture2D> LoadTexture(const std::string& filepath, TextureWrap textureWrap = TextureWrap::Repeat, TextureFilter minFilter = TextureFilter::Nearest, TextureFilter magFilter = TextureFilter::Linear, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Uploads an image that is already loaded, or still loading, to a texture in a later Update().
+			The image should be flipped vertically, like the ones LoadTexture() decodes.
+			@param image The handle to the image.
+			@param textureWrap The texture wrap option. Repeat by default.
+			@param minFilter The minification filter (applied when the texture is shrunk). Nearest by default.
+			@param magFilter The magnification filter (applied when the texture is enlarged). Linear by default.
+			@param group The group the upload belongs to. Cancelling it doesn't cancel the image.
+			@return The handle to the texture.
+		 */
+		static AssetHandle<Texture2D> UploadTexture(const AssetHandle<Image>& image, TextureWrap textureWrap = TextureWrap::Repeat, TextureFilter minFilter = TextureFilter::Nearest, TextureFilter magFilter = TextureFilter::Linear, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Rasterizes and packs a font on a worker thread and uploads its atlas in a later Update().
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param sdf Whether to load it as an SDF font, see AtlasFont::LoadSDF().
+			@param group The group the load belongs to.
+			@return The handle to the font.
+		 */
+		static AssetHandle<AtlasFont> LoadFont(const std::string& ttfFilePath, uint size, bool sdf = false, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Cooks (if it has to) and maps a model's cooked mesh file on a worker thread and uploads its parts in a later Update(), see CookedModel::Load().
+			If the model is already loaded, the handle is loaded straight away.
+			Onyx's textures can only be loaded from a file, so the model's textures are still decoded during the upload.
+			@param objPath The path of the OBJ file.
+			@param group The group the load belongs to.
+			@return The handle to the model, with its own transform.
+		 */
+		static AssetHandle<CookedModel> LoadModel(const std::string& objPath, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Does the GL uploads of assets that finished loading, until the time budget is used up. Must be called on the thread that owns the GL context, once per frame.
+			At least one upload is done per call, so a budget that is too small can't stall loading.
+			@param budgetMs The time budget, in milliseconds.
+		 */
+		static void Update(double budgetMs = 2.0);
+
+		/*
+			@brief Blocks until every requested asset is loaded or has failed, doing the uploads as they become ready. Must be called on the thread that owns the GL context.
+		 */
+		static void Finish();
+
+		/*
+			@brief Drops every load in a group that hasn't been uploaded yet, their handles fail. Loads already running on a worker finish, but are thrown away.
+			Loads in other groups carry on. Must be called on the thread that calls Update(), so nothing in the group is halfway through its upload.
+			@param group The group to cancel.
+		 */
+		static void Cancel(const AssetGroup& group);
+
+		/*
+			@brief Drops every load that hasn't been uploaded yet, whichever group it is in, the same way as Cancel(const AssetGroup&).
+			Only for shutting down, when the GL context is about to be destroyed.
+		 */
+		static void Cancel();
+
+		/*
+			@brief Cancels everything and stops the worker threads. Must be called before the program exits.
+			Loading anything afterwards starts them again.
+		 */
+		static void Shutdown();
+
+		/*
+			@brief Gets the number of assets that are neither loaded nor failed.
+			@return The number of pending assets.
+		 */
+		static uint GetPendingCount();
+
+		/*
+			@brief Gets the number of worker threads.
+			@return The number of workers, 0 if they aren't running.
+		 */
+		static uint GetThreadCount();
+
+	private:
+		// work() runs on a worker and upload() (if there is one) on the main thread, complete() sets the handle's state once either fails or both are done
+		struct Job
+		{
+			std::function<bool()> work;
+			std::function<bool()> upload;
+			std::function<void(bool)> complete;
+			uint generation = 0;
+			std::shared_ptr<std::atomic<bool>> cancelled;
+		};
+
+		static void Submit(Job job, const AssetGroup& group);
+		static void Start();
+		static void WorkerLoop();
+		static void Complete(Job& job, bool loaded);
+
+		static std::vector<std::thread> sm_workers;
+		static std::deque<Job> sm_jobs;
+		static std::deque<Job> sm_uploads;
+		static std::mutex sm_jobMutex, sm_uploadMutex;
+		static std::condition_variable sm_jobAvailable, sm_uploadAvailable;
+		static std::atomic<uint> sm_pending;
+		static uint sm_generation;
+		static bool sm_stopping;
+	};
+}
+
+template<typename T>
+Onyx::AssetHandle<T>::AssetHandle(const T& asset)
+	: m_state(std::make_shared<State>())
+{
+	m_state->asset = asset;
+	m_state->state = AssetState::Loaded;
+}
+
+template<typename T>
+Onyx::AssetState Onyx::AssetHandle<T>::getState() const
+{
+	return m_state ? m_state->state.load(std::memory_order_acquire) : AssetState::Failed;
+}
+
+template<typename T>
+bool Onyx::AssetHandle<T>::isLoaded() const
+{
+	return getState() == AssetState::Loaded;
+}
+
+template<typename T>
+bool Onyx::AssetHandle<T>::isFailed() const
+{
+	return getState() == AssetState::Failed;
+}
+
+template<typename T>
+void Onyx::AssetHandle<T>::wait() const
+{
+	while (getState() == AssetState::Pending) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+template<typename T>
+T& Onyx::AssetHandle<T>::get() const
+{
+	return m_state->asset;
+}
+
+template<typename T>
+bool Onyx::AssetHandle<T>::operator==(const AssetHandle& other) const
+{
+	return m_state == other.m_state;
+}
@@ -0,0 +1,240 @@
+#include "AtlasFont.h"
+
+#include <vector>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+
+// empty texels between glyphs, so linear filtering never samples a neighbour
+const int ATLAS_PADDING = 1;
+
+// how far, in pixels, the distance fields reach outside (and inside) a glyph's outline. it bounds how thick outlines or glows could get
+const int SDF_SPREAD = 8;
+
+Onyx::AtlasFont::AtlasFont()
+{
+	m_size = 0;
+	m_spread = 0;
+	m_tex = 0;
+	m_atlasWidth = m_atlasHeight = 0;
+	m_glyphs.fill(AtlasGlyph{ 0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0, 0 });
+}
+
+Onyx::AtlasFont Onyx::AtlasFont::Load(const std::string& ttfFilePath, uint size, bool* result)
+{
+	AtlasFont font;
+	std::vector<ubyte> atlas;
+	bool rasterized = Rasterize(ttfFilePath, size, false, font, atlas);
+	if (rasterized) font.upload(atlas);
+
+	if (result) *result = rasterized;
+	return font;
+}
+
+Onyx::AtlasFont Onyx::AtlasFont::LoadSDF(const std::string& ttfFilePath, uint size, bool* result)
+{
+	AtlasFont font;
+	std::vector<ubyte> atlas;
+	bool rasterized = Rasterize(ttfFilePath, size, true, font, atlas);
+	if (rasterized) font.upload(atlas);
+
+	if (result) *result = rasterized;
+	return font;
+}
+
+bool Onyx::AtlasFont::Rasterize(const std::string& ttfFilePath, uint size, bool sdf, AtlasFont& font, std::vector<ubyte>& atlas)
+{
+	font.m_ttfFilePath = ttfFilePath;
+	font.m_size = size;
+	font.m_spread = sdf ? SDF_SPREAD : 0;
+
+	// every call has its own library instance, so fonts can be rasterized on several threads at once
+	FT_Library freeType;
+	if (FT_Init_FreeType(&freeType)) return false;
+
+	FT_Face face;
+	if (FT_New_Face(freeType, ttfFilePath.c_str(), 0, &face))
+	{
+		FT_Done_FreeType(freeType);
+		return false;
+	}
+
+	FT_Set_Pixel_Sizes(face, 0, size);
+
+	if (sdf)
+	{
+		FT_Int spread = SDF_SPREAD;
+		FT_Property_Set(freeType, "sdf", "spread", &spread);
+	}
+
+	// rasterize everything first, the atlas can only be laid out once every glyph's size is known
+	std::vector<std::vector<ubyte>> bitmaps(N_GLYPHS);
+	int area = 0, widest = 0;
+	for (uint c = 0; c < N_GLYPHS; c++)
+	{
+		AtlasGlyph& glyph = font.m_glyphs[c];
+		if (FT_Load_Char(face, c, sdf ? FT_LOAD_DEFAULT : FT_LOAD_RENDER)) continue;
+
+		FT_GlyphSlot slot = face->glyph;
+
+		// the field is rendered from the outline, the bitmap grows by the spread on every side and the bearings move with it
+		if (sdf && FT_Render_Glyph(slot, FT_RENDER_MODE_SDF)) continue;
+
+		glyph.width = slot->bitmap.width;
+		glyph.height = slot->bitmap.rows;
+		glyph.bearingX = slot->bitmap_left;
+		glyph.bearingY = slot->bitmap_top;
+		glyph.advance = slot->advance.x >> 6;
+
+		std::vector<ubyte>& bitmap = bitmaps[c];
+		bitmap.resize(glyph.width * glyph.height);
+		for (int row = 0; row < glyph.height; row++)
+			memcpy(bitmap.data() + row * glyph.width, slot->bitmap.buffer + row * slot->bitmap.pitch, glyph.width);
+
+		area += (glyph.width + ATLAS_PADDING) * (glyph.height + ATLAS_PADDING);
+		if (glyph.width > widest) widest = glyph.width;
+	}
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(freeType);
+
+	// a power of two wide enough to make the atlas roughly square, then glyphs are placed left to right in rows (shelves)
+	int atlasWidth = 64;
+	while (atlasWidth * atlasWidth < area || atlasWidth < widest + 2 * ATLAS_PADDING) atlasWidth *= 2;
+
+	struct Placement { int x, y; };
+	std::vector<Placement> placements(N_GLYPHS);
+	int x = ATLAS_PADDING, y = ATLAS_PADDING, shelfHeight = 0;
+	for (uint c = 0; c < N_GLYPHS; c++)
+	{
+		const AtlasGlyph& glyph = font.m_glyphs[c];
+		if (x + glyph.width + ATLAS_PADDING > atlasWidth)
+		{
+			x = ATLAS_PADDING;
+			y += shelfHeight + ATLAS_PADDING;
+			shelfHeight = 0;
+		}
+
+		placements[c] = Placement{ x, y };
+		x += glyph.width + ATLAS_PADDING;
+		if (glyph.height > shelfHeight) shelfHeight = glyph.height;
+	}
+
+	int atlasHeight = 1;
+	while (atlasHeight < y + shelfHeight + ATLAS_PADDING) atlasHeight *= 2;
+
+	atlas.assign(atlasWidth * atlasHeight, 0);
+	for (uint c = 0; c < N_GLYPHS; c++)
+	{
+		AtlasGlyph& glyph = font.m_glyphs[c];
+		const Placement& place = placements[c];
+
+		for (int row = 0; row < glyph.height; row++)
+			memcpy(atlas.data() + (place.y + row) * atlasWidth + place.x, bitmaps[c].data() + row * glyph.width, glyph.width);
+
+		// row 0 of the bitmap is the top of the glyph, and also the first row of the texture, so v0 is the top
+		glyph.u0 = (float)place.x / atlasWidth;
+		glyph.v0 = (float)place.y / atlasHeight;
+		glyph.u1 = (float)(place.x + glyph.width) / atlasWidth;
+		glyph.v1 = (float)(place.y + glyph.height) / atlasHeight;
+	}
+
+	font.m_atlasWidth = atlasWidth;
+	font.m_atlasHeight = atlasHeight;
+
+	return true;
+}
+
+void Onyx::AtlasFont::upload(const std::vector<ubyte>& atlas)
+{
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	glGenTextures(1, &m_tex);
+	glBindTexture(GL_TEXTURE_2D, m_tex);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_atlasWidth, m_atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+Onyx::Math::IVec2 Onyx::AtlasFont::getStringDimensions(const std::string& str) const
+{
+	return Math::IVec2(getStringWidth(str), getStringHeight(str));
+}
+
+int Onyx::AtlasFont::getStringWidth(const std::string& str) const
+{
+	if (str.empty()) return 0;
+
+	int width = 0;
+	for (size_t i = 0; i < str.length() - 1; i++) width += (*this)[str[i]].advance;
+
+	// the spread is part of the quad but not of the glyph
+	int last = (*this)[str.back()].width - 2 * m_spread;
+	return width + (last > 0 ? last : 0);
+}
+
+int Onyx::AtlasFont::getStringHeight(const std::string& str) const
+{
+	int height = 0;
+	for (char c : str)
+	{
+		int h = (*this)[c].height - 2 * m_spread;
+		if (h > height) height = h;
+	}
+	return height;
+}
+
+const std::string& Onyx::AtlasFont::getTtfFilePath() const
+{
+	return m_ttfFilePath;
+}
+
+uint Onyx::AtlasFont::getSize() const
+{
+	return m_size;
+}
+
+bool Onyx::AtlasFont::isSDF() const
+{
+	return m_spread > 0;
+}
+
+int Onyx::AtlasFont::getSpread() const
+{
+	return m_spread;
+}
+
+uint Onyx::AtlasFont::getTextureID() const
+{
+	return m_tex;
+}
+
+Onyx::Math::IVec2 Onyx::AtlasFont::getAtlasDimensions() const
+{
+	return Math::IVec2(m_atlasWidth, m_atlasHeight);
+}
+
+const Onyx::AtlasGlyph& Onyx::AtlasFont::operator[](char c) const
+{
+	ubyte index = (ubyte)c;
+	return m_glyphs[index < N_GLYPHS ? index : '?'];
+}
+
+void Onyx::AtlasFont::dispose()
+{
+	if (m_disposed) return;
+
+	glDeleteTextures(1, &m_tex);
+	m_tex = 0;
+
+	m_disposed = true;
+}
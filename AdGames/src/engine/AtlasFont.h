@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <Onyx/Core.h>
+#include <Onyx/Math.h>
+
+namespace Onyx
+{
+	/*
+		@brief A struct to represent a glyph/character in an atlas font.
+		Unlike Onyx's Glyph, it has no texture of its own, just the rectangle it occupies in the font's atlas.
+	 */
+	struct AtlasGlyph
+	{
+		/*
+			@brief The texture coordinates of the glyph's top left and bottom right corners in the atlas.
+		 */
+		float u0, v0, u1, v1;
+
+		/*
+			@brief The width and height of the glyph, in pixels.
+		 */
+		int width, height;
+
+		/*
+			@brief The bearing of the glyph on the x and y axes.
+		 */
+		int bearingX, bearingY;
+
+		/*
+			@brief The advance of the glyph, in pixels.
+		 */
+		uint advance;
+	};
+
+	/*
+		@brief A class to represent a font whose glyphs are all packed into one texture atlas.
+		Text using it can be drawn with a single texture bind and draw call, see AtlasText and AtlasText3D.
+		Glyphs are stored in a flat array indexed by character, characters outside the loaded range are drawn as '?'.
+		A font loaded with LoadSDF() stores signed distances instead of coverage, so a small atlas stays sharp at any scale. Text picks the matching shader by itself.
+		This class is disposable. Copies share the atlas, so only one of them should be disposed.
+	 */
+	class AtlasFont : public Disposable
+	{
+		friend class AssetLoader;
+	public:
+		/*
+			@brief The number of characters loaded, starting from 0.
+		 */
+		static const uint N_GLYPHS = 128;
+
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+			Use the static `Load` function to create a valid font.
+		 */
+		AtlasFont();
+
+		/*
+			@brief Loads a font from the specified TrueType font file and the specified size, and packs its glyphs into an atlas.
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param result A pointer to a boolean that will be set to true if the font was loaded successfully, and false otherwise.
+			@return The font.
+		 */
+		static AtlasFont Load(const std::string& ttfFilePath, uint size, bool* result = nullptr);
+
+		/*
+			@brief Loads a font from the specified TrueType font file and the specified size, and packs signed distance fields of its glyphs into an atlas.
+			Every texel holds the distance to the glyph's outline, 0.5 being on it, so the text shader can find the edge at any scale.
+			A size around 48 is enough for text of any size, the layout functions still measure in pixels at that size.
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param result A pointer to a boolean that will be set to true if the font was loaded successfully, and false otherwise.
+			@return The font.
+		 */
+		static AtlasFont LoadSDF(const std::string& ttfFilePath, uint size, bool* result = nullptr);
+
+		/*
+			@brief Gets the dimensions of a string if it were to be rendered with this font.
+			See getStringWidth() and getStringHeight() for specific information.
+			@param str The string.
+			@return The dimensions (width and height) of the string.
+		 */
+		Math::IVec2 getStringDimensions(const std::string& str) const;
+
+		/*
+			@brief Gets the width of a string if it were to be rendered with this font.
+			Specifically, this function sums up the advances of each character in the string excluding the last character, and then adds the width of the last character.
+			@param str The string.
+			@return The width of the string.
+		 */
+		int getStringWidth(const std::string& str) const;
+
+		/*
+			@brief Gets the height of a string if it were to be rendered with this font.
+			Specifically, this function returns the height of the tallest character in the string.
+			@param str The string.
+			@return The height of the string.
+		 */
+		int getStringHeight(const std::string& str) const;
+
+		/*
+			@brief Gets the path of the TrueType font file.
+			@return The path of the TrueType font file.
+		 */
+		const std::string& getTtfFilePath() const;
+
+		/*
+			@brief Gets the size of the font.
+			@return The size of the font, in pixels.
+		 */
+		uint getSize() const;
+
+		/*
+			@brief Gets whether the atlas holds signed distance fields.
+			@return True if the font was loaded with LoadSDF(), false if not.
+		 */
+		bool isSDF() const;
+
+		/*
+			@brief Gets the number of pixels around each glyph that the distance field spreads into.
+			Glyph quads include it, the string dimensions don't.
+			@return The spread, in pixels, or 0 if the font isn't an SDF font.
+		 */
+		int getSpread() const;
+
+		/*
+			@brief Gets the ID of the atlas texture in OpenGL.
+			@return The ID of the atlas texture.
+		 */
+		uint getTextureID() const;
+
+		/*
+			@brief Gets the dimensions of the atlas texture.
+			@return The width and height of the atlas, in pixels.
+		 */
+		Math::IVec2 getAtlasDimensions() const;
+
+		/*
+			@brief Gets the glyph of the specified character.
+			@param c The character.
+			@return The glyph of the character, or of '?' if the character wasn't loaded.
+		 */
+		const AtlasGlyph& operator[](char c) const;
+
+		void dispose() override;
+
+	private:
+		// rasterizing and packing touch no GL state, so they can run on any thread, only upload() has to be on the GL thread
+		static bool Rasterize(const std::string& ttfFilePath, uint size, bool sdf, AtlasFont& font, std::vector<ubyte>& atlas);
+		void upload(const std::vector<ubyte>& atlas);
+
+		std::string m_ttfFilePath;
+		uint m_size;
+		int m_spread;
+
+		uint m_tex;
+		int m_atlasWidth, m_atlasHeight;
+
+		std::array<AtlasGlyph, N_GLYPHS> m_glyphs;
+	};
+}
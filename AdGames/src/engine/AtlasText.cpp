@@ -0,0 +1,190 @@
+#include "AtlasText.h"
+
+#include <glad/glad.h>
+
+#include "ShaderCache.h"
+#include "UniformCache.h"
+
+Onyx::AtlasText::AtlasText()
+{
+	m_pFont = nullptr;
+	m_rotation = 0.0f;
+	m_scale = Math::Vec2(1.0f, 1.0f);
+	m_model = Math::Mat4::Identity();
+	m_hidden = false;
+}
+
+Onyx::AtlasText::AtlasText(const std::string& text, AtlasFont& font, const Math::Vec4& color, bool* result)
+	: AtlasText()
+{
+	m_shader = ShaderCache::Load(Resources(font.isSDF() ? "shaders/ubo/AtlasText_UI_SDF.glsl" : "shaders/ubo/AtlasText_UI.glsl"), result);
+	m_pFont = &font;
+	m_text = text;
+	m_color = color;
+
+	m_mesh.build(font, text);
+	updateDimensions();
+	updateModel();
+}
+
+void Onyx::AtlasText::render(const Math::Mat4& ortho)
+{
+	if (m_hidden || m_mesh.getVertexCount() == 0) return;
+
+	UniformCache::SetMat4(m_shader, "u_projection"_u, ortho);
+	UniformCache::SetMat4(m_shader, "u_model"_u, m_model);
+	UniformCache::SetVec4(m_shader, "u_color"_u, m_color);
+
+	m_shader.use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_pFont->getTextureID());
+
+	m_mesh.draw();
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+}
+
+void Onyx::AtlasText::hide()
+{
+	m_hidden = true;
+}
+
+void Onyx::AtlasText::show()
+{
+	m_hidden = false;
+}
+
+bool Onyx::AtlasText::isHidden() const
+{
+	return m_hidden;
+}
+
+const Onyx::Math::Vec2& Onyx::AtlasText::getPosition() const
+{
+	return m_position;
+}
+
+float Onyx::AtlasText::getRotation() const
+{
+	return m_rotation;
+}
+
+const Onyx::Math::Vec2& Onyx::AtlasText::getScale() const
+{
+	return m_scale;
+}
+
+const std::string& Onyx::AtlasText::getText() const
+{
+	return m_text;
+}
+
+const Onyx::AtlasFont& Onyx::AtlasText::getFont() const
+{
+	return *m_pFont;
+}
+
+const Onyx::Math::Vec4& Onyx::AtlasText::getColor() const
+{
+	return m_color;
+}
+
+const Onyx::Math::Vec2& Onyx::AtlasText::getDimensions() const
+{
+	return m_dimensions;
+}
+
+float Onyx::AtlasText::getWidth() const
+{
+	return m_dimensions.getX();
+}
+
+float Onyx::AtlasText::getHeight() const
+{
+	return m_dimensions.getY();
+}
+
+Onyx::Shader* Onyx::AtlasText::getShader()
+{
+	return &m_shader;
+}
+
+const Onyx::TextMesh* Onyx::AtlasText::getMesh() const
+{
+	return &m_mesh;
+}
+
+void Onyx::AtlasText::setText(const std::string& text)
+{
+	// games set their score text every frame, but it rarely actually changes
+	if (text == m_text) return;
+
+	m_text = text;
+	m_mesh.build(*m_pFont, text);
+	updateDimensions();
+}
+
+void Onyx::AtlasText::setColor(const Math::Vec4& color)
+{
+	m_color = color;
+}
+
+void Onyx::AtlasText::setPosition(const Math::Vec2& position)
+{
+	m_position = position;
+	updateModel();
+}
+
+void Onyx::AtlasText::setRotation(float rotation)
+{
+	m_rotation = rotation;
+	updateModel();
+}
+
+void Onyx::AtlasText::setScale(const Math::Vec2& scale)
+{
+	m_scale = scale;
+	updateModel();
+	updateDimensions();
+}
+
+void Onyx::AtlasText::setScale(float scale)
+{
+	setScale(Math::Vec2(scale, scale));
+}
+
+void Onyx::AtlasText::translate(const Math::Vec2& translation)
+{
+	m_position += translation;
+	updateModel();
+}
+
+void Onyx::AtlasText::scale(float scalar)
+{
+	setScale(m_scale * scalar);
+}
+
+void Onyx::AtlasText::dispose()
+{
+	if (m_disposed) return;
+
+	// the shader belongs to the shader cache and the font to whoever loaded it
+	m_mesh.dispose();
+
+	m_disposed = true;
+}
+
+void Onyx::AtlasText::updateModel()
+{
+	m_model = Math::Mat4::Identity();
+	m_model.translate(Math::Vec3(m_position, 0.0f));
+	if (m_rotation != 0.0f) m_model.rotate(m_rotation, Math::Vec3(0.0f, 0.0f, 1.0f));
+	m_model.scale(Math::Vec3(m_scale, 1.0f));
+}
+
+void Onyx::AtlasText::updateDimensions()
+{
+	Math::IVec2 dimensions = m_pFont->getStringDimensions(m_text);
+	m_dimensions = Math::Vec2(dimensions.getX() * m_scale.getX(), dimensions.getY() * m_scale.getY());
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <string>
+
+#include <Onyx/Core.h>
+#include <Onyx/Shader.h>
+#include <Onyx/Math.h>
+
+#include "AtlasFont.h"
+#include "TextMesh.h"
+
+namespace Onyx
+{
+	/*
+		@brief A class to represent a renderable string of UI text using an AtlasFont.
+		The whole string is one vertex buffer and is drawn with one texture bind and one draw call, unlike Onyx's TextRenderable which draws each character separately.
+		The shader is shared through the ShaderCache.
+		This class is disposable.
+	 */
+	class AtlasText : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+		 */
+		AtlasText();
+
+		/*
+			@brief Creates an AtlasText from the specified text, font, and color.
+			@param text The text to render.
+			@param font The font to use. It must outlive the text.
+			@param color The color of the text.
+			@param result A pointer to a boolean that will be set to true if the text shader was successfully compiled, and false otherwise.
+		 */
+		AtlasText(const std::string& text, AtlasFont& font, const Math::Vec4& color, bool* result = nullptr);
+
+		/*
+			@brief Renders the text with the specified orthographic projection matrix.
+			This function, more technically, uses the shader, binds the atlas, binds the VAO, draws, unbinds the VAO, unbinds the atlas, and unuses the shader.
+			@param ortho The orthographic projection matrix to use.
+		 */
+		void render(const Math::Mat4& ortho);
+
+		/*
+			@brief Hides the text.
+			This function simply makes render() no longer do anything.
+		 */
+		void hide();
+
+		/*
+			@brief Shows the text.
+			This function simply makes render() do what it's supposed to.
+		 */
+		void show();
+
+		/*
+			@brief Gets whether the text is hidden.
+			See hide() and show() for more info.
+			@return Whether the text is hidden.
+		 */
+		bool isHidden() const;
+
+		/*
+			@brief Gets the position of the text.
+			@return The position of the left end of the baseline.
+		 */
+		const Math::Vec2& getPosition() const;
+
+		/*
+			@brief Gets the rotation of the text.
+			@return The rotation, in degrees.
+		 */
+		float getRotation() const;
+
+		/*
+			@brief Gets the scale of the text.
+			@return The scale for each axis.
+		 */
+		const Math::Vec2& getScale() const;
+
+		/*
+			@brief Gets the text that is being rendered.
+			@return The text that is being rendered.
+		 */
+		const std::string& getText() const;
+
+		/*
+			@brief Gets the font that is being used.
+			@return The font that is being used.
+		 */
+		const AtlasFont& getFont() const;
+
+		/*
+			@brief Gets the color of the text.
+			@return The color of the text.
+		 */
+		const Math::Vec4& getColor() const;
+
+		/*
+			@brief Gets the dimensions of the text, including its scale.
+			@return The dimensions (width and height), in pixels.
+		 */
+		const Math::Vec2& getDimensions() const;
+
+		/*
+			@brief Gets the width of the text, including its scale.
+			@return The width, in pixels.
+		 */
+		float getWidth() const;
+
+		/*
+			@brief Gets the height of the text, including its scale.
+			@return The height, in pixels.
+		 */
+		float getHeight() const;
+
+		/*
+			@brief Gets the text shader.
+			@return A pointer to the shader.
+		 */
+		Shader* getShader();
+
+		/*
+			@brief Gets the text mesh.
+			@return A pointer to the mesh.
+		 */
+		const TextMesh* getMesh() const;
+
+		/*
+			@brief Sets the text to render.
+			Does nothing if the text is the same, so it is cheap to call every frame. Otherwise only the characters that changed are uploaded again.
+			@param text The text to render.
+		 */
+		void setText(const std::string& text);
+
+		/*
+			@brief Sets the color of the text.
+			@param color The color of the text.
+		 */
+		void setColor(const Math::Vec4& color);
+
+		/*
+			@brief Sets the position of the text.
+			@param position The new position of the left end of the baseline.
+		 */
+		void setPosition(const Math::Vec2& position);
+
+		/*
+			@brief Sets the rotation of the text.
+			@param rotation The new rotation, in degrees.
+		 */
+		void setRotation(float rotation);
+
+		/*
+			@brief Sets the scale of the text.
+			@param scale The new scale for each axis.
+		 */
+		void setScale(const Math::Vec2& scale);
+
+		/*
+			@brief Sets the scale of the text on both axes.
+			@param scale The new scale.
+		 */
+		void setScale(float scale);
+
+		/*
+			@brief Translates (moves) the text.
+			@param translation The amount to translate by.
+		 */
+		void translate(const Math::Vec2& translation);
+
+		/*
+			@brief Scales the text on both axes.
+			This function does not set the scale, it multiplies it.
+			@param scalar The amount to scale by.
+		 */
+		void scale(float scalar);
+
+		void dispose() override;
+
+	private:
+		TextMesh m_mesh;
+		Shader m_shader;
+		AtlasFont* m_pFont;
+
+		std::string m_text;
+		Math::Vec4 m_color;
+
+		Math::Vec2 m_position;
+		float m_rotation;
+		Math::Vec2 m_scale;
+
+		Math::Vec2 m_dimensions;
+		Math::Mat4 m_model;
+		bool m_hidden;
+
+		void updateModel();
+		void updateDimensions();
+	};
+}
@@ -0,0 +1,190 @@
+#include "AtlasText3D.h"
+
+#include <glad/glad.h>
+
+#include "ShaderCache.h"
+#include "UniformCache.h"
+
+Onyx::AtlasText3D::AtlasText3D()
+{
+	m_pFont = nullptr;
+	m_scale = Math::Vec3(1.0f, 1.0f, 1.0f);
+	m_model = Math::Mat4::Identity();
+	m_hidden = false;
+}
+
+Onyx::AtlasText3D::AtlasText3D(const std::string& text, AtlasFont& font, const Math::Vec4& color, bool* result)
+	: AtlasText3D()
+{
+	m_shader = ShaderCache::Load(Resources(font.isSDF() ? "shaders/ubo/AtlasText_SDF.glsl" : "shaders/ubo/AtlasText.glsl"), result);
+	m_pFont = &font;
+	m_text = text;
+	m_color = color;
+
+	m_mesh.build(font, text);
+	updateDimensions();
+	updateModel();
+}
+
+void Onyx::AtlasText3D::render()
+{
+	if (m_hidden || m_mesh.getVertexCount() == 0) return;
+
+	UniformCache::SetMat4(m_shader, "u_model"_u, m_model);
+	UniformCache::SetVec4(m_shader, "u_color"_u, m_color);
+
+	m_shader.use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_pFont->getTextureID());
+
+	m_mesh.draw();
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+}
+
+void Onyx::AtlasText3D::hide()
+{
+	m_hidden = true;
+}
+
+void Onyx::AtlasText3D::show()
+{
+	m_hidden = false;
+}
+
+bool Onyx::AtlasText3D::isHidden() const
+{
+	return m_hidden;
+}
+
+const Onyx::Math::Vec3& Onyx::AtlasText3D::getPosition() const
+{
+	return m_position;
+}
+
+const Onyx::Math::Vec3& Onyx::AtlasText3D::getRotation() const
+{
+	return m_rotation;
+}
+
+const Onyx::Math::Vec3& Onyx::AtlasText3D::getScale() const
+{
+	return m_scale;
+}
+
+const std::string& Onyx::AtlasText3D::getText() const
+{
+	return m_text;
+}
+
+const Onyx::AtlasFont& Onyx::AtlasText3D::getFont() const
+{
+	return *m_pFont;
+}
+
+const Onyx::Math::Vec4& Onyx::AtlasText3D::getColor() const
+{
+	return m_color;
+}
+
+const Onyx::Math::Vec2& Onyx::AtlasText3D::getDimensions() const
+{
+	return m_dimensions;
+}
+
+float Onyx::AtlasText3D::getWidth() const
+{
+	return m_dimensions.getX();
+}
+
+float Onyx::AtlasText3D::getHeight() const
+{
+	return m_dimensions.getY();
+}
+
+Onyx::Shader* Onyx::AtlasText3D::getShader()
+{
+	return &m_shader;
+}
+
+const Onyx::TextMesh* Onyx::AtlasText3D::getMesh() const
+{
+	return &m_mesh;
+}
+
+void Onyx::AtlasText3D::setText(const std::string& text)
+{
+	// games set their score text every frame, but it rarely actually changes
+	if (text == m_text) return;
+
+	m_text = text;
+	m_mesh.build(*m_pFont, text);
+	updateDimensions();
+}
+
+void Onyx::AtlasText3D::setColor(const Math::Vec4& color)
+{
+	m_color = color;
+}
+
+void Onyx::AtlasText3D::setPosition(const Math::Vec3& position)
+{
+	m_position = position;
+	updateModel();
+}
+
+void Onyx::AtlasText3D::setRotation(const Math::Vec3& rotation)
+{
+	m_rotation = rotation;
+	updateModel();
+}
+
+void Onyx::AtlasText3D::setScale(const Math::Vec3& scale)
+{
+	m_scale = scale;
+	updateModel();
+	updateDimensions();
+}
+
+void Onyx::AtlasText3D::setScale(float scale)
+{
+	setScale(Math::Vec3(scale, scale, scale));
+}
+
+void Onyx::AtlasText3D::translate(const Math::Vec3& translation)
+{
+	m_position += translation;
+	updateModel();
+}
+
+void Onyx::AtlasText3D::scale(float scalar)
+{
+	setScale(m_scale * scalar);
+}
+
+void Onyx::AtlasText3D::dispose()
+{
+	if (m_disposed) return;
+
+	// the shader belongs to the shader cache and the font to whoever loaded it
+	m_mesh.dispose();
+
+	m_disposed = true;
+}
+
+void Onyx::AtlasText3D::updateModel()
+{
+	m_model = Math::Mat4::Identity();
+	m_model.translate(m_position);
+	if (m_rotation.getX() != 0.0f) m_model.rotate(m_rotation.getX(), Math::Vec3(1.0f, 0.0f, 0.0f));
+	if (m_rotation.getY() != 0.0f) m_model.rotate(m_rotation.getY(), Math::Vec3(0.0f, 1.0f, 0.0f));
+	if (m_rotation.getZ() != 0.0f) m_model.rotate(m_rotation.getZ(), Math::Vec3(0.0f, 0.0f, 1.0f));
+	m_model.scale(m_scale);
+}
+
+void Onyx::AtlasText3D::updateDimensions()
+{
+	Math::IVec2 dimensions = m_pFont->getStringDimensions(m_text);
+	m_dimensions = Math::Vec2(dimensions.getX() * m_scale.getX(), dimensions.getY() * m_scale.getY());
+}
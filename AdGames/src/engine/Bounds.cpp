@@ -0,0 +1,93 @@
+#include "Bounds.h"
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+
+#include <glad/glad.h>
+
+Onyx::Bounds Onyx::Bounds::transformed(const Math::Mat4& model) const
+{
+	glm::mat4 m = model.getMMat();
+	glm::vec3 center = (min.getMVec() + max.getMVec()) * 0.5f;
+	glm::vec3 extent = (max.getMVec() - min.getMVec()) * 0.5f;
+
+	// the extent of the transformed box along each axis is the extent projected onto the absolute value of each row of the rotation and scale
+	glm::vec3 newCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+	glm::vec3 newExtent;
+	for (int i = 0; i < 3; i++)
+	{
+		newExtent[i] = std::abs(m[0][i]) * extent.x + std::abs(m[1][i]) * extent.y + std::abs(m[2][i]) * extent.z;
+	}
+
+	return FromMinMax(Math::Vec3(newCenter - newExtent), Math::Vec3(newCenter + newExtent));
+}
+
+void Onyx::Bounds::expand(const Bounds& other)
+{
+	*this = FromMinMax(
+		Math::Vec3(glm::min(min.getMVec(), other.min.getMVec())),
+		Math::Vec3(glm::max(max.getMVec(), other.max.getMVec()))
+	);
+}
+
+Onyx::Bounds Onyx::Bounds::FromMinMax(const Math::Vec3& min, const Math::Vec3& max)
+{
+	Bounds bounds;
+	bounds.min = min;
+	bounds.max = max;
+	bounds.center = (min + max) * 0.5f;
+	bounds.radius = (max - min).magnitude() * 0.5f;
+	return bounds;
+}
+
+Onyx::Bounds Onyx::Bounds::FromSphere(const Math::Vec3& center, float radius)
+{
+	Bounds bounds;
+	bounds.min = center - Math::Vec3(radius);
+	bounds.max = center + Math::Vec3(radius);
+	bounds.center = center;
+	bounds.radius = radius;
+	return bounds;
+}
+
+Onyx::Bounds Onyx::Bounds::FromMesh(const Mesh& mesh, bool* result)
+{
+	if (result) *result = false;
+	if (mesh.getVAO() == 0) return Bounds();
+
+	// the position attribute (location 0) of the VAO says where the positions are, whatever the vertex format is
+	glBindVertexArray(mesh.getVAO());
+	int vbo = 0, stride = 0, components = 0;
+	void* offset = nullptr;
+	glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vbo);
+	glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+	glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_SIZE, &components);
+	glGetVertexAttribPointerv(0, GL_VERTEX_ATTRIB_ARRAY_POINTER, &offset);
+	glBindVertexArray(0);
+
+	if (vbo == 0) return Bounds();
+	if (stride == 0) stride = components * sizeof(float);
+
+	int size = 0;
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+	std::vector<unsigned char> data(size);
+	if (size > 0) glGetBufferSubData(GL_ARRAY_BUFFER, 0, size, data.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	size_t start = (size_t)offset;
+	if (size <= 0 || stride <= 0 || start + components * sizeof(float) > (size_t)size) return Bounds();
+
+	glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+	for (size_t i = start; i + components * sizeof(float) <= (size_t)size; i += stride)
+	{
+		const float* pos = (const float*)(data.data() + i);
+		glm::vec3 p(pos[0], components > 1 ? pos[1] : 0.0f, components > 2 ? pos[2] : 0.0f);
+		min = glm::min(min, p);
+		max = glm::max(max, p);
+	}
+
+	if (result) *result = true;
+	return FromMinMax(Math::Vec3(min), Math::Vec3(max));
+}
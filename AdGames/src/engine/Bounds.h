@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Onyx/Core.h>
+#include <Onyx/Mesh.h>
+#include <Onyx/Math.h>
+
+namespace Onyx
+{
+	/*
+		@brief An axis-aligned bounding box, along with the bounding sphere around it.
+		Bounds are computed in model space from a mesh and transformed into world space with a model matrix.
+	 */
+	struct Bounds
+	{
+		Math::Vec3 min;
+		Math::Vec3 max;
+		Math::Vec3 center;
+		float radius = 0.0f;
+
+		/*
+			@brief Transforms the bounds by the specified matrix.
+			The result is the axis-aligned box around the transformed box, so it can be larger than the tightest fit for rotated meshes.
+			@param model The matrix to transform by, generally the model matrix of a renderable.
+			@return The transformed bounds.
+		 */
+		Bounds transformed(const Math::Mat4& model) const;
+
+		/*
+			@brief Grows the bounds to also enclose the specified bounds.
+			@param other The bounds to enclose.
+		 */
+		void expand(const Bounds& other);
+
+		/*
+			@brief Creates bounds from a minimum and maximum corner.
+			@param min The minimum corner.
+			@param max The maximum corner.
+			@return The resulting bounds.
+		 */
+		static Bounds FromMinMax(const Math::Vec3& min, const Math::Vec3& max);
+
+		/*
+			@brief Creates bounds from a center and radius. The box is the cube around the sphere.
+			@param center The center of the sphere.
+			@param radius The radius of the sphere.
+			@return The resulting bounds.
+		 */
+		static Bounds FromSphere(const Math::Vec3& center, float radius);
+
+		/*
+			@brief Computes the model space bounds of a mesh by reading its vertex positions back from the GPU.
+			This stalls until the buffer can be read, so do it once when the mesh is added to something, not every frame.
+			@param mesh The mesh to compute the bounds of.
+			@param result A pointer to a boolean that will be set to true if the vertex positions could be read, and false otherwise.
+			@return The resulting bounds, or empty bounds at the origin if the positions could not be read.
+		 */
+		static Bounds FromMesh(const Mesh& mesh, bool* result = nullptr);
+	};
+}
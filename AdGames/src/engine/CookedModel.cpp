@@ -0,0 +1,221 @@
+#include "CookedModel.h"
+
+#include <filesystem>
+
+#include "MeshFile.h"
+#include "ShaderCache.h"
+
+std::unordered_map<std::string, Onyx::CookedModel> Onyx::CookedModel::sm_models;
+std::unordered_map<std::string, Onyx::Texture> Onyx::CookedModel::sm_textures;
+std::unordered_set<uint> Onyx::CookedModel::sm_vaos;
+std::unordered_set<uint> Onyx::CookedModel::sm_textureIDs;
+
+// the smallest page size of the platforms the game runs on, touching one byte per page is enough to fault a mapping in
+const ulonglong PAGE_SIZE = 4096;
+
+Onyx::CookedModel::CookedModel()
+{
+}
+
+Onyx::CookedModel Onyx::CookedModel::Load(const std::string& objPath, bool* result)
+{
+	CookedModel model;
+	MeshFile file;
+	bool loaded = (IsLoaded(objPath) || Open(objPath, file, false)) && Upload(objPath, file, model);
+	if (result) *result = loaded;
+
+	return loaded ? model : CookedModel();
+}
+
+bool Onyx::CookedModel::IsLoaded(const std::string& objPath)
+{
+	return sm_models.find(objPath) != sm_models.end();
+}
+
+bool Onyx::CookedModel::Open(const std::string& objPath, MeshFile& file, bool prefault)
+{
+	namespace fs = std::filesystem;
+
+	fs::path omeshPath = fs::path(objPath).replace_extension(".omesh");
+	std::error_code error;
+	bool cooked = fs::exists(omeshPath, error);
+	if (cooked && fs::exists(objPath, error)) cooked = fs::last_write_time(omeshPath, error) >= fs::last_write_time(objPath, error);
+	if (!cooked && !MeshFile::Cook(objPath, omeshPath.string())) return false;
+
+	bool opened = false;
+	file = MeshFile::Open(omeshPath.string(), &opened);
+	if (!opened) return false;
+
+	if (prefault)
+	{
+		const MeshFileHeader& header = file.getHeader();
+		volatile ubyte sink = 0;
+		for (uint i = 0; i < file.getSubmeshCount(); i++)
+		{
+			const MeshFileSubmesh& submesh = file.getSubmesh(i);
+			const ubyte* pVertices = (const ubyte*)file.getVertices(submesh);
+			const ubyte* pIndices = (const ubyte*)file.getIndices(submesh);
+			for (ulonglong offset = 0; offset < (ulonglong)submesh.nVertices * header.vertexStride; offset += PAGE_SIZE) sink = sink + pVertices[offset];
+			for (ulonglong offset = 0; offset < (ulonglong)submesh.nIndices * header.indexSize; offset += PAGE_SIZE) sink = sink + pIndices[offset];
+		}
+	}
+
+	return true;
+}
+
+bool Onyx::CookedModel::Upload(const std::string& objPath, MeshFile& file, CookedModel& model)
+{
+	// two loads of the same file can both get this far, the second just uses what the first uploaded
+	auto it = sm_models.find(objPath);
+	bool loaded = it != sm_models.end();
+	if (!loaded)
+	{
+		CookedModel parts;
+		loaded = UploadParts(objPath, file, parts);
+		if (loaded) it = sm_models.emplace(objPath, parts).first;
+	}
+
+	// everything is on the GPU by now, so the mapping can go
+	file.dispose();
+	if (!loaded) return false;
+
+	// copies share the meshes and textures but get their own transforms
+	model = it->second;
+	return true;
+}
+
+bool Onyx::CookedModel::UploadParts(const std::string& objPath, const MeshFile& file, CookedModel& model)
+{
+	namespace fs = std::filesystem;
+
+	const MeshFileHeader& header = file.getHeader();
+	VertexFormat format = (VertexFormat)header.vertexFormat;
+	bool textured = VertexBuffer::HasTextureCoords(format);
+	Shader shader = ShaderCache::Load(Resources(textured ? "shaders/ubo/PNT.glsl" : "shaders/ubo/PN_Color.glsl"));
+
+	// Onyx's index buffers and the RenderQueue only draw 32 bit indices, so small ones are widened here
+	std::vector<uint> wideIndices;
+	for (uint i = 0; i < file.getSubmeshCount(); i++)
+	{
+		const MeshFileSubmesh& submesh = file.getSubmesh(i);
+		if (submesh.nIndices == 0) continue;
+
+		// glBufferData copies straight out of the mapping, the vertex buffer never writes to it
+		VertexBuffer vertexBuffer((float*)file.getVertices(submesh), submesh.nVertices * header.vertexStride, format);
+
+		const void* pData = file.getIndices(submesh);
+		const uint* pIndices;
+		if (header.indexSize == 2)
+		{
+			const ushort* pSmall = (const ushort*)pData;
+			wideIndices.assign(pSmall, pSmall + submesh.nIndices);
+			pIndices = wideIndices.data();
+		}
+		else pIndices = (const uint*)pData;
+		// like the vertices, the indices are only copied by glBufferData
+		IndexBuffer indexBuffer((uint*)pIndices, submesh.nIndices * sizeof(uint));
+
+		Mesh mesh(vertexBuffer, indexBuffer);
+		sm_vaos.insert(mesh.getVAO());
+
+		const MeshFileMaterial& material = file.getMaterial(submesh);
+		Texture texture;
+		if (material.texture[0] != '\0')
+		{
+			std::string texturePath = (fs::path(objPath).parent_path() / material.texture).lexically_normal().string();
+			auto textureIt = sm_textures.find(texturePath);
+			if (textureIt == sm_textures.end())
+			{
+				textureIt = sm_textures.emplace(texturePath, Texture::Load(texturePath)).first;
+				sm_textureIDs.insert(textureIt->second.getTextureID());
+			}
+			texture = textureIt->second;
+		}
+
+		Part part = { Renderable(mesh, shader, texture), Math::Vec4(material.diffuse[0], material.diffuse[1], material.diffuse[2], material.diffuse[3]), file.getBounds(submesh) };
+		model.m_parts.push_back(part);
+	}
+
+	model.m_bounds = file.getBounds();
+
+	return !model.m_parts.empty();
+}
+
+std::vector<Onyx::CookedModel::Part>& Onyx::CookedModel::getParts()
+{
+	return m_parts;
+}
+
+const Onyx::Bounds& Onyx::CookedModel::getBounds() const
+{
+	return m_bounds;
+}
+
+const Onyx::Math::Vec3& Onyx::CookedModel::getPosition() const
+{
+	return m_parts[0].renderable.getPosition();
+}
+
+const Onyx::Math::Vec3& Onyx::CookedModel::getRotation() const
+{
+	return m_parts[0].renderable.getRotation();
+}
+
+const Onyx::Math::Vec3& Onyx::CookedModel::getScale() const
+{
+	return m_parts[0].renderable.getScale();
+}
+
+void Onyx::CookedModel::setPosition(const Math::Vec3& position)
+{
+	for (Part& part : m_parts) part.renderable.setPosition(position);
+}
+
+void Onyx::CookedModel::setRotation(const Math::Vec3& rotations)
+{
+	for (Part& part : m_parts) part.renderable.setRotation(rotations);
+}
+
+void Onyx::CookedModel::setScale(const Math::Vec3& scales)
+{
+	for (Part& part : m_parts) part.renderable.setScale(scales);
+}
+
+void Onyx::CookedModel::translate(const Math::Vec3& translation)
+{
+	for (Part& part : m_parts) part.renderable.translate(translation);
+}
+
+void Onyx::CookedModel::rotate(const Math::Vec3& rotations)
+{
+	for (Part& part : m_parts) part.renderable.rotate(rotations);
+}
+
+void Onyx::CookedModel::scale(float scalar)
+{
+	for (Part& part : m_parts) part.renderable.scale(scalar);
+}
+
+bool Onyx::CookedModel::Contains(const Mesh& mesh)
+{
+	return sm_vaos.find(mesh.getVAO()) != sm_vaos.end();
+}
+
+bool Onyx::CookedModel::Contains(const Texture& texture)
+{
+	return texture.getTextureID() != 0 && sm_textureIDs.find(texture.getTextureID()) != sm_textureIDs.end();
+}
+
+void Onyx::CookedModel::Clear()
+{
+	for (auto& [path, model] : sm_models)
+	{
+		for (Part& part : model.m_parts) part.renderable.getMesh()->dispose();
+	}
+	for (auto& [path, texture] : sm_textures) texture.dispose();
+
+	sm_models.clear();
+	sm_textures.clear();
+	sm_vaos.clear();
+	sm_textureIDs.clear();
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <Onyx/Core.h>
+#include <Onyx/Renderable.h>
+#include <Onyx/Texture.h>
+#include <Onyx/Math.h>
+
+#include "Bounds.h"
+#include "MeshFile.h"
+
+namespace Onyx
+{
+	/*
+		@brief A model loaded from a cooked mesh (.omesh) file, drawn as one renderable per submesh.
+		The replacement for Model and ModelRenderable: the cooked file is memory mapped and handed to the GPU as it is,
+		and each part carries its material color and bounds, so adding it to a RenderQueue reads nothing back from the GPU.
+		Meshes and textures are loaded once per file and shared by every model loaded from it, the same way as the PrimitiveCache.
+		AssetLoader::LoadModel() loads a model without stalling the main thread on the disk.
+		Call Clear() before the GL context is destroyed.
+	 */
+	class CookedModel
+	{
+		friend class AssetLoader;
+	public:
+		/*
+			@brief A submesh of the model.
+		 */
+		struct Part
+		{
+			Renderable renderable;
+			Math::Vec4 color;
+			Bounds bounds;
+		};
+
+		/*
+			@brief Default constructor, creates a model with no parts.
+		 */
+		CookedModel();
+
+		/*
+			@brief Loads the cooked version of an OBJ file, which is the file with the same name and the extension .omesh.
+			If it doesn't exist or is older than the OBJ file, it is cooked from the OBJ file first (see MeshFile::Cook()).
+			@param objPath The path of the OBJ file.
+			@param result A pointer to a boolean that will be set to true if the model was loaded, and false otherwise.
+			@return The model, with its own transform.
+		 */
+		static CookedModel Load(const std::string& objPath, bool* result = nullptr);
+
+		/*
+			@brief Gets whether the model of an OBJ file is loaded, in which case Load() returns it without touching the disk.
+			@param objPath The path of the OBJ file.
+			@return True if the model is loaded, false if not.
+		 */
+		static bool IsLoaded(const std::string& objPath);
+
+		/*
+			@brief Gets the parts of the model.
+			Pass each part to RenderQueue::add() with its color and bounds to draw the model.
+			@return The parts.
+		 */
+		std::vector<Part>& getParts();
+
+		/*
+			@brief Gets the model space bounds of the whole model.
+			@return The bounds.
+		 */
+		const Bounds& getBounds() const;
+
+		/*
+			@brief Gets the position of the model.
+			@return The position.
+		 */
+		const Math::Vec3& getPosition() const;
+
+		/*
+			@brief Gets the rotation of the model.
+			@return The rotation around each axis.
+		 */
+		const Math::Vec3& getRotation() const;
+
+		/*
+			@brief Gets the scale of the model.
+			@return The scale on each axis.
+		 */
+		const Math::Vec3& getScale() const;
+
+		/*
+			@brief Sets the position of the model.
+			@param position The new position.
+		 */
+		void setPosition(const Math::Vec3& position);
+
+		/*
+			@brief Sets the rotation of the model.
+			@param rotations The new rotation around each axis.
+		 */
+		void setRotation(const Math::Vec3& rotations);
+
+		/*
+			@brief Sets the scale of the model.
+			@param scales The new scale for each axis.
+		 */
+		void setScale(const Math::Vec3& scales);
+
+		/*
+			@brief Translates the model by the specified positional amount in world space.
+			@param translation The positional amount to translate by.
+		 */
+		void translate(const Math::Vec3& translation);
+
+		/*
+			@brief Rotates the model by the specified rotation amounts.
+			@param rotations The rotation amounts around each axis.
+		 */
+		void rotate(const Math::Vec3& rotations);
+
+		/*
+			@brief Scales the model uniformly by the specified amount.
+			@param scalar The amount to scale by.
+		 */
+		void scale(float scalar);
+
+		/*
+			@brief Checks whether a mesh is owned by the cache of loaded models.
+			@param mesh The mesh to check.
+			@return True if the mesh is owned by the cache, false otherwise.
+		 */
+		static bool Contains(const Mesh& mesh);
+
+		/*
+			@brief Checks whether a texture is owned by the cache of loaded models.
+			@param texture The texture to check.
+			@return True if the texture is owned by the cache, false otherwise.
+		 */
+		static bool Contains(const Texture& texture);
+
+		/*
+			@brief Disposes every cached mesh and texture. Models loaded before this must not be drawn afterwards.
+		 */
+		static void Clear();
+
+	private:
+		std::vector<Part> m_parts;
+		Bounds m_bounds;
+
+		// the untransformed parts of every loaded file, copied into each model loaded from it
+		static std::unordered_map<std::string, CookedModel> sm_models;
+		static std::unordered_map<std::string, Texture> sm_textures;
+		static std::unordered_set<uint> sm_vaos;
+		static std::unordered_set<uint> sm_textureIDs;
+
+		// cooks the file if it has to and maps it, which touches no GL state, so it can run on any thread
+		// prefault reads every page of the mapping, so a worker can fault the file in rather than the upload
+		static bool Open(const std::string& objPath, MeshFile& file, bool prefault);
+		// gets the cached model, or uploads the mapped file's parts and caches them, then unmaps the file
+		static bool Upload(const std::string& objPath, MeshFile& file, CookedModel& model);
+		static bool UploadParts(const std::string& objPath, const MeshFile& file, CookedModel& model);
+	};
+}
@@ -0,0 +1,138 @@
+#include "FontCache.h"
+
+std::unordered_map<std::string, Onyx::FontCache::Entry> Onyx::FontCache::sm_fonts;
+
+Onyx::AtlasFont Onyx::FontCache::Get(const std::string& ttfFilePath, uint size, bool* result)
+{
+	return Acquire(ttfFilePath, size, false, result);
+}
+
+Onyx::AtlasFont Onyx::FontCache::GetSDF(const std::string& ttfFilePath, uint size, bool* result)
+{
+	return Acquire(ttfFilePath, size, true, result);
+}
+
+Onyx::AssetHandle<Onyx::AtlasFont> Onyx::FontCache::Load(const std::string& ttfFilePath, uint size, bool sdf)
+{
+	std::string key = Key(ttfFilePath, size, sdf);
+
+	auto it = sm_fonts.find(key);
+	if (it != sm_fonts.end())
+	{
+		it->second.refCount++;
+		return it->second.font;
+	}
+
+	Entry entry;
+	entry.font = AssetLoader::LoadFont(ttfFilePath, size, sdf, entry.group);
+	entry.refCount = 1;
+	sm_fonts[key] = entry;
+
+	return entry.font;
+}
+
+void Onyx::FontCache::Release(const AtlasFont& font)
+{
+	auto it = Find(font);
+	if (it != sm_fonts.end()) Unref(it);
+}
+
+void Onyx::FontCache::Release(const AssetHandle<AtlasFont>& font)
+{
+	for (auto it = sm_fonts.begin(); it != sm_fonts.end(); ++it)
+	{
+		if (it->second.font == font)
+		{
+			Unref(it);
+			return;
+		}
+	}
+}
+
+bool Onyx::FontCache::Contains(const AtlasFont& font)
+{
+	return GetRefCount(font) > 0;
+}
+
+uint Onyx::FontCache::GetRefCount(const AtlasFont& font)
+{
+	auto it = Find(font);
+	return it != sm_fonts.end() ? it->second.refCount : 0;
+}
+
+uint Onyx::FontCache::GetCount()
+{
+	return sm_fonts.size();
+}
+
+void Onyx::FontCache::Clear()
+{
+	for (auto& [key, entry] : sm_fonts)
+	{
+		if (entry.font.isLoaded()) entry.font.get().dispose();
+		else AssetLoader::Cancel(entry.group);
+	}
+
+	sm_fonts.clear();
+}
+
+Onyx::AtlasFont Onyx::FontCache::Acquire(const std::string& ttfFilePath, uint size, bool sdf, bool* result)
+{
+	std::string key = Key(ttfFilePath, size, sdf);
+
+	auto it = sm_fonts.find(key);
+	if (it != sm_fonts.end())
+	{
+		// the upload happens on this thread, so waiting for a font someone else is loading means doing the uploads here
+		while (it->second.font.getState() == AssetState::Pending)
+		{
+			AssetLoader::Update();
+			std::this_thread::yield();
+		}
+
+		if (it->second.font.isLoaded())
+		{
+			it->second.refCount++;
+			if (result) *result = true;
+			return it->second.font.get();
+		}
+
+		// the failed load's holders keep their handle, the next Get() or Load() tries again
+		sm_fonts.erase(it);
+	}
+
+	bool loaded = false;
+	AtlasFont font = sdf ? AtlasFont::LoadSDF(ttfFilePath, size, &loaded) : AtlasFont::Load(ttfFilePath, size, &loaded);
+	if (result) *result = loaded;
+
+	// a font that failed to load isn't cached, so the next Get() tries again
+	if (!loaded) return font;
+
+	sm_fonts[key] = Entry{ AssetHandle<AtlasFont>(font), AssetGroup(), 1 };
+
+	return font;
+}
+
+std::string Onyx::FontCache::Key(const std::string& ttfFilePath, uint size, bool sdf)
+{
+	// the size and mode come after the last separator in the path, so two different fonts never produce the same key
+	return ttfFilePath + '|' + std::to_string(size) + (sdf ? "|sdf" : "");
+}
+
+std::unordered_map<std::string, Onyx::FontCache::Entry>::iterator Onyx::FontCache::Find(const AtlasFont& font)
+{
+	auto it = sm_fonts.find(Key(font.getTtfFilePath(), font.getSize(), font.isSDF()));
+	if (it == sm_fonts.end() || !it->second.font.isLoaded() || it->second.font.get().getTextureID() != font.getTextureID()) return sm_fonts.end();
+
+	return it;
+}
+
+void Onyx::FontCache::Unref(std::unordered_map<std::string, Entry>::iterator it)
+{
+	if (--it->second.refCount > 0) return;
+
+	// nothing is halfway through its upload here, so a font that isn't loaded yet has no GL objects to leak
+	if (it->second.font.isLoaded()) it->second.font.get().dispose();
+	else AssetLoader::Cancel(it->second.group);
+	sm_fonts.erase(it);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <Onyx/Core.h>
+
+#include "AtlasFont.h"
+#include "AssetLoader.h"
+
+namespace Onyx
+{
+	/*
+		@brief A registry of atlas fonts, keyed by their TrueType font file, size and whether they are SDF fonts, with a reference count per font.
+		Getting a font that is already loaded gives back the same atlas instead of rasterizing every glyph again,
+		and the atlas is disposed when the last user releases it.
+		Fonts can also be loaded in the background with Load(), after which Get() gives back the same atlas without waiting.
+		Fonts from it must not be disposed directly, pair every Get() and Load() with a Release().
+		Call Clear() before the GL context is destroyed.
+	 */
+	class FontCache
+	{
+	public:
+		/*
+			@brief Gets the font for a TrueType font file and size, loading it if it isn't cached yet, and adds a reference to it.
+			If the font is still loading from a Load(), this waits for it, doing the AssetLoader's uploads meanwhile.
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param result A pointer to a boolean that will be set to true if the font was found or loaded successfully, and false otherwise.
+			@return The shared font.
+		 */
+		static AtlasFont Get(const std::string& ttfFilePath, uint size, bool* result = nullptr);
+
+		/*
+			@brief Gets the SDF font for a TrueType font file and size, loading it with AtlasFont::LoadSDF() if it isn't cached yet, and adds a reference to it.
+			If the font is still loading from a Load(), this waits for it, doing the AssetLoader's uploads meanwhile.
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param result A pointer to a boolean that will be set to true if the font was found or loaded successfully, and false otherwise.
+			@return The shared font.
+		 */
+		static AtlasFont GetSDF(const std::string& ttfFilePath, uint size, bool* result = nullptr);
+
+		/*
+			@brief Gets the font for a TrueType font file and size, loading it through the AssetLoader if it isn't cached yet, and adds a reference to it.
+			Release the reference with Release(const AssetHandle<AtlasFont>&), whether or not the font has finished loading.
+			@param ttfFilePath The path of the TrueType font file.
+			@param size The size of the font.
+			@param sdf Whether to load it as an SDF font, see AtlasFont::LoadSDF().
+			@return The handle to the shared font.
+		 */
+		static AssetHandle<AtlasFont> Load(const std::string& ttfFilePath, uint size, bool sdf = false);
+
+		/*
+			@brief Removes a reference to a font, disposing it if it was the last one.
+			Does nothing if the font isn't from the cache.
+			@param font The font to release.
+		 */
+		static void Release(const AtlasFont& font);
+
+		/*
+			@brief Removes a reference taken with Load(). If it was the last one, the font is disposed, or its load is cancelled if it hasn't finished.
+			Does nothing if the handle isn't from the cache.
+			@param font The handle to release.
+		 */
+		static void Release(const AssetHandle<AtlasFont>& font);
+
+		/*
+			@brief Gets whether a font belongs to the cache.
+			@param font The font to check.
+			@return True if the font is shared through the cache, false if not.
+		 */
+		static bool Contains(const AtlasFont& font);
+
+		/*
+			@brief Gets the number of references to a font.
+			@param font The font.
+			@return The number of references, or 0 if the font isn't from the cache.
+		 */
+		static uint GetRefCount(const AtlasFont& font);
+
+		/*
+			@brief Gets the number of fonts in the cache, including the ones still loading.
+			@return The number of fonts.
+		 */
+		static uint GetCount();
+
+		/*
+			@brief Disposes every font in the cache, regardless of its references, and cancels the ones still loading.
+		 */
+		static void Clear();
+
+	private:
+		struct Entry
+		{
+			AssetHandle<AtlasFont> font;
+			// each font loads in its own group, so releasing one that is still loading cancels only that one
+			AssetGroup group;
+			uint refCount;
+		};
+
+		static AtlasFont Acquire(const std::string& ttfFilePath, uint size, bool sdf, bool* result);
+		static std::string Key(const std::string& ttfFilePath, uint size, bool sdf);
+		static std::unordered_map<std::string, Entry>::iterator Find(const AtlasFont& font);
+		static void Unref(std::unordered_map<std::string, Entry>::iterator it);
+
+		static std::unordered_map<std::string, Entry> sm_fonts;
+	};
+}
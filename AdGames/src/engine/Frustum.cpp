@@ -0,0 +1,60 @@
+#include "Frustum.h"
+
+Onyx::Frustum::Frustum()
+{
+	for (int i = 0; i < 6; i++) m_planes[i] = Math::Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+Onyx::Frustum::Frustum(const Math::Mat4& viewProj)
+{
+	// each plane is the fourth row of the matrix plus or minus one of the other rows (Gribb & Hartmann)
+	glm::mat4 m = viewProj.getMMat();
+	glm::vec4 row[4];
+	for (int i = 0; i < 4; i++) row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+	glm::vec4 planes[6] = {
+		row[3] + row[0],
+		row[3] - row[0],
+		row[3] + row[1],
+		row[3] - row[1],
+		row[3] + row[2],
+		row[3] - row[2]
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		float length = glm::length(glm::vec3(planes[i]));
+		m_planes[i] = Math::Vec4(length > 0.0f ? planes[i] / length : planes[i]);
+	}
+}
+
+bool Onyx::Frustum::intersects(const Bounds& bounds) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		const glm::vec4& plane = m_planes[i].getMVec();
+		glm::vec3 normal(plane);
+
+		if (glm::dot(normal, bounds.center.getMVec()) + plane.w < -bounds.radius) return false;
+
+		// the corner of the box furthest along the normal, if it's outside then the whole box is
+		glm::vec3 corner(
+			normal.x >= 0.0f ? bounds.max.getX() : bounds.min.getX(),
+			normal.y >= 0.0f ? bounds.max.getY() : bounds.min.getY(),
+			normal.z >= 0.0f ? bounds.max.getZ() : bounds.min.getZ()
+		);
+		if (glm::dot(normal, corner) + plane.w < 0.0f) return false;
+	}
+
+	return true;
+}
+
+const Onyx::Math::Vec4& Onyx::Frustum::getPlane(int index) const
+{
+	return m_planes[index];
+}
+
+Onyx::Frustum Onyx::Frustum::FromCamera(const Camera& cam)
+{
+	return Frustum(cam.getProjectionMatrix() * cam.getViewMatrix());
+}
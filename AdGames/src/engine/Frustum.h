@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Onyx/Core.h>
+#include <Onyx/Camera.h>
+#include <Onyx/Math.h>
+
+#include "Bounds.h"
+
+namespace Onyx
+{
+	/*
+		@brief A class to represent the six planes of a camera's view volume, used to skip drawing things the camera can't see.
+		Works for both perspective and orthographic projections.
+	 */
+	class Frustum
+	{
+	public:
+		/*
+			@brief Default constructor, creates a frustum that contains everything.
+		 */
+		Frustum();
+
+		/*
+			@brief Creates a frustum from a combined projection and view matrix.
+			@param viewProj The projection matrix multiplied by the view matrix.
+		 */
+		Frustum(const Math::Mat4& viewProj);
+
+		/*
+			@brief Gets whether any part of the bounds could be inside the frustum.
+			The sphere is tested first since it's cheaper, then the box for a tighter fit.
+			@param bounds The world space bounds to test.
+			@return False if the bounds are completely outside the frustum, true otherwise.
+		 */
+		bool intersects(const Bounds& bounds) const;
+
+		/*
+			@brief Gets one of the planes of the frustum, in the order left, right, bottom, top, near, far.
+			The xyz components are the normal, pointing into the frustum, and w is the distance, so points inside satisfy dot(normal, p) + w >= 0.
+			@param index The index of the plane, from 0 to 5.
+			@return The plane.
+		 */
+		const Math::Vec4& getPlane(int index) const;
+
+		/*
+			@brief Creates the frustum of a camera, using its current view and projection matrices.
+			@param cam The camera.
+			@return The resulting frustum.
+		 */
+		static Frustum FromCamera(const Camera& cam);
+
+	private:
+		Math::Vec4 m_planes[6];
+	};
+}
@@ -0,0 +1,74 @@
+#include "GameLoop.h"
+
+#include <cmath>
+
+Onyx::GameLoop::GameLoop()
+	: GameLoop(60.0)
+{
+}
+
+Onyx::GameLoop::GameLoop(double tickRate, uint maxSteps)
+{
+	m_fixedDt = 1.0 / tickRate;
+	m_accumulator = 0.0;
+	m_droppedTime = 0.0;
+	m_maxSteps = maxSteps > 0 ? maxSteps : 1;
+}
+
+uint Onyx::GameLoop::advance(double frameDt)
+{
+	if (frameDt > 0.0) m_accumulator += frameDt;
+
+	double steps = std::floor(m_accumulator / m_fixedDt);
+	if (steps > m_maxSteps)
+	{
+		// keep the fraction of a tick so the interpolation doesn't jump, drop the whole ticks past the cap
+		double excess = (steps - m_maxSteps) * m_fixedDt;
+		m_droppedTime += excess;
+		m_accumulator -= excess;
+		steps = m_maxSteps;
+	}
+
+	m_accumulator -= steps * m_fixedDt;
+	return (uint)steps;
+}
+
+double Onyx::GameLoop::getAlpha() const
+{
+	return m_accumulator / m_fixedDt;
+}
+
+double Onyx::GameLoop::getFixedDt() const
+{
+	return m_fixedDt;
+}
+
+double Onyx::GameLoop::getTickRate() const
+{
+	return 1.0 / m_fixedDt;
+}
+
+void Onyx::GameLoop::setTickRate(double tickRate)
+{
+	m_fixedDt = 1.0 / tickRate;
+}
+
+uint Onyx::GameLoop::getMaxSteps() const
+{
+	return m_maxSteps;
+}
+
+void Onyx::GameLoop::setMaxSteps(uint maxSteps)
+{
+	m_maxSteps = maxSteps > 0 ? maxSteps : 1;
+}
+
+double Onyx::GameLoop::getDroppedTime() const
+{
+	return m_droppedTime;
+}
+
+void Onyx::GameLoop::reset()
+{
+	m_accumulator = 0.0;
+}
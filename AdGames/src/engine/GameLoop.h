@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	/*
+		@brief A fixed timestep accumulator, to run a simulation at a constant tick rate whatever the frame rate is.
+		Each frame, advance() adds the frame's time and returns how many ticks of getFixedDt() to run,
+		then getAlpha() says how far between the last two ticks the frame is, to interpolate what is drawn.
+		The number of ticks per frame is capped, so a long frame (a hitch, a loading screen) drops time instead of running a burst of ticks that makes the next frame long too.
+	 */
+	class GameLoop
+	{
+	public:
+		/*
+			@brief The default cap on ticks per frame.
+		 */
+		static const uint DEFAULT_MAX_STEPS = 5;
+
+		/*
+			@brief Default constructor, creates a loop ticking 60 times a second.
+		 */
+		GameLoop();
+
+		/*
+			@brief Creates a loop with the specified tick rate.
+			@param tickRate The number of ticks per second.
+			@param maxSteps The most ticks advance() returns for one frame.
+		 */
+		GameLoop(double tickRate, uint maxSteps = DEFAULT_MAX_STEPS);
+
+		/*
+			@brief Adds a frame's time to the accumulator and takes out as many whole ticks as fit, up to the cap.
+			@param frameDt The time since the last frame, in seconds.
+			@return The number of ticks to run this frame.
+		 */
+		uint advance(double frameDt);
+
+		/*
+			@brief Gets how far the time left in the accumulator is into the next tick.
+			Draw at lerp(previous state, current state, alpha) to hide the steps between ticks.
+			@return The interpolation factor, from 0 up to (not including) 1.
+		 */
+		double getAlpha() const;
+
+		/*
+			@brief Gets the time simulated by one tick.
+			@return The tick length, in seconds.
+		 */
+		double getFixedDt() const;
+
+		/*
+			@brief Gets the number of ticks per second.
+			@return The tick rate.
+		 */
+		double getTickRate() const;
+
+		/*
+			@brief Sets the number of ticks per second. The time already accumulated is kept.
+			@param tickRate The tick rate.
+		 */
+		void setTickRate(double tickRate);
+
+		/*
+			@brief Gets the cap on ticks per frame.
+			@return The most ticks advance() returns for one frame.
+		 */
+		uint getMaxSteps() const;
+
+		/*
+			@brief Sets the cap on ticks per frame.
+			@param maxSteps The most ticks advance() returns for one frame, at least 1.
+		 */
+		void setMaxSteps(uint maxSteps);
+
+		/*
+			@brief Gets the total time dropped because a frame needed more ticks than the cap.
+			@return The dropped time, in seconds.
+		 */
+		double getDroppedTime() const;
+
+		/*
+			@brief Empties the accumulator, for when the time since the last frame shouldn't be simulated (e.g. after loading).
+		 */
+		void reset();
+
+	private:
+		double m_fixedDt;
+		double m_accumulator;
+		double m_droppedTime;
+		uint m_maxSteps;
+	};
+}
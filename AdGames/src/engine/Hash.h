@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string_view>
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	/*
+		@brief Hashes a string with 32-bit FNV-1a.
+		Usable at compile time, so string literals can be hashed without any runtime cost.
+		@param str The string to hash.
+		@return The hash.
+	 */
+	constexpr uint HashFNV1a32(std::string_view str)
+	{
+		uint hash = 2166136261u;
+		for (char c : str)
+		{
+			hash ^= (unsigned char)c;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	/*
+		@brief Hashes a string with 64-bit FNV-1a.
+		Usable at compile time, so string literals can be hashed without any runtime cost.
+		@param str The string to hash.
+		@return The hash.
+	 */
+	constexpr ulonglong HashFNV1a64(std::string_view str)
+	{
+		ulonglong hash = 14695981039346656037ull;
+		for (char c : str)
+		{
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
@@ -0,0 +1,56 @@
+#include "Image.h"
+
+#include <cstring>
+
+// Onyx keeps its own copy of stb_image inside the DLL and doesn't export it
+#define STB_IMAGE_IMPLEMENTATION
+#include <stbi/stb_image.h>
+
+Onyx::Image::Image()
+{
+	m_width = m_height = 0;
+}
+
+Onyx::Image Onyx::Image::Load(const std::string& filepath, bool flipVertically, bool* result)
+{
+	Image image;
+
+	// the thread local flag, the global one would race with images decoded on other threads
+	stbi_set_flip_vertically_on_load_thread(flipVertically);
+
+	int nChannels = 0;
+	stbi_uc* pData = stbi_load(filepath.c_str(), &image.m_width, &image.m_height, &nChannels, 4);
+	if (!pData)
+	{
+		image.m_width = image.m_height = 0;
+		if (result) *result = false;
+		return image;
+	}
+
+	image.m_pixels.resize((size_t)image.m_width * image.m_height * 4);
+	memcpy(image.m_pixels.data(), pData, image.m_pixels.size());
+	stbi_image_free(pData);
+
+	if (result) *result = true;
+	return image;
+}
+
+int Onyx::Image::getWidth() const
+{
+	return m_width;
+}
+
+int Onyx::Image::getHeight() const
+{
+	return m_height;
+}
+
+const std::vector<ubyte>& Onyx::Image::getPixels() const
+{
+	return m_pixels;
+}
+
+ulonglong Onyx::Image::getByteSize() const
+{
+	return m_pixels.size();
+}
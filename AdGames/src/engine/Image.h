@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	/*
+		@brief A class to represent a decoded image in CPU memory, always with 4 channels (RGBA) of 8 bits each.
+		Decoding touches no GL state, so images can be loaded on any thread and uploaded later, see Texture2D and AssetLoader.
+	 */
+	class Image
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+			Use the static Load() function to create a valid image.
+		 */
+		Image();
+
+		/*
+			@brief Loads and decodes an image file (PNG, JPEG, BMP, TGA, ...).
+			@param filepath The path of the image.
+			@param flipVertically Whether the first row should be the bottom of the image, which is what OpenGL textures expect.
+			@param result A pointer to a boolean that will be set to true if the image was decoded successfully, and false otherwise.
+			@return The image.
+		 */
+		static Image Load(const std::string& filepath, bool flipVertically, bool* result = nullptr);
+
+		/*
+			@brief Gets the width of the image.
+			@return The width, in pixels.
+		 */
+		int getWidth() const;
+
+		/*
+			@brief Gets the height of the image.
+			@return The height, in pixels.
+		 */
+		int getHeight() const;
+
+		/*
+			@brief Gets the pixels of the image, row by row, 4 bytes per pixel.
+			@return The pixels.
+		 */
+		const std::vector<ubyte>& getPixels() const;
+
+		/*
+			@brief Gets the size of the pixel data.
+			@return The size, in bytes.
+		 */
+		ulonglong getByteSize() const;
+
+	private:
+		int m_width, m_height;
+		std::vector<ubyte> m_pixels;
+	};
+}
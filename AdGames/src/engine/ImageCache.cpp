@@ -0,0 +1,168 @@
+#include "ImageCache.h"
+
+std::unordered_map<std::string, Onyx::ImageCache::Entry> Onyx::ImageCache::sm_images;
+std::list<std::string> Onyx::ImageCache::sm_unused;
+ulonglong Onyx::ImageCache::sm_budget = Onyx::ImageCache::DEFAULT_BUDGET;
+std::mutex Onyx::ImageCache::sm_mutex;
+
+Onyx::AssetHandle<Onyx::Image> Onyx::ImageCache::Get(const std::string& filepath, bool flipVertically)
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	std::string key = Key(filepath, flipVertically);
+
+	auto it = sm_images.find(key);
+	// a failed or cancelled decode is tried again
+	if (it != sm_images.end() && it->second.image.isFailed())
+	{
+		if (it->second.refCount == 0) sm_unused.erase(it->second.unusedIt);
+		sm_images.erase(it);
+		it = sm_images.end();
+	}
+
+	if (it != sm_images.end())
+	{
+		Entry& entry = it->second;
+		if (entry.refCount++ == 0) sm_unused.erase(entry.unusedIt);
+		return entry.image;
+	}
+
+	Entry& entry = sm_images[key];
+	entry.image = AssetLoader::DecodeImage(filepath, flipVertically);
+	entry.refCount = 1;
+
+	return entry.image;
+}
+
+void Onyx::ImageCache::Release(const std::string& filepath, bool flipVertically)
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	std::string key = Key(filepath, flipVertically);
+
+	auto it = sm_images.find(key);
+	if (it == sm_images.end() || it->second.refCount == 0) return;
+
+	Entry& entry = it->second;
+	if (--entry.refCount > 0) return;
+
+	sm_unused.push_front(key);
+	entry.unusedIt = sm_unused.begin();
+
+	Trim();
+}
+
+Onyx::AssetHandle<Onyx::Texture2D> Onyx::ImageCache::GetTexture(const std::string& filepath, TextureWrap textureWrap, TextureFilter minFilter, TextureFilter magFilter, const AssetGroup& group)
+{
+	// the upload holds on to the image handle itself, so the reference is only needed to mark the image as recently used
+	AssetHandle<Image> image = Get(filepath, true);
+	AssetHandle<Texture2D> texture = AssetLoader::UploadTexture(image, textureWrap, minFilter, magFilter, group);
+	Release(filepath, true);
+
+	return texture;
+}
+
+bool Onyx::ImageCache::SetWindowIcon(Window& window, const std::vector<std::string>& filepaths, bool wait)
+{
+	std::vector<AssetHandle<Image>> images;
+	for (const std::string& filepath : filepaths) images.push_back(Get(filepath));
+
+	bool ready = true;
+	for (const AssetHandle<Image>& image : images)
+	{
+		if (wait) image.wait();
+		else if (image.getState() == AssetState::Pending) ready = false;
+	}
+
+	if (ready)
+	{
+		std::vector<GLFWimage> glfwImages;
+		for (const AssetHandle<Image>& image : images)
+		{
+			if (!image.isLoaded()) continue;
+			glfwImages.push_back(GLFWimage{ image.get().getWidth(), image.get().getHeight(), (unsigned char*)image.get().getPixels().data() });
+		}
+
+		// GLFW copies the pixels, so the images can be released right away
+		if (!glfwImages.empty()) glfwSetWindowIcon(window.getGlfwWindowPtr(), (int)glfwImages.size(), glfwImages.data());
+	}
+
+	for (const std::string& filepath : filepaths) Release(filepath);
+
+	return ready;
+}
+
+void Onyx::ImageCache::SetBudget(ulonglong bytes)
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	sm_budget = bytes;
+	Trim();
+}
+
+ulonglong Onyx::ImageCache::GetBudget()
+{
+	return sm_budget;
+}
+
+ulonglong Onyx::ImageCache::GetByteSize()
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	ulonglong total = 0;
+	for (const auto& [key, entry] : sm_images) total += ByteSize(entry);
+	return total;
+}
+
+bool Onyx::ImageCache::Contains(const std::string& filepath, bool flipVertically)
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	return sm_images.find(Key(filepath, flipVertically)) != sm_images.end();
+}
+
+uint Onyx::ImageCache::GetCount()
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	return sm_images.size();
+}
+
+void Onyx::ImageCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(sm_mutex);
+
+	sm_images.clear();
+	sm_unused.clear();
+}
+
+std::string Onyx::ImageCache::Key(const std::string& filepath, bool flipVertically)
+{
+	return flipVertically ? filepath + "|flipped" : filepath;
+}
+
+ulonglong Onyx::ImageCache::ByteSize(const Entry& entry)
+{
+	// an image that is still decoding has no size yet, and can't be dropped either
+	return entry.image.isLoaded() ? entry.image.get().getByteSize() : 0;
+}
+
+void Onyx::ImageCache::Trim()
+{
+	ulonglong unusedBytes = 0;
+	for (const std::string& key : sm_unused) unusedBytes += ByteSize(sm_images[key]);
+
+	// oldest first, images still decoding are skipped
+	auto it = sm_unused.end();
+	while (unusedBytes > sm_budget && it != sm_unused.begin())
+	{
+		--it;
+		auto entryIt = sm_images.find(*it);
+		ulonglong size = ByteSize(entryIt->second);
+		if (size == 0) continue;
+
+		unusedBytes -= size;
+		sm_images.erase(entryIt);
+		it = sm_unused.erase(it);
+	}
+}
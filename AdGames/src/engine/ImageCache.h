@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <Onyx/Core.h>
+#include <Onyx/Window.h>
+
+#include "AssetLoader.h"
+
+namespace Onyx
+{
+	/*
+		@brief A registry of decoded images, keyed by their path, with a reference count per image and a memory budget for the unused ones.
+		Images are decoded once through the AssetLoader and kept in CPU memory, so it outlives Onyx::Init() and Onyx::Terminate()
+		and a texture or window icon can be recreated for every new GL context without decoding the file again.
+		Images nobody holds a reference to stay cached until the unused ones exceed the budget, then the least recently used are dropped first.
+		Handles keep their image alive even after it is dropped, so dropping one never invalidates anything.
+		The cache can be used from any thread.
+	 */
+	class ImageCache
+	{
+	public:
+		/*
+			@brief The default budget for images nobody holds a reference to.
+		 */
+		static const ulonglong DEFAULT_BUDGET = 64ull * 1024 * 1024;
+
+		/*
+			@brief Gets the image at a path, decoding it in the background if it isn't cached yet, and adds a reference to it.
+			@param filepath The path of the image.
+			@param flipVertically Whether the first row should be the bottom of the image, which is what OpenGL textures expect. Flipped and unflipped images are cached separately.
+			@return The handle to the image.
+		 */
+		static AssetHandle<Image> Get(const std::string& filepath, bool flipVertically = false);
+
+		/*
+			@brief Removes a reference to an image. It stays cached, and is dropped once it is the least recently used image over the budget.
+			@param filepath The path of the image.
+			@param flipVertically Whether the image was requested flipped.
+		 */
+		static void Release(const std::string& filepath, bool flipVertically = false);
+
+		/*
+			@brief Creates a texture from the image at a path, decoding it only if it isn't cached yet. The texture is uploaded in a later AssetLoader::Update().
+			The texture belongs to the caller and must be disposed, the image itself needs no Release().
+			@param filepath The path of the image.
+			@param textureWrap The texture wrap option. Repeat by default.
+			@param minFilter The minification filter (applied when the texture is shrunk). Nearest by default.
+			@param magFilter The magnification filter (applied when the texture is enlarged). Linear by default.
+			@param group The group the upload belongs to. The image is shared, so cancelling the group only cancels the upload.
+			@return The handle to the texture.
+		 */
+		static AssetHandle<Texture2D> GetTexture(const std::string& filepath, TextureWrap textureWrap = TextureWrap::Repeat, TextureFilter minFilter = TextureFilter::Nearest, TextureFilter magFilter = TextureFilter::Linear, const AssetGroup& group = AssetGroup());
+
+		/*
+			@brief Sets a window's icon from the images at the specified paths, decoding only the ones that aren't cached yet.
+			Onyx's WindowIcon decodes its files every time, this hands the cached pixels straight to GLFW.
+			@param window The window.
+			@param filepaths The paths of the images, ideally a 16x16, 24x24, 32x32, 48x48, and 256x256 image.
+			@param wait Whether to wait for images that are still being decoded. If false and some are, the icon isn't set.
+			@return True if the icon was set, false if not.
+		 */
+		static bool SetWindowIcon(Window& window, const std::vector<std::string>& filepaths, bool wait = true);
+
+		/*
+			@brief Sets the budget for images nobody holds a reference to, dropping images if they are over it.
+			@param bytes The budget, in bytes.
+		 */
+		static void SetBudget(ulonglong bytes);
+
+		/*
+			@brief Gets the budget for images nobody holds a reference to.
+			@return The budget, in bytes.
+		 */
+		static ulonglong GetBudget();
+
+		/*
+			@brief Gets the size of every decoded image in the cache.
+			@return The size, in bytes.
+		 */
+		static ulonglong GetByteSize();
+
+		/*
+			@brief Gets whether the image at a path is cached.
+			@param filepath The path of the image.
+			@param flipVertically Whether the image was requested flipped.
+			@return True if the image is cached, false if not.
+		 */
+		static bool Contains(const std::string& filepath, bool flipVertically = false);
+
+		/*
+			@brief Gets the number of images in the cache.
+			@return The number of images.
+		 */
+		static uint GetCount();
+
+		/*
+			@brief Drops every image from the cache, regardless of its references.
+		 */
+		static void Clear();
+
+	private:
+		struct Entry
+		{
+			AssetHandle<Image> image;
+			uint refCount;
+			// position in sm_unused, only valid while refCount is 0
+			std::list<std::string>::iterator unusedIt;
+		};
+
+		static std::string Key(const std::string& filepath, bool flipVertically);
+		static ulonglong ByteSize(const Entry& entry);
+		static void Trim();
+
+		static std::unordered_map<std::string, Entry> sm_images;
+		// unused images, most recently used first
+		static std::list<std::string> sm_unused;
+		static ulonglong sm_budget;
+		static std::mutex sm_mutex;
+	};
+}
@@ -0,0 +1,126 @@
+#include "InstancedRenderable.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "ShaderCache.h"
+
+// attribute locations 0-3 are used by the vertex formats, so the instance attributes start after them
+const uint INSTANCE_COLOR_LOCATION = 4;
+const uint INSTANCE_MODEL_LOCATION = 5;
+
+Onyx::InstancedRenderable::InstancedRenderable()
+{
+	m_instanceVBO = 0;
+	m_capacity = 0;
+}
+
+Onyx::InstancedRenderable::InstancedRenderable(Mesh mesh, uint capacity, bool* result)
+{
+	m_mesh = mesh;
+	m_shader = ShaderCache::Load(Resources("shaders/ubo/P_Color_Instanced.glsl"), result);
+	m_capacity = capacity > 0 ? capacity : 1;
+	m_instances.reserve(m_capacity);
+
+	glGenBuffers(1, &m_instanceVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+
+	glBindVertexArray(m_mesh.getVAO());
+
+	glEnableVertexAttribArray(INSTANCE_COLOR_LOCATION);
+	glVertexAttribPointer(INSTANCE_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, color));
+	glVertexAttribDivisor(INSTANCE_COLOR_LOCATION, 1);
+
+	// a mat4 attribute takes up four consecutive locations, one per column
+	for (uint i = 0; i < 4; i++)
+	{
+		glEnableVertexAttribArray(INSTANCE_MODEL_LOCATION + i);
+		glVertexAttribPointer(INSTANCE_MODEL_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offsetof(Instance, model) + i * 4 * sizeof(float)));
+		glVertexAttribDivisor(INSTANCE_MODEL_LOCATION + i, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Onyx::InstancedRenderable::clear()
+{
+	m_instances.clear();
+}
+
+void Onyx::InstancedRenderable::add(const Math::Vec3& position, const Math::Vec4& rgba)
+{
+	Math::Mat4 model = Math::Mat4::Identity();
+	model.translate(position);
+	add(model, rgba);
+}
+
+void Onyx::InstancedRenderable::add(const Math::Vec3& position, const Math::Vec3& rotation, const Math::Vec3& scale, const Math::Vec4& rgba)
+{
+	Math::Mat4 model = Math::Mat4::Identity();
+	model.translate(position);
+	if (rotation.getX() != 0.0f) model.rotate(rotation.getX(), Math::Vec3(1.0f, 0.0f, 0.0f));
+	if (rotation.getY() != 0.0f) model.rotate(rotation.getY(), Math::Vec3(0.0f, 1.0f, 0.0f));
+	if (rotation.getZ() != 0.0f) model.rotate(rotation.getZ(), Math::Vec3(0.0f, 0.0f, 1.0f));
+	model.scale(scale);
+	add(model, rgba);
+}
+
+void Onyx::InstancedRenderable::add(const Math::Mat4& model, const Math::Vec4& rgba)
+{
+	Instance instance;
+	memcpy(instance.color, rgba.data(), sizeof(instance.color));
+	memcpy(instance.model, model.data(), sizeof(instance.model));
+	m_instances.push_back(instance);
+}
+
+void Onyx::InstancedRenderable::render()
+{
+	if (m_instances.empty()) return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	while (m_capacity < m_instances.size()) m_capacity *= 2;
+	// orphan the old storage so the driver doesn't have to wait for the previous frame's draw to finish
+	glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, m_instances.size() * sizeof(Instance), m_instances.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_shader.use();
+
+	glBindVertexArray(m_mesh.getVAO());
+	glDrawElementsInstanced(GL_TRIANGLES, m_mesh.getIndicesSize() / sizeof(uint), GL_UNSIGNED_INT, nullptr, (GLsizei)m_instances.size());
+	glBindVertexArray(0);
+
+	glUseProgram(0);
+}
+
+uint Onyx::InstancedRenderable::getInstanceCount() const
+{
+	return m_instances.size();
+}
+
+Onyx::Mesh* Onyx::InstancedRenderable::getMesh()
+{
+	return &m_mesh;
+}
+
+Onyx::Shader* Onyx::InstancedRenderable::getShader()
+{
+	return &m_shader;
+}
+
+void Onyx::InstancedRenderable::dispose()
+{
+	if (m_disposed) return;
+
+	// the shader belongs to the shader cache
+	m_mesh.dispose();
+	glDeleteBuffers(1, &m_instanceVBO);
+	m_instanceVBO = 0;
+	m_instances.clear();
+
+	m_disposed = true;
+}
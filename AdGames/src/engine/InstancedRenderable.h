@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+
+#include <Onyx/Core.h>
+#include <Onyx/Mesh.h>
+#include <Onyx/Shader.h>
+#include <Onyx/Math.h>
+
+namespace Onyx
+{
+	/*
+		@brief A class to represent many copies of the same mesh, drawn with a single instanced draw call.
+		Each instance has its own transform and color, which are streamed to the GPU when render() is called.
+		Instances are not retained between frames, call clear() and re-add them every frame.
+		This class is disposable.
+	 */
+	class InstancedRenderable : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+		 */
+		InstancedRenderable();
+
+		/*
+			@brief Creates a new InstancedRenderable object out of the specified mesh.
+			The mesh is owned by the instanced renderable and is disposed of with it. The shader is shared through the ShaderCache.
+			@param mesh The mesh to use for every instance.
+			@param capacity The number of instances to allocate space for up front. The instance buffer grows as needed.
+			@param result A pointer to a boolean that will be set to true if the instanced shader was successfully compiled, and false otherwise.
+		 */
+		InstancedRenderable(Mesh mesh, uint capacity = 64, bool* result = nullptr);
+
+		/*
+			@brief Removes all instances.
+			This does not free any memory, so it is cheap to call every frame.
+		 */
+		void clear();
+
+		/*
+			@brief Adds an instance at the specified position.
+			@param position The position of the instance.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void add(const Math::Vec3& position, const Math::Vec4& rgba);
+
+		/*
+			@brief Adds an instance with the specified position, rotation and scale.
+			The transform is applied in the same order as a Renderable's: scale, then rotation (x, y, z), then translation.
+			@param position The position of the instance.
+			@param rotation The rotation of the instance around each axis, in degrees.
+			@param scale The scale of the instance on each axis.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void add(const Math::Vec3& position, const Math::Vec3& rotation, const Math::Vec3& scale, const Math::Vec4& rgba);
+
+		/*
+			@brief Adds an instance with the specified model matrix.
+			@param model The model matrix of the instance.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void add(const Math::Mat4& model, const Math::Vec4& rgba);
+
+		/*
+			@brief Renders every instance with one draw call.
+			This function, more technically, uploads the instance data, uses the shader, binds the VAO, draws all instances, unbinds the VAO, and unuses the shader.
+			Does nothing if there are no instances.
+			The camera and fog are read from the SharedUniforms blocks, so they must have been set this frame.
+		 */
+		void render();
+
+		/*
+			@brief Gets the number of instances that will be drawn by the next call to render().
+			@return The number of instances.
+		 */
+		uint getInstanceCount() const;
+
+		/*
+			@brief Gets the mesh shared by every instance.
+			@return A pointer to the mesh.
+		 */
+		Mesh* getMesh();
+
+		/*
+			@brief Gets the instanced shader.
+			@return A pointer to the shader.
+		 */
+		Shader* getShader();
+
+		void dispose() override;
+
+	private:
+		struct Instance
+		{
+			float color[4];
+			float model[16];
+		};
+
+		Mesh m_mesh;
+		Shader m_shader;
+
+		uint m_instanceVBO;
+		uint m_capacity;
+		std::vector<Instance> m_instances;
+	};
+}
@@ -0,0 +1,285 @@
+#include "MeshFile.h"
+
+#include <cstring>
+#include <cfloat>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+#include <OBJ_Loader.h>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+// the file is mapped and read in place, so these layouts are the format
+static_assert(sizeof(Onyx::MeshFileHeader) == 88, "MeshFileHeader layout changed");
+static_assert(sizeof(Onyx::MeshFileSubmesh) == 108, "MeshFileSubmesh layout changed");
+static_assert(sizeof(Onyx::MeshFileMaterial) == 268, "MeshFileMaterial layout changed");
+
+static void CopyName(char* dest, size_t size, const std::string& src)
+{
+	memset(dest, 0, size);
+	memcpy(dest, src.c_str(), std::min(src.size(), size - 1));
+}
+
+static void Grow(float* min, float* max, const objl::Vector3& position)
+{
+	min[0] = std::min(min[0], position.X); max[0] = std::max(max[0], position.X);
+	min[1] = std::min(min[1], position.Y); max[1] = std::max(max[1], position.Y);
+	min[2] = std::min(min[2], position.Z); max[2] = std::max(max[2], position.Z);
+}
+
+Onyx::MeshFile::MeshFile()
+{
+	m_pData = nullptr;
+	m_size = 0;
+	m_file = nullptr;
+	m_mapping = nullptr;
+}
+
+bool Onyx::MeshFile::Cook(const std::string& objPath, const std::string& omeshPath)
+{
+	objl::Loader loader;
+	if (!loader.LoadFile(objPath) || loader.LoadedMeshes.empty()) return false;
+
+	MeshFileHeader header = {};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.nSubmeshes = loader.LoadedMeshes.size();
+	for (int i = 0; i < 3; i++)
+	{
+		header.boundsMin[i] = FLT_MAX;
+		header.boundsMax[i] = -FLT_MAX;
+	}
+
+	// materials are deduplicated by name, every OBJ mesh carries its own copy
+	std::vector<MeshFileMaterial> materials;
+	std::vector<MeshFileSubmesh> submeshes(header.nSubmeshes);
+	bool textured = false, smallIndices = true;
+	uint nVertices = 0, nIndices = 0;
+	for (uint i = 0; i < header.nSubmeshes; i++)
+	{
+		const objl::Mesh& mesh = loader.LoadedMeshes[i];
+		const objl::Material& objMaterial = mesh.MeshMaterial;
+
+		uint material = 0;
+		while (material < materials.size() && objMaterial.name != materials[material].name) material++;
+		if (material == materials.size())
+		{
+			MeshFileMaterial newMaterial;
+			CopyName(newMaterial.name, sizeof(newMaterial.name), objMaterial.name);
+			CopyName(newMaterial.texture, sizeof(newMaterial.texture), objMaterial.map_Kd);
+			newMaterial.diffuse[0] = objMaterial.Kd.X;
+			newMaterial.diffuse[1] = objMaterial.Kd.Y;
+			newMaterial.diffuse[2] = objMaterial.Kd.Z;
+			newMaterial.diffuse[3] = 1.0f;
+			materials.push_back(newMaterial);
+		}
+		textured |= !objMaterial.map_Kd.empty();
+
+		MeshFileSubmesh& submesh = submeshes[i];
+		CopyName(submesh.name, sizeof(submesh.name), mesh.MeshName);
+		submesh.material = material;
+		submesh.firstVertex = nVertices;
+		submesh.nVertices = mesh.Vertices.size();
+		submesh.firstIndex = nIndices;
+		submesh.nIndices = mesh.Indices.size();
+		for (int j = 0; j < 3; j++)
+		{
+			submesh.boundsMin[j] = FLT_MAX;
+			submesh.boundsMax[j] = -FLT_MAX;
+		}
+		for (const objl::Vertex& vertex : mesh.Vertices)
+		{
+			Grow(submesh.boundsMin, submesh.boundsMax, vertex.Position);
+			Grow(header.boundsMin, header.boundsMax, vertex.Position);
+		}
+
+		smallIndices &= submesh.nVertices <= 65536;
+		nVertices += submesh.nVertices;
+		nIndices += submesh.nIndices;
+	}
+
+	// one format for the whole file, so every submesh can go through the same shader setup
+	header.vertexFormat = (uint)(textured ? VertexFormat::PNT : VertexFormat::PN);
+	header.vertexStride = (textured ? 8 : 6) * sizeof(float);
+	header.indexSize = smallIndices ? 2 : 4;
+	header.nMaterials = materials.size();
+
+	std::vector<float> vertices;
+	vertices.reserve((size_t)nVertices * header.vertexStride / sizeof(float));
+	std::vector<ubyte> indices((size_t)nIndices * header.indexSize);
+	ubyte* pIndex = indices.data();
+	for (const objl::Mesh& mesh : loader.LoadedMeshes)
+	{
+		for (const objl::Vertex& vertex : mesh.Vertices)
+		{
+			vertices.insert(vertices.end(), { vertex.Position.X, vertex.Position.Y, vertex.Position.Z, vertex.Normal.X, vertex.Normal.Y, vertex.Normal.Z });
+			if (textured) vertices.insert(vertices.end(), { vertex.TextureCoordinate.X, vertex.TextureCoordinate.Y });
+		}
+
+		for (uint index : mesh.Indices)
+		{
+			if (smallIndices)
+			{
+				ushort small = (ushort)index;
+				memcpy(pIndex, &small, sizeof(small));
+			}
+			else memcpy(pIndex, &index, sizeof(index));
+			pIndex += header.indexSize;
+		}
+	}
+
+	// sections are 8 byte aligned so the mapped arrays can be read in place
+	auto align = [](ulonglong offset) { return (offset + 7) & ~7ull; };
+	header.submeshOffset = sizeof(MeshFileHeader);
+	header.materialOffset = align(header.submeshOffset + submeshes.size() * sizeof(MeshFileSubmesh));
+	header.vertexOffset = align(header.materialOffset + materials.size() * sizeof(MeshFileMaterial));
+	header.indexOffset = align(header.vertexOffset + vertices.size() * sizeof(float));
+
+	std::ofstream file(omeshPath, std::ios::binary | std::ios::trunc);
+	if (!file) return false;
+
+	auto writeAt = [&file](ulonglong offset, const void* data, size_t size)
+	{
+		static const char padding[8] = {};
+		file.write(padding, offset - (ulonglong)file.tellp());
+		file.write((const char*)data, size);
+	};
+	writeAt(0, &header, sizeof(header));
+	writeAt(header.submeshOffset, submeshes.data(), submeshes.size() * sizeof(MeshFileSubmesh));
+	writeAt(header.materialOffset, materials.data(), materials.size() * sizeof(MeshFileMaterial));
+	writeAt(header.vertexOffset, vertices.data(), vertices.size() * sizeof(float));
+	writeAt(header.indexOffset, indices.data(), indices.size());
+
+	return file.good();
+}
+
+Onyx::MeshFile Onyx::MeshFile::Open(const std::string& omeshPath, bool* result)
+{
+	MeshFile meshFile;
+	meshFile.m_path = omeshPath;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(omeshPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	LARGE_INTEGER size = {};
+	if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG)sizeof(MeshFileHeader))
+	{
+		meshFile.m_file = file;
+		meshFile.m_size = size.QuadPart;
+		meshFile.m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (meshFile.m_mapping) meshFile.m_pData = (const ubyte*)MapViewOfFile(meshFile.m_mapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	else if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+	int fd = open(omeshPath.c_str(), O_RDONLY);
+	struct stat info = {};
+	if (fd != -1 && fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(MeshFileHeader))
+	{
+		meshFile.m_size = info.st_size;
+		void* pData = mmap(nullptr, meshFile.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (pData != MAP_FAILED) meshFile.m_pData = (const ubyte*)pData;
+	}
+	// the mapping keeps the file alive on its own
+	if (fd != -1) close(fd);
+#endif
+
+	if (!meshFile.m_pData)
+	{
+		meshFile.dispose();
+		if (result) *result = false;
+		return meshFile;
+	}
+
+	const MeshFileHeader& header = meshFile.getHeader();
+	bool valid = memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION
+		&& (header.indexSize == 2 || header.indexSize == 4)
+		&& header.submeshOffset + (ulonglong)header.nSubmeshes * sizeof(MeshFileSubmesh) <= meshFile.m_size
+		&& header.materialOffset + (ulonglong)header.nMaterials * sizeof(MeshFileMaterial) <= meshFile.m_size
+		&& header.vertexOffset <= header.indexOffset && header.indexOffset <= meshFile.m_size;
+
+	for (uint i = 0; valid && i < header.nSubmeshes; i++)
+	{
+		const MeshFileSubmesh& submesh = meshFile.getSubmesh(i);
+		valid = submesh.material < header.nMaterials
+			&& header.vertexOffset + ((ulonglong)submesh.firstVertex + submesh.nVertices) * header.vertexStride <= header.indexOffset
+			&& header.indexOffset + ((ulonglong)submesh.firstIndex + submesh.nIndices) * header.indexSize <= meshFile.m_size;
+	}
+
+	if (!valid) meshFile.dispose();
+	if (result) *result = valid;
+	return meshFile;
+}
+
+const Onyx::MeshFileHeader& Onyx::MeshFile::getHeader() const
+{
+	return *(const MeshFileHeader*)m_pData;
+}
+
+uint Onyx::MeshFile::getSubmeshCount() const
+{
+	return m_pData ? getHeader().nSubmeshes : 0;
+}
+
+const Onyx::MeshFileSubmesh& Onyx::MeshFile::getSubmesh(uint index) const
+{
+	return ((const MeshFileSubmesh*)(m_pData + getHeader().submeshOffset))[index];
+}
+
+const Onyx::MeshFileMaterial& Onyx::MeshFile::getMaterial(const MeshFileSubmesh& submesh) const
+{
+	return ((const MeshFileMaterial*)(m_pData + getHeader().materialOffset))[submesh.material];
+}
+
+const void* Onyx::MeshFile::getVertices(const MeshFileSubmesh& submesh) const
+{
+	return m_pData + getHeader().vertexOffset + (ulonglong)submesh.firstVertex * getHeader().vertexStride;
+}
+
+const void* Onyx::MeshFile::getIndices(const MeshFileSubmesh& submesh) const
+{
+	return m_pData + getHeader().indexOffset + (ulonglong)submesh.firstIndex * getHeader().indexSize;
+}
+
+Onyx::Bounds Onyx::MeshFile::getBounds() const
+{
+	const MeshFileHeader& header = getHeader();
+	return Bounds::FromMinMax(Math::Vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]), Math::Vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]));
+}
+
+Onyx::Bounds Onyx::MeshFile::getBounds(const MeshFileSubmesh& submesh) const
+{
+	return Bounds::FromMinMax(Math::Vec3(submesh.boundsMin[0], submesh.boundsMin[1], submesh.boundsMin[2]), Math::Vec3(submesh.boundsMax[0], submesh.boundsMax[1], submesh.boundsMax[2]));
+}
+
+const std::string& Onyx::MeshFile::getPath() const
+{
+	return m_path;
+}
+
+void Onyx::MeshFile::dispose()
+{
+	if (m_disposed) return;
+	m_disposed = true;
+
+#ifdef _WIN32
+	if (m_pData) UnmapViewOfFile(m_pData);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file) CloseHandle(m_file);
+#else
+	if (m_pData) munmap((void*)m_pData, m_size);
+#endif
+
+	m_pData = nullptr;
+	m_size = 0;
+	m_file = nullptr;
+	m_mapping = nullptr;
+}
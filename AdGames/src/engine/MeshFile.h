@@ -0,0 +1,168 @@
+#pragma once
+
+#include <string>
+
+#include <Onyx/Core.h>
+
+#include "Bounds.h"
+
+namespace Onyx
+{
+	/*
+		@brief The header at the start of a cooked mesh (.omesh) file.
+		Everything after it is found through its offsets: the submeshes, the materials, then the vertices of every submesh one after another, then their indices.
+		All values are little endian, the same as the structs in memory.
+	 */
+	struct MeshFileHeader
+	{
+		char magic[4];
+		uint version;
+		// an Onyx::VertexFormat, vertices are interleaved in that order (position, normal, texture coordinates)
+		uint vertexFormat;
+		uint vertexStride;
+		// 2 or 4 bytes, indices are relative to the first vertex of their submesh
+		uint indexSize;
+		uint nSubmeshes;
+		uint nMaterials;
+		uint reserved;
+		float boundsMin[3], boundsMax[3];
+		ulonglong submeshOffset, materialOffset, vertexOffset, indexOffset;
+	};
+
+	/*
+		@brief A part of a cooked mesh with one material.
+	 */
+	struct MeshFileSubmesh
+	{
+		char name[64];
+		uint material;
+		uint firstVertex, nVertices;
+		uint firstIndex, nIndices;
+		float boundsMin[3], boundsMax[3];
+	};
+
+	/*
+		@brief A material of a cooked mesh.
+	 */
+	struct MeshFileMaterial
+	{
+		char name[64];
+		// relative to the directory of the file, empty if there is none
+		char texture[188];
+		float diffuse[4];
+	};
+
+	/*
+		@brief A class to read cooked mesh (.omesh) files, which hold meshes ready to be handed to the GPU as they are.
+		The file is memory mapped rather than read, so opening it costs nothing until the data is touched,
+		and the vertex and index ranges can be passed straight to glBufferData without any parsing.
+		Cook() converts an OBJ file ahead of time, the game can also be run as `AdGames --cook <obj> <omesh>` to do it offline.
+		This class is disposable, disposing it unmaps the file and invalidates every pointer into it.
+	 */
+	class MeshFile : public Disposable
+	{
+	public:
+		/*
+			@brief The first 4 bytes of every cooked mesh file.
+		 */
+		static constexpr char MAGIC[4] = { 'O', 'M', 'S', 'H' };
+
+		/*
+			@brief The version of the format this build reads and writes.
+		 */
+		static const uint VERSION = 1;
+
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+			Use the static Open() function to create a valid mesh file.
+		 */
+		MeshFile();
+
+		/*
+			@brief Converts an OBJ file (and its MTL file, if it has one) to a cooked mesh file.
+			This parses and triangulates the OBJ, so it is slow, do it ahead of time.
+			@param objPath The path of the OBJ file.
+			@param omeshPath The path of the cooked mesh file to write.
+			@return True if the file was written, false if the OBJ couldn't be loaded or the file couldn't be written.
+		 */
+		static bool Cook(const std::string& objPath, const std::string& omeshPath);
+
+		/*
+			@brief Memory maps a cooked mesh file and checks its header.
+			@param omeshPath The path of the cooked mesh file.
+			@param result A pointer to a boolean that will be set to true if the file was mapped and is a valid cooked mesh file of this version, and false otherwise.
+			@return The mesh file.
+		 */
+		static MeshFile Open(const std::string& omeshPath, bool* result = nullptr);
+
+		/*
+			@brief Gets the header of the file.
+			@return The header.
+		 */
+		const MeshFileHeader& getHeader() const;
+
+		/*
+			@brief Gets the number of submeshes.
+			@return The number of submeshes.
+		 */
+		uint getSubmeshCount() const;
+
+		/*
+			@brief Gets a submesh.
+			@param index The index of the submesh.
+			@return The submesh.
+		 */
+		const MeshFileSubmesh& getSubmesh(uint index) const;
+
+		/*
+			@brief Gets the material of a submesh.
+			@param submesh The submesh.
+			@return The material.
+		 */
+		const MeshFileMaterial& getMaterial(const MeshFileSubmesh& submesh) const;
+
+		/*
+			@brief Gets the vertices of a submesh, straight from the mapped file.
+			@param submesh The submesh.
+			@return A pointer to the first vertex, there are submesh.nVertices * vertexStride bytes.
+		 */
+		const void* getVertices(const MeshFileSubmesh& submesh) const;
+
+		/*
+			@brief Gets the indices of a submesh, straight from the mapped file.
+			@param submesh The submesh.
+			@return A pointer to the first index, there are submesh.nIndices * indexSize bytes.
+		 */
+		const void* getIndices(const MeshFileSubmesh& submesh) const;
+
+		/*
+			@brief Gets the model space bounds of the whole mesh.
+			@return The bounds.
+		 */
+		Bounds getBounds() const;
+
+		/*
+			@brief Gets the model space bounds of a submesh.
+			@param submesh The submesh.
+			@return The bounds.
+		 */
+		Bounds getBounds(const MeshFileSubmesh& submesh) const;
+
+		/*
+			@brief Gets the path of the file.
+			@return The path.
+		 */
+		const std::string& getPath() const;
+
+		void dispose() override;
+
+	private:
+		std::string m_path;
+		const ubyte* m_pData;
+		ulonglong m_size;
+		// platform handles of the file and the mapping, as void* so the header needs no platform includes
+		void* m_file;
+		void* m_mapping;
+	};
+}
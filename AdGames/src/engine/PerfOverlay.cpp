@@ -0,0 +1,247 @@
+#include "PerfOverlay.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <Onyx/Projection.h>
+
+using Onyx::Math::Vec2;
+using Onyx::Math::Vec3;
+using Onyx::Math::Vec4;
+
+static const uint FONT_SIZE = 16;
+static const float LINE_HEIGHT = 20.0f;
+static const float MARGIN = 10.0f;
+static const float PADDING = 8.0f;
+static const float BAR_WIDTH = 2.0f;
+static const float GRAPH_HEIGHT = 60.0f;
+// the top of the graph, a frame this long or longer fills it
+static const float GRAPH_MAX = 1.0f / 30.0f;
+static const float TARGET_FRAME = 1.0f / 60.0f;
+static const double TEXT_INTERVAL = 0.25;
+
+Onyx::PerfOverlay::PerfOverlay()
+	: m_frameTimes(HISTORY_SIZE, 0.0f), m_cpuTimes(HISTORY_SIZE, 0.0f)
+{
+	m_visible = false;
+	m_loaded = false;
+	m_camWidth = 0;
+	m_camHeight = 0;
+
+	for (uint i = 0; i < QUERY_COUNT; i++)
+	{
+		m_queries[i] = 0;
+		m_queryPending[i] = false;
+	}
+	m_queryIndex = 0;
+	m_timing = false;
+	m_gpuTime = 0.0;
+
+	m_historyIndex = 0;
+
+	m_textTimer = TEXT_INTERVAL;
+	m_frameSum = 0.0;
+	m_cpuSum = 0.0;
+	m_gpuSum = 0.0;
+	m_frames = 0;
+	m_gpuFrames = 0;
+}
+
+void Onyx::PerfOverlay::toggle()
+{
+	if (!m_loaded) load();
+	m_visible = !m_visible;
+
+	// the text is out of date by however long the overlay was hidden
+	m_textTimer = TEXT_INTERVAL;
+}
+
+bool Onyx::PerfOverlay::isVisible() const
+{
+	return m_visible;
+}
+
+void Onyx::PerfOverlay::beginGpuTimer()
+{
+	if (!m_visible) return;
+
+	// the query about to be reused was issued QUERY_COUNT frames ago, so it has almost always finished by now
+	readQuery(m_queryIndex);
+	m_timing = !m_queryPending[m_queryIndex];
+	if (m_timing) glBeginQuery(GL_TIME_ELAPSED, m_queries[m_queryIndex]);
+}
+
+void Onyx::PerfOverlay::endGpuTimer()
+{
+	if (!m_timing) return;
+	m_timing = false;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_queryPending[m_queryIndex] = true;
+	m_queryIndex = (m_queryIndex + 1) % QUERY_COUNT;
+}
+
+void Onyx::PerfOverlay::record(double frameTime, double cpuTime)
+{
+	m_frameTimes[m_historyIndex] = (float)frameTime;
+	m_cpuTimes[m_historyIndex] = (float)cpuTime;
+	m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+
+	m_textTimer += frameTime;
+	m_frameSum += frameTime;
+	m_cpuSum += cpuTime;
+	m_frames++;
+}
+
+void Onyx::PerfOverlay::render(const Window& window, const RenderStats* pStats)
+{
+	if (!m_visible) return;
+
+	int width = window.getBufferWidth();
+	int height = window.getBufferHeight();
+	if (width != m_camWidth || height != m_camHeight)
+	{
+		m_camWidth = width;
+		m_camHeight = height;
+		m_cam.setProjection(Projection::Orthographic(width, height));
+		m_cam.update();
+	}
+
+	if (m_textTimer >= TEXT_INTERVAL) updateText(window, pStats);
+
+	float textWidth = 0.0f;
+	for (const AtlasText& line : m_lines) if (!line.isHidden()) textWidth = std::max(textWidth, line.getWidth());
+
+	float graphWidth = HISTORY_SIZE * BAR_WIDTH;
+	float panelWidth = std::max(textWidth, graphWidth) + PADDING * 2;
+	float panelHeight = LINE_COUNT * LINE_HEIGHT + GRAPH_HEIGHT + PADDING * 3;
+	float top = height - MARGIN;
+	float left = MARGIN;
+
+	m_shapes.drawQuad(Vec3(left + panelWidth / 2, top - panelHeight / 2, -0.5f), Vec2(panelWidth, panelHeight), 0.0f, Vec4(0.0f, 0.0f, 0.0f, 0.6f));
+
+	// oldest frame on the left, each bar is the whole frame with the CPU's share of it drawn over it
+	float graphBottom = top - panelHeight + PADDING;
+	float graphLeft = left + PADDING;
+	for (uint i = 0; i < HISTORY_SIZE; i++)
+	{
+		uint sample = (m_historyIndex + i) % HISTORY_SIZE;
+		float frameTime = m_frameTimes[sample];
+		if (frameTime <= 0.0f) continue;
+
+		float x = graphLeft + i * BAR_WIDTH + BAR_WIDTH / 2;
+		float frameHeight = std::min(frameTime / GRAPH_MAX, 1.0f) * GRAPH_HEIGHT;
+		Vec4 color = frameTime <= TARGET_FRAME * 1.05f ? Vec4(0.2f, 0.8f, 0.2f, 1.0f) : frameTime <= GRAPH_MAX ? Vec4(0.9f, 0.8f, 0.2f, 1.0f) : Vec4(0.9f, 0.2f, 0.2f, 1.0f);
+		m_shapes.drawQuad(Vec3(x, graphBottom + frameHeight / 2, -0.4f), Vec2(BAR_WIDTH, frameHeight), 0.0f, color);
+
+		float cpuHeight = std::min(m_cpuTimes[sample] / GRAPH_MAX, 1.0f) * GRAPH_HEIGHT;
+		if (cpuHeight > 0.0f) m_shapes.drawQuad(Vec3(x, graphBottom + cpuHeight / 2, -0.3f), Vec2(BAR_WIDTH, cpuHeight), 0.0f, Vec4(0.3f, 0.5f, 1.0f, 1.0f));
+	}
+
+	float targetY = graphBottom + TARGET_FRAME / GRAPH_MAX * GRAPH_HEIGHT;
+	m_shapes.drawQuad(Vec3(graphLeft + graphWidth / 2, targetY, -0.2f), Vec2(graphWidth, 1.0f), 0.0f, Vec4(1.0f, 1.0f, 1.0f, 0.5f));
+
+	for (uint i = 0; i < LINE_COUNT; i++)
+	{
+		m_lines[i].setPosition(Vec2(left + PADDING, top - PADDING - (i + 1) * LINE_HEIGHT + (LINE_HEIGHT - FONT_SIZE) / 2));
+	}
+
+	// whatever the scene left in the depth buffer was drawn with its own projection, not this one
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	SharedUniforms::SetCamera(m_cam);
+	m_shapes.render();
+
+	Math::Mat4 ortho = Projection::Orthographic(width, height).getMatrix();
+	for (AtlasText& line : m_lines) if (!line.isHidden()) line.render(ortho);
+}
+
+double Onyx::PerfOverlay::getGpuTime() const
+{
+	return m_gpuTime;
+}
+
+void Onyx::PerfOverlay::dispose()
+{
+	if (m_disposed) return;
+	m_disposed = true;
+
+	if (!m_loaded) return;
+
+	if (m_timing) glEndQuery(GL_TIME_ELAPSED);
+	glDeleteQueries(QUERY_COUNT, m_queries);
+
+	for (AtlasText& line : m_lines) line.dispose();
+	m_lines.clear();
+	m_shapes.dispose();
+	m_font.dispose();
+}
+
+void Onyx::PerfOverlay::load()
+{
+	m_loaded = true;
+
+	glGenQueries(QUERY_COUNT, m_queries);
+
+	// the overlay has its own font rather than one from the FontCache, since it outlives every scene
+	m_font = AtlasFont::Load(Resources("fonts/Roboto/Roboto-Regular.ttf"), FONT_SIZE);
+	for (uint i = 0; i < LINE_COUNT; i++) m_lines.push_back(AtlasText(" ", m_font, Vec4::White()));
+
+	m_shapes = ShapeBatch((HISTORY_SIZE * 2 + 4) * 6);
+}
+
+void Onyx::PerfOverlay::readQuery(uint index)
+{
+	if (!m_queryPending[index]) return;
+
+	int available = 0;
+	glGetQueryObjectiv(m_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) return;
+
+	GLuint64 elapsed = 0;
+	glGetQueryObjectui64v(m_queries[index], GL_QUERY_RESULT, &elapsed);
+	m_queryPending[index] = false;
+
+	m_gpuTime = elapsed / 1e9;
+	m_gpuSum += m_gpuTime;
+	m_gpuFrames++;
+}
+
+void Onyx::PerfOverlay::updateText(const Window& window, const RenderStats* pStats)
+{
+	double frame = m_frames > 0 ? m_frameSum / m_frames : 0.0;
+	double cpu = m_frames > 0 ? m_cpuSum / m_frames : 0.0;
+	double gpu = m_gpuFrames > 0 ? m_gpuSum / m_gpuFrames : m_gpuTime;
+
+	float worst = *std::max_element(m_frameTimes.begin(), m_frameTimes.end());
+
+	char line[160];
+	snprintf(line, sizeof(line), "%d FPS   frame %.2f ms   worst %.2f ms", window.getFPS(), frame * 1000.0, worst * 1000.0);
+	m_lines[0].setText(line);
+	snprintf(line, sizeof(line), "CPU %.2f ms   GPU %.2f ms", cpu * 1000.0, gpu * 1000.0);
+	m_lines[1].setText(line);
+
+	if (pStats)
+	{
+		snprintf(line, sizeof(line), "draws %u   triangles %llu   culled %u", pStats->drawCalls, pStats->triangles, pStats->culled);
+		m_lines[2].setText(line);
+		snprintf(line, sizeof(line), "binds: program %u   texture %u   VAO %u   skipped %u", pStats->programBinds, pStats->textureBinds, pStats->vaoBinds, pStats->skippedBinds);
+		m_lines[3].setText(line);
+		snprintf(line, sizeof(line), "renderables %u   models %u   instanced %u   batches %u   text %u", pStats->renderables, pStats->models, pStats->instanced, pStats->batches, pStats->texts);
+		m_lines[4].setText(line);
+		for (uint i = 2; i < LINE_COUNT; i++) m_lines[i].show();
+	}
+	else
+	{
+		m_lines[2].setText("this scene doesn't render through a RenderQueue");
+		m_lines[3].hide();
+		m_lines[4].hide();
+	}
+
+	m_textTimer = 0.0;
+	m_frameSum = 0.0;
+	m_cpuSum = 0.0;
+	m_gpuSum = 0.0;
+	m_frames = 0;
+	m_gpuFrames = 0;
+}
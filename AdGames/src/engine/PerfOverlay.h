@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+
+#include <Onyx/Core.h>
+#include <Onyx/Window.h>
+#include <Onyx/Camera.h>
+
+#include "AtlasFont.h"
+#include "AtlasText.h"
+#include "ShapeBatch.h"
+#include "RenderQueue.h"
+
+namespace Onyx
+{
+	/*
+		@brief A class to draw frame timings and renderer stats over whatever is on screen.
+		The CPU and frame times of the last HISTORY_SIZE frames are graphed, and the text is refreshed a few times per second with averages so it stays readable.
+		GPU time is measured with GL_TIME_ELAPSED queries kept in a ring, results are read a few frames late so the CPU never waits for the GPU.
+		Nothing is loaded and no queries are made until the overlay is first shown.
+		This class is disposable.
+	 */
+	class PerfOverlay : public Disposable
+	{
+	public:
+		/*
+			@brief The number of frames graphed, about 4 seconds at 60 FPS.
+		 */
+		static const uint HISTORY_SIZE = 240;
+
+		/*
+			@brief The number of timer queries in flight, and so the number of frames the GPU time lags behind.
+		 */
+		static const uint QUERY_COUNT = 4;
+
+		/*
+			@brief Default constructor, initializes member variables. The overlay starts hidden.
+		 */
+		PerfOverlay();
+
+		/*
+			@brief Shows the overlay if it is hidden and hides it if it is shown, loading what it draws the first time it is shown.
+		 */
+		void toggle();
+
+		/*
+			@brief Gets whether the overlay is shown.
+			@return True if the overlay is shown, false otherwise.
+		 */
+		bool isVisible() const;
+
+		/*
+			@brief Starts timing the GPU work of a frame. Does nothing while the overlay is hidden.
+			Timer queries can't be nested, so nothing drawn between this and endGpuTimer() may use one.
+		 */
+		void beginGpuTimer();
+
+		/*
+			@brief Stops timing the GPU work started by beginGpuTimer().
+		 */
+		void endGpuTimer();
+
+		/*
+			@brief Adds a frame to the history. Frames are recorded even while the overlay is hidden, so the graph is full as soon as it is shown.
+			@param frameTime The time between the start of this frame and the last one, in seconds.
+			@param cpuTime The time spent updating, ticking and submitting the frame, in seconds.
+		 */
+		void record(double frameTime, double cpuTime);
+
+		/*
+			@brief Draws the overlay on top of the frame. Clears the depth buffer so nothing in the scene can hide it.
+			@param window The window being drawn to.
+			@param pStats The stats of the queue the scene rendered with, or nullptr if it doesn't use one.
+		 */
+		void render(const Window& window, const RenderStats* pStats);
+
+		/*
+			@brief Gets the GPU time of the latest frame whose timer query has finished.
+			@return The GPU time, in seconds.
+		 */
+		double getGpuTime() const;
+
+		/*
+			@brief Disposes the font, text, batch and timer queries.
+		 */
+		void dispose() override;
+
+	private:
+		static const uint LINE_COUNT = 5;
+
+		bool m_visible;
+		bool m_loaded;
+
+		AtlasFont m_font;
+		std::vector<AtlasText> m_lines;
+		ShapeBatch m_shapes;
+		Camera m_cam;
+		int m_camWidth;
+		int m_camHeight;
+
+		uint m_queries[QUERY_COUNT];
+		bool m_queryPending[QUERY_COUNT];
+		uint m_queryIndex;
+		bool m_timing;
+		double m_gpuTime;
+
+		std::vector<float> m_frameTimes;
+		std::vector<float> m_cpuTimes;
+		uint m_historyIndex;
+
+		// sums since the text was last refreshed
+		double m_textTimer;
+		double m_frameSum;
+		double m_cpuSum;
+		double m_gpuSum;
+		uint m_frames;
+		uint m_gpuFrames;
+
+		void load();
+		void readQuery(uint index);
+		void updateText(const Window& window, const RenderStats* pStats);
+	};
+}
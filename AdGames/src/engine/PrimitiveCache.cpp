@@ -0,0 +1,77 @@
+#include "PrimitiveCache.h"
+
+std::unordered_map<ulonglong, Onyx::Mesh> Onyx::PrimitiveCache::sm_meshes;
+std::unordered_set<uint> Onyx::PrimitiveCache::sm_vaos;
+std::unordered_map<int, std::vector<Onyx::Math::Vec2>> Onyx::PrimitiveCache::sm_circlePoints;
+
+Onyx::Mesh Onyx::PrimitiveCache::Get(Primitive shape, int nSegments, bool genNormals, bool genTexCoords)
+{
+	// segments only mean something for circles, so they can't split the other shapes into separate entries
+	if (shape != Primitive::Circle) nSegments = 0;
+
+	ulonglong key = ((ulonglong)shape << 40) | ((ulonglong)(uint)nSegments << 8) | ((ulonglong)genNormals << 1) | (ulonglong)genTexCoords;
+
+	auto it = sm_meshes.find(key);
+	if (it != sm_meshes.end()) return it->second;
+
+	Mesh mesh;
+	switch (shape)
+	{
+		case Primitive::Quad: mesh = Mesh::Quad(1.0f, 1.0f, genNormals, genTexCoords); break;
+		case Primitive::Circle: mesh = Mesh::Circle(1.0f, nSegments, genNormals, genTexCoords); break;
+		case Primitive::Cube: mesh = Mesh::Cube(1.0f, genNormals, genTexCoords); break;
+	}
+
+	sm_meshes[key] = mesh;
+	sm_vaos.insert(mesh.getVAO());
+
+	return mesh;
+}
+
+Onyx::Mesh Onyx::PrimitiveCache::Quad(bool genNormals, bool genTexCoords)
+{
+	return Get(Primitive::Quad, 0, genNormals, genTexCoords);
+}
+
+Onyx::Mesh Onyx::PrimitiveCache::Circle(int nSegments, bool genNormals, bool genTexCoords)
+{
+	return Get(Primitive::Circle, nSegments, genNormals, genTexCoords);
+}
+
+Onyx::Mesh Onyx::PrimitiveCache::Cube(bool genNormals, bool genTexCoords)
+{
+	return Get(Primitive::Cube, 0, genNormals, genTexCoords);
+}
+
+const std::vector<Onyx::Math::Vec2>& Onyx::PrimitiveCache::CirclePoints(int nSegments)
+{
+	auto it = sm_circlePoints.find(nSegments);
+	if (it != sm_circlePoints.end()) return it->second;
+
+	std::vector<Math::Vec2>& points = sm_circlePoints[nSegments];
+	points.reserve(nSegments);
+
+	float step = 2.0f * 3.14159265f / nSegments;
+	for (int i = 0; i < nSegments; i++) points.push_back(Math::Vec2(Math::Cos(step * i), Math::Sin(step * i)));
+
+	return points;
+}
+
+bool Onyx::PrimitiveCache::Contains(const Mesh& mesh)
+{
+	return sm_vaos.find(mesh.getVAO()) != sm_vaos.end();
+}
+
+uint Onyx::PrimitiveCache::GetCount()
+{
+	return sm_meshes.size();
+}
+
+void Onyx::PrimitiveCache::Clear()
+{
+	for (auto& [key, mesh] : sm_meshes) mesh.dispose();
+
+	sm_meshes.clear();
+	sm_vaos.clear();
+	sm_circlePoints.clear();
+}
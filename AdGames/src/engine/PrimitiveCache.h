@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <Onyx/Core.h>
+#include <Onyx/Mesh.h>
+#include <Onyx/Math.h>
+
+namespace Onyx
+{
+	/*
+		@brief The shapes the PrimitiveCache can generate.
+	 */
+	enum class Primitive
+	{
+		Quad,
+		Circle,
+		Cube
+	};
+
+	/*
+		@brief A registry of unit sized primitive meshes, keyed by their shape, number of segments and vertex attributes.
+		Every mesh is generated once and shared, sizes are applied through the model transform (e.g. Renderable::setScale) instead.
+		Quads and cubes have a side length of 1 and circles have a radius of 1, all centered on the origin.
+		The cache owns its meshes. Meshes from it must not be disposed directly, use ShaderCache::DisposeRenderable() for renderables that use them.
+		Call Clear() before the GL context is destroyed.
+	 */
+	class PrimitiveCache
+	{
+	public:
+		/*
+			@brief Gets the mesh for a primitive, generating it if it isn't cached yet.
+			@param shape The shape of the primitive.
+			@param nSegments The number of segments, only used for circles.
+			@param genNormals Whether the mesh has normal vectors.
+			@param genTexCoords Whether the mesh has texture coordinates.
+			@return The shared mesh.
+		 */
+		static Mesh Get(Primitive shape, int nSegments = 0, bool genNormals = false, bool genTexCoords = false);
+
+		/*
+			@brief Gets the shared unit quad mesh.
+			@param genNormals Whether the mesh has normal vectors.
+			@param genTexCoords Whether the mesh has texture coordinates.
+			@return The shared mesh.
+		 */
+		static Mesh Quad(bool genNormals = false, bool genTexCoords = false);
+
+		/*
+			@brief Gets the shared unit circle mesh with the specified number of segments.
+			@param nSegments The number of segments (sides) of the circle.
+			@param genNormals Whether the mesh has normal vectors.
+			@param genTexCoords Whether the mesh has texture coordinates.
+			@return The shared mesh.
+		 */
+		static Mesh Circle(int nSegments, bool genNormals = false, bool genTexCoords = false);
+
+		/*
+			@brief Gets the shared unit cube mesh.
+			@param genNormals Whether the mesh has normal vectors.
+			@param genTexCoords Whether the mesh has texture coordinates.
+			@return The shared mesh.
+		 */
+		static Mesh Cube(bool genNormals = false, bool genTexCoords = false);
+
+		/*
+			@brief Gets the points around a unit circle, for shapes that are built on the CPU.
+			The first point is at (1, 0) and they go counterclockwise, the sines and cosines are only computed once per segment count until Clear() is called.
+			@param nSegments The number of segments (sides) of the circle.
+			@return The nSegments points on the circle.
+		 */
+		static const std::vector<Math::Vec2>& CirclePoints(int nSegments);
+
+		/*
+			@brief Gets whether a mesh belongs to the cache.
+			@param mesh The mesh to check.
+			@return True if the mesh is shared through the cache, false if not.
+		 */
+		static bool Contains(const Mesh& mesh);
+
+		/*
+			@brief Gets the number of meshes in the cache.
+			@return The number of meshes.
+		 */
+		static uint GetCount();
+
+		/*
+			@brief Disposes every mesh in the cache and frees the cached circle points.
+			References returned by CirclePoints() are invalid afterwards.
+		 */
+		static void Clear();
+
+	private:
+		static std::unordered_map<ulonglong, Mesh> sm_meshes;
+		static std::unordered_set<uint> sm_vaos;
+		static std::unordered_map<int, std::vector<Math::Vec2>> sm_circlePoints;
+	};
+}
@@ -0,0 +1,44 @@
+#include "Random.h"
+
+Onyx::Random::Random()
+	: Random(0)
+{
+}
+
+Onyx::Random::Random(ulonglong seed)
+{
+	this->seed(seed);
+}
+
+void Onyx::Random::seed(ulonglong seed)
+{
+	// splitmix64, so similar seeds still start far apart and the state is never 0, which xorshift can't leave
+	ulonglong z = seed + 0x9E3779B97F4A7C15ull;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	m_state = z ^ (z >> 31);
+	if (m_state == 0) m_state = 0x9E3779B97F4A7C15ull;
+}
+
+ulonglong Onyx::Random::next()
+{
+	m_state ^= m_state >> 12;
+	m_state ^= m_state << 25;
+	m_state ^= m_state >> 27;
+	return m_state * 0x2545F4914F6CDD1Dull;
+}
+
+int Onyx::Random::range(int min, int max)
+{
+	if (max <= min) return min;
+
+	ulonglong span = (ulonglong)((long long)max - min) + 1;
+	return (int)((long long)min + (long long)(next() % span));
+}
+
+float Onyx::Random::range(float min, float max)
+{
+	// the top 24 bits, exactly what a float's mantissa holds
+	float unit = (next() >> 40) * (1.0f / 16777216.0f);
+	return min + unit * (max - min);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	/*
+		@brief A small seeded random number generator (xorshift64*), for anything that has to replay the same way from the same seed.
+		Unlike Math::Rand(), which wraps the global rand(), every generator has its own state, and the numbers it gives don't depend on the platform or the standard library.
+	 */
+	class Random
+	{
+	public:
+		/*
+			@brief Default constructor, seeds the generator with 0.
+		 */
+		Random();
+
+		/*
+			@brief Creates a generator with the specified seed. Any seed is fine, including 0.
+			@param seed The seed.
+		 */
+		Random(ulonglong seed);
+
+		/*
+			@brief Reseeds the generator, it then gives the same numbers as a new generator with that seed.
+			@param seed The seed.
+		 */
+		void seed(ulonglong seed);
+
+		/*
+			@brief Generates the next 64 random bits.
+			@return The random bits.
+		 */
+		ulonglong next();
+
+		/*
+			@brief Generates a random integer between a minimum and maximum value, inclusive.
+			@param min The minimum value.
+			@param max The maximum value.
+			@return The random integer.
+		 */
+		int range(int min, int max);
+
+		/*
+			@brief Generates a random float between a minimum and maximum value.
+			@param min The minimum value.
+			@param max The maximum value.
+			@return The random float.
+		 */
+		float range(float min, float max);
+
+	private:
+		ulonglong m_state;
+	};
+}
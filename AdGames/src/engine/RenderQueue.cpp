@@ -0,0 +1,714 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <Onyx/Renderer.h>
+#include <Onyx/Projection.h>
+
+#include "ShaderCache.h"
+#include "SharedUniforms.h"
+
+// key layout, from the most significant bit down:
+//   opaque:      pass (2) | program (14) | texture (14) | VAO (18) | depth (16), front to back
+//   transparent: pass (2) | depth (16), back to front | program (14) | texture (14) | VAO (18)
+//   UI:          pass (2) | the order it was added in (62)
+// GL object names are small sequential integers, so masking them keeps them unique in practice.
+// If two names ever do collide in the key, the draws are only sorted less well, the bind tracking still compares the full names.
+const int KEY_PASS_SHIFT = 62;
+const ulonglong KEY_PROGRAM_MASK = (1ull << 14) - 1;
+const ulonglong KEY_TEXTURE_MASK = (1ull << 14) - 1;
+const ulonglong KEY_VAO_MASK = (1ull << 18) - 1;
+const ulonglong KEY_DEPTH_MASK = (1ull << 16) - 1;
+
+static ulonglong DepthBits(float depth)
+{
+	if (!(depth > 0.0f)) return 0;
+
+	// the bits of a positive float increase with its value, so the top 16 bits are a depth with more precision up close than far away
+	uint bits;
+	memcpy(&bits, &depth, sizeof(bits));
+	return bits >> 16;
+}
+
+Onyx::RenderQueue::RenderQueue()
+	: m_pWin(nullptr), m_pCam(nullptr), m_pLighting(nullptr), m_pFog(nullptr),
+	m_nextSequence(0), m_boundProgram(0), m_boundTexture(0), m_boundVAO(0), m_frame(0),
+	m_cullingEnabled(true), m_fogCullingEnabled(true)
+{
+}
+
+Onyx::RenderQueue::RenderQueue(Window& window, Camera& cam)
+	: RenderQueue()
+{
+	m_pWin = &window;
+	m_pCam = &cam;
+}
+
+Onyx::RenderQueue::RenderQueue(Window& window, Camera& cam, Lighting& lighting)
+	: RenderQueue(window, cam)
+{
+	m_pLighting = &lighting;
+}
+
+Onyx::RenderQueue::RenderQueue(Window& window, Camera& cam, Fog& fog)
+	: RenderQueue(window, cam)
+{
+	m_pFog = &fog;
+}
+
+Onyx::RenderQueue::RenderQueue(Window& window, Camera& cam, Lighting& lighting, Fog& fog)
+	: RenderQueue(window, cam)
+{
+	m_pLighting = &lighting;
+	m_pFog = &fog;
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(Renderable& renderable, RenderPass pass)
+{
+	bool hasBounds = false;
+	Bounds bounds = Bounds::FromMesh(*renderable.getMesh(), &hasBounds);
+	return insert(ItemType::Renderable, pass, &renderable, bounds, hasBounds);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(Renderable& renderable, const Math::Vec4& rgba, RenderPass pass)
+{
+	RenderHandle handle = add(renderable, pass);
+	setColor(handle, rgba);
+	return handle;
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(Renderable& renderable, const Math::Vec4& rgba, const Bounds& bounds, RenderPass pass)
+{
+	RenderHandle handle = insert(ItemType::Renderable, pass, &renderable, bounds, true);
+	setColor(handle, rgba);
+	return handle;
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(ModelRenderable& modelRenderable)
+{
+	bool hasBounds = false;
+	Bounds bounds;
+	for (const auto& [name, renderable] : modelRenderable.getRenderables())
+	{
+		Renderable& part = modelRenderable.getRenderable(name);
+		applyEnvironment(*part.getShader());
+
+		bool partHasBounds = false;
+		Bounds partBounds = Bounds::FromMesh(*part.getMesh(), &partHasBounds);
+		if (!partHasBounds) continue;
+
+		if (hasBounds) bounds.expand(partBounds);
+		else bounds = partBounds;
+		hasBounds = true;
+	}
+
+	return insert(ItemType::Model, RenderPass::Opaque, &modelRenderable, bounds, hasBounds);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(InstancedRenderable& instancedRenderable)
+{
+	return insert(ItemType::Instanced, RenderPass::Opaque, &instancedRenderable);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(ShapeBatch& shapeBatch, RenderPass pass)
+{
+	return insert(ItemType::Batch, pass, &shapeBatch);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(TextRenderable3D& textRenderable3D)
+{
+	applyEnvironment(*textRenderable3D.getShader());
+	return insert(ItemType::Text3D, RenderPass::Transparent, &textRenderable3D);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(TextRenderable& textRenderable)
+{
+	return insert(ItemType::TextUI, RenderPass::UI, &textRenderable);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(AtlasText3D& atlasText3D)
+{
+	return insert(ItemType::AtlasText3D, RenderPass::Transparent, &atlasText3D);
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::add(AtlasText& atlasText)
+{
+	return insert(ItemType::AtlasTextUI, RenderPass::UI, &atlasText);
+}
+
+bool Onyx::RenderQueue::remove(const RenderHandle& handle)
+{
+	if (!isValid(handle)) return false;
+
+	Slot& slot = m_slots[handle.index];
+	uint last = m_items.size() - 1;
+	if (slot.item != last)
+	{
+		m_items[slot.item] = m_items[last];
+		m_slots[m_items[slot.item].slot].item = slot.item;
+	}
+	m_items.pop_back();
+
+	// bumping the generation invalidates every existing handle to this slot, generation 0 is reserved for default constructed handles
+	if (++slot.generation == 0) slot.generation = 1;
+	m_freeSlots.push_back(handle.index);
+
+	return true;
+}
+
+void Onyx::RenderQueue::setColor(const RenderHandle& handle, const Math::Vec4& rgba)
+{
+	if (!isValid(handle)) return;
+
+	Item& item = m_items[m_slots[handle.index].item];
+	item.color = rgba;
+	item.hasColor = true;
+}
+
+bool Onyx::RenderQueue::isValid(const RenderHandle& handle) const
+{
+	if (handle.generation == 0 || handle.index >= m_slots.size()) return false;
+
+	const Slot& slot = m_slots[handle.index];
+	return slot.generation == handle.generation && slot.item < m_items.size() && m_items[slot.item].slot == handle.index;
+}
+
+uint Onyx::RenderQueue::getCount() const
+{
+	return m_items.size();
+}
+
+void Onyx::RenderQueue::render()
+{
+	m_frame++;
+	m_stats = RenderStats();
+
+	// one write each for every program using the shared blocks, rather than a set of uniforms per program
+	SharedUniforms::SetCamera(*m_pCam);
+	// the blocks are shared with every other queue, so this queue's settings are set every frame, they're only written if they differ from what's there
+	SharedUniforms::SetLighting(m_pLighting);
+	SharedUniforms::SetFog(m_pFog);
+
+	Frustum frustum = Frustum::FromCamera(*m_pCam);
+
+	m_sortEntries.clear();
+	for (uint i = 0; i < m_items.size(); i++)
+	{
+		const Item& item = m_items[i];
+		countItem(item.type);
+
+		bool hidden = false;
+		switch (item.type)
+		{
+			case ItemType::Renderable: hidden = ((Renderable*)item.ptr)->isHidden(); break;
+			case ItemType::Model: break;
+			case ItemType::Instanced: hidden = ((InstancedRenderable*)item.ptr)->getInstanceCount() == 0; break;
+			case ItemType::Batch: hidden = ((ShapeBatch*)item.ptr)->getVertexCount() == 0; break;
+			case ItemType::Text3D: hidden = ((TextRenderable3D*)item.ptr)->isHidden(); break;
+			case ItemType::TextUI: hidden = ((TextRenderable*)item.ptr)->isHidden(); break;
+			case ItemType::AtlasText3D: hidden = ((AtlasText3D*)item.ptr)->isHidden(); break;
+			case ItemType::AtlasTextUI: hidden = ((AtlasText*)item.ptr)->isHidden(); break;
+		}
+		if (hidden) continue;
+
+		if (m_cullingEnabled && isCulled(item, frustum))
+		{
+			m_stats.culled++;
+			continue;
+		}
+
+		m_sortEntries.push_back(SortEntry{ makeKey(item), i });
+	}
+
+	sortEntries();
+
+	const Math::Mat4& view = m_pCam->getViewMatrix();
+	const Math::Mat4& proj = m_pCam->getProjectionMatrix();
+	const Math::Vec3& camPos = m_pCam->getPosition();
+	Math::Mat4 ortho = Projection::Orthographic(m_pWin->getBufferWidth(), m_pWin->getBufferHeight()).getMatrix();
+
+	// Onyx's render functions unbind everything when they're done, so this is the state at the start of the frame
+	resetState();
+
+	bool wireframe = Renderer::IsWireframe();
+	if (wireframe)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+		glLineWidth(Renderer::GetLineWidth());
+	}
+
+	bool uiStarted = false;
+	for (const SortEntry& entry : m_sortEntries)
+	{
+		const Item& item = m_items[entry.index];
+
+		if (item.pass == RenderPass::UI && !uiStarted)
+		{
+			uiStarted = true;
+			if (wireframe && !Renderer::IsUiWireframeAllowed()) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		}
+
+		switch (item.type)
+		{
+			case ItemType::Renderable:
+				drawRenderable(item);
+				break;
+			case ItemType::Model:
+			{
+				ModelRenderable* pModel = (ModelRenderable*)item.ptr;
+				for (const auto& [name, renderable] : pModel->getRenderables())
+				{
+					if (renderable.isHidden()) continue;
+					countDraw(1, const_cast<Renderable&>(renderable).getMesh()->getIndicesSize() / sizeof(uint) / 3);
+				}
+				pModel->render(view, proj, camPos);
+				resetState();
+				break;
+			}
+			case ItemType::Instanced:
+			{
+				InstancedRenderable* pInstanced = (InstancedRenderable*)item.ptr;
+				countDraw(1, (ulonglong)pInstanced->getMesh()->getIndicesSize() / sizeof(uint) / 3 * pInstanced->getInstanceCount());
+				pInstanced->render();
+				resetState();
+				break;
+			}
+			case ItemType::Batch:
+			{
+				// the batch is cleared once it's drawn, so its vertices are counted first
+				ShapeBatch* pBatch = (ShapeBatch*)item.ptr;
+				ulonglong triangles = pBatch->getVertexCount() / 3;
+				pBatch->render();
+				countDraw(pBatch->getDrawCount(), triangles);
+				resetState();
+				break;
+			}
+			case ItemType::Text3D:
+				// Onyx's text renderables don't expose their meshes, so only their draws are counted
+				((TextRenderable3D*)item.ptr)->render(view, proj, camPos);
+				countDraw(1, 0);
+				resetState();
+				break;
+			case ItemType::TextUI:
+				((TextRenderable*)item.ptr)->render(ortho);
+				countDraw(1, 0);
+				resetState();
+				break;
+			case ItemType::AtlasText3D:
+				countDraw(1, ((AtlasText3D*)item.ptr)->getMesh()->getVertexCount() / 3);
+				((AtlasText3D*)item.ptr)->render();
+				resetState();
+				break;
+			case ItemType::AtlasTextUI:
+				countDraw(1, ((AtlasText*)item.ptr)->getMesh()->getVertexCount() / 3);
+				((AtlasText*)item.ptr)->render(ortho);
+				resetState();
+				break;
+		}
+	}
+
+	// leave the context the way the Onyx render functions would
+	if (m_boundVAO != 0) glBindVertexArray(0);
+	if (m_boundTexture != 0) glBindTexture(GL_TEXTURE_2D, 0);
+	if (m_boundProgram != 0) glUseProgram(0);
+	resetState();
+
+	if (wireframe) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
+
+uint Onyx::RenderQueue::getSkippedBinds() const
+{
+	return m_stats.skippedBinds;
+}
+
+uint Onyx::RenderQueue::getBinds() const
+{
+	return m_stats.programBinds + m_stats.textureBinds + m_stats.vaoBinds;
+}
+
+uint Onyx::RenderQueue::getCulledCount() const
+{
+	return m_stats.culled;
+}
+
+const Onyx::RenderStats& Onyx::RenderQueue::getStats() const
+{
+	return m_stats;
+}
+
+void Onyx::RenderQueue::setCullingEnabled(bool enabled)
+{
+	m_cullingEnabled = enabled;
+}
+
+void Onyx::RenderQueue::setFogCullingEnabled(bool enabled)
+{
+	m_fogCullingEnabled = enabled;
+}
+
+void Onyx::RenderQueue::refreshEnvironment()
+{
+	for (const Item& item : m_items)
+	{
+		if (item.type == ItemType::Text3D) applyEnvironment(*((TextRenderable3D*)item.ptr)->getShader());
+		else if (item.type == ItemType::Model)
+		{
+			ModelRenderable* pModel = (ModelRenderable*)item.ptr;
+			for (const auto& [name, renderable] : pModel->getRenderables()) applyEnvironment(*pModel->getRenderable(name).getShader());
+		}
+	}
+}
+
+void Onyx::RenderQueue::dispose()
+{
+	if (m_disposed) return;
+
+	for (const Item& item : m_items)
+	{
+		switch (item.type)
+		{
+			case ItemType::Renderable: ShaderCache::DisposeRenderable(*(Renderable*)item.ptr); break;
+			case ItemType::Model: ((ModelRenderable*)item.ptr)->dispose(); break;
+			case ItemType::Instanced: ((InstancedRenderable*)item.ptr)->dispose(); break;
+			case ItemType::Batch: ((ShapeBatch*)item.ptr)->dispose(); break;
+			case ItemType::Text3D: ((TextRenderable3D*)item.ptr)->dispose(); break;
+			case ItemType::TextUI: ((TextRenderable*)item.ptr)->dispose(); break;
+			case ItemType::AtlasText3D: ((AtlasText3D*)item.ptr)->dispose(); break;
+			case ItemType::AtlasTextUI: ((AtlasText*)item.ptr)->dispose(); break;
+		}
+	}
+
+	m_items.clear();
+	m_slots.clear();
+	m_freeSlots.clear();
+	m_sortEntries.clear();
+	m_sortScratch.clear();
+	m_programUniforms.clear();
+
+	m_disposed = true;
+}
+
+Onyx::RenderHandle Onyx::RenderQueue::insert(ItemType type, RenderPass pass, void* ptr, const Bounds& bounds, bool hasBounds)
+{
+	uint index;
+	if (!m_freeSlots.empty())
+	{
+		index = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		index = m_slots.size();
+		m_slots.push_back(Slot{ 1, 0 });
+	}
+
+	Slot& slot = m_slots[index];
+	slot.item = m_items.size();
+	m_items.push_back(Item{ type, pass, ptr, index, m_nextSequence++, bounds, hasBounds, Math::Vec4(), false });
+
+	return RenderHandle{ index, slot.generation };
+}
+
+bool Onyx::RenderQueue::isCulled(const Item& item, const Frustum& frustum) const
+{
+	Bounds world;
+	switch (item.type)
+	{
+		case ItemType::Renderable:
+			if (!item.hasBounds) return false;
+			world = item.bounds.transformed(((Renderable*)item.ptr)->getModel());
+			break;
+		case ItemType::Model:
+		{
+			// the parts of a model renderable are all moved together, so any of their model matrices is the model's
+			const std::map<std::string, Renderable>& parts = ((ModelRenderable*)item.ptr)->getRenderables();
+			if (!item.hasBounds || parts.empty()) return false;
+			world = item.bounds.transformed(parts.begin()->second.getModel());
+			break;
+		}
+		case ItemType::Text3D:
+		{
+			// text starts at its position and extends by its dimensions, a sphere that size around the position contains it however it's rotated
+			TextRenderable3D* pText = (TextRenderable3D*)item.ptr;
+			world = Bounds::FromSphere(pText->getPosition(), pText->getWidth() + pText->getHeight());
+			break;
+		}
+		case ItemType::AtlasText3D:
+		{
+			AtlasText3D* pText = (AtlasText3D*)item.ptr;
+			world = Bounds::FromSphere(pText->getPosition(), pText->getWidth() + pText->getHeight());
+			break;
+		}
+		default:
+			return false;
+	}
+
+	if (!frustum.intersects(world)) return true;
+
+	if (m_fogCullingEnabled && m_pFog && item.pass != RenderPass::UI)
+	{
+		float dist = (world.center - m_pCam->getPosition()).magnitude() - world.radius;
+		if (dist > m_pFog->getEnd()) return true;
+	}
+
+	return false;
+}
+
+ulonglong Onyx::RenderQueue::makeKey(const Item& item) const
+{
+	ulonglong key = (ulonglong)item.pass << KEY_PASS_SHIFT;
+	// removing swaps items around, so the order UI was added in has to be part of its key
+	if (item.pass == RenderPass::UI) return key | (item.sequence & ((1ull << KEY_PASS_SHIFT) - 1));
+
+	ulonglong program = 0, texture = 0, vao = 0;
+	Math::Vec3 pos;
+	if (item.type == ItemType::Renderable)
+	{
+		Renderable* pRenderable = (Renderable*)item.ptr;
+		program = pRenderable->getShader()->getProgramID() & KEY_PROGRAM_MASK;
+		texture = pRenderable->getTexture()->getTextureID() & KEY_TEXTURE_MASK;
+		vao = pRenderable->getMesh()->getVAO() & KEY_VAO_MASK;
+		pos = pRenderable->getPosition();
+	}
+	else if (item.type == ItemType::Model)
+	{
+		const std::map<std::string, Renderable>& parts = ((ModelRenderable*)item.ptr)->getRenderables();
+		if (!parts.empty()) pos = parts.begin()->second.getPosition();
+	}
+	else if (item.type == ItemType::Instanced)
+	{
+		// instanced renderables are created in the order they should be drawn in, which their program and VAO follow
+		InstancedRenderable* pInstanced = (InstancedRenderable*)item.ptr;
+		program = pInstanced->getShader()->getProgramID() & KEY_PROGRAM_MASK;
+		vao = pInstanced->getMesh()->getVAO() & KEY_VAO_MASK;
+	}
+	else if (item.type == ItemType::Batch)
+	{
+		program = ((ShapeBatch*)item.ptr)->getShader()->getProgramID() & KEY_PROGRAM_MASK;
+	}
+	else if (item.type == ItemType::Text3D)
+	{
+		pos = ((TextRenderable3D*)item.ptr)->getPosition();
+	}
+	else if (item.type == ItemType::AtlasText3D)
+	{
+		AtlasText3D* pText = (AtlasText3D*)item.ptr;
+		program = pText->getShader()->getProgramID() & KEY_PROGRAM_MASK;
+		texture = pText->getFont().getTextureID() & KEY_TEXTURE_MASK;
+		vao = pText->getMesh()->getVAO() & KEY_VAO_MASK;
+		pos = pText->getPosition();
+	}
+
+	const Math::Vec3& camPos = m_pCam->getPosition();
+	const Math::Vec3& front = m_pCam->getFront();
+	float depth = (pos.getX() - camPos.getX()) * front.getX() + (pos.getY() - camPos.getY()) * front.getY() + (pos.getZ() - camPos.getZ()) * front.getZ();
+	ulonglong depthBits = DepthBits(depth);
+
+	if (item.pass == RenderPass::Transparent)
+	{
+		key |= ((~depthBits) & KEY_DEPTH_MASK) << 46;
+		key |= program << 32;
+		key |= texture << 18;
+		key |= vao;
+	}
+	else
+	{
+		key |= program << 48;
+		key |= texture << 34;
+		key |= vao << 16;
+		key |= depthBits;
+	}
+
+	return key;
+}
+
+void Onyx::RenderQueue::sortEntries()
+{
+	// LSD radix sort, one byte per pass, which is stable and linear in the number of draws
+	uint n = m_sortEntries.size();
+	if (n < 2) return;
+
+	m_sortScratch.resize(n);
+	SortEntry* src = m_sortEntries.data();
+	SortEntry* dst = m_sortScratch.data();
+
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		uint counts[256] = { 0 };
+		for (uint i = 0; i < n; i++) counts[(src[i].key >> shift) & 0xFF]++;
+
+		// every key has the same byte here, so this pass wouldn't move anything
+		if (counts[(src[0].key >> shift) & 0xFF] == n) continue;
+
+		uint offset = 0;
+		for (uint b = 0; b < 256; b++)
+		{
+			uint count = counts[b];
+			counts[b] = offset;
+			offset += count;
+		}
+
+		for (uint i = 0; i < n; i++) dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+		SortEntry* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if (src != m_sortEntries.data()) memcpy(m_sortEntries.data(), src, n * sizeof(SortEntry));
+}
+
+void Onyx::RenderQueue::bindProgram(uint program)
+{
+	if (program == m_boundProgram)
+	{
+		m_stats.skippedBinds++;
+		return;
+	}
+
+	glUseProgram(program);
+	m_boundProgram = program;
+	m_stats.programBinds++;
+}
+
+void Onyx::RenderQueue::bindTexture(uint texture)
+{
+	if (texture == m_boundTexture)
+	{
+		m_stats.skippedBinds++;
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	m_boundTexture = texture;
+	m_stats.textureBinds++;
+}
+
+void Onyx::RenderQueue::bindVAO(uint vao)
+{
+	if (vao == m_boundVAO)
+	{
+		m_stats.skippedBinds++;
+		return;
+	}
+
+	glBindVertexArray(vao);
+	m_boundVAO = vao;
+	m_stats.vaoBinds++;
+}
+
+void Onyx::RenderQueue::countItem(ItemType type)
+{
+	switch (type)
+	{
+		case ItemType::Renderable: m_stats.renderables++; break;
+		case ItemType::Model: m_stats.models++; break;
+		case ItemType::Instanced: m_stats.instanced++; break;
+		case ItemType::Batch: m_stats.batches++; break;
+		default: m_stats.texts++; break;
+	}
+}
+
+void Onyx::RenderQueue::countDraw(uint drawCalls, ulonglong triangles)
+{
+	m_stats.drawCalls += drawCalls;
+	m_stats.triangles += triangles;
+}
+
+void Onyx::RenderQueue::resetState()
+{
+	m_boundProgram = 0;
+	m_boundTexture = 0;
+	m_boundVAO = 0;
+}
+
+Onyx::RenderQueue::ProgramUniforms& Onyx::RenderQueue::getProgramUniforms(uint program)
+{
+	auto it = m_programUniforms.find(program);
+	if (it != m_programUniforms.end()) return it->second;
+
+	ProgramUniforms& uniforms = m_programUniforms[program];
+	uniforms.model = glGetUniformLocation(program, "u_model");
+	uniforms.inverseModel = glGetUniformLocation(program, "u_inverseModel");
+	uniforms.view = glGetUniformLocation(program, "u_view");
+	uniforms.projection = glGetUniformLocation(program, "u_projection");
+	uniforms.camPos = glGetUniformLocation(program, "u_camPos");
+	uniforms.color = glGetUniformLocation(program, "u_color");
+	uniforms.lightingEnabled = glGetUniformLocation(program, "u_lighting.enabled");
+	uniforms.lightingColor = glGetUniformLocation(program, "u_lighting.color");
+	uniforms.lightingAmbientStrength = glGetUniformLocation(program, "u_lighting.ambientStrength");
+	uniforms.lightingDirection = glGetUniformLocation(program, "u_lighting.direction");
+	uniforms.fogEnabled = glGetUniformLocation(program, "u_fog.enabled");
+	uniforms.fogColor = glGetUniformLocation(program, "u_fog.color");
+	uniforms.fogStart = glGetUniformLocation(program, "u_fog.start");
+	uniforms.fogEnd = glGetUniformLocation(program, "u_fog.end");
+	uniforms.sharedBlocks = SharedUniforms::UsesCameraBlock(program);
+	uniforms.frame = 0;
+	return uniforms;
+}
+
+void Onyx::RenderQueue::drawRenderable(const Item& item)
+{
+	Renderable& renderable = *(Renderable*)item.ptr;
+
+	uint program = renderable.getShader()->getProgramID();
+	bindProgram(program);
+
+	ProgramUniforms& uniforms = getProgramUniforms(program);
+	if (!uniforms.sharedBlocks && uniforms.frame != m_frame)
+	{
+		// uniforms live in the program, so the per-frame ones only need to be set the first time a program is used each frame
+		uniforms.frame = m_frame;
+		glUniformMatrix4fv(uniforms.view, 1, GL_FALSE, m_pCam->getViewMatrix().data());
+		glUniformMatrix4fv(uniforms.projection, 1, GL_FALSE, m_pCam->getProjectionMatrix().data());
+		glUniform3fv(uniforms.camPos, 1, m_pCam->getPosition().data());
+		uploadEnvironment(uniforms);
+	}
+
+	glUniformMatrix4fv(uniforms.model, 1, GL_FALSE, renderable.getModel().data());
+	if (item.hasColor) glUniform4fv(uniforms.color, 1, item.color.data());
+	if (uniforms.inverseModel != -1) glUniformMatrix4fv(uniforms.inverseModel, 1, GL_FALSE, Math::Inverse(renderable.getModel()).data());
+
+	uint texture = renderable.getTexture()->getTextureID();
+	if (texture != 0) bindTexture(texture);
+
+	Mesh* pMesh = renderable.getMesh();
+	bindVAO(pMesh->getVAO());
+
+	uint nIndices = pMesh->getIndicesSize() / sizeof(uint);
+	glDrawElements(GL_TRIANGLES, nIndices, GL_UNSIGNED_INT, nullptr);
+	countDraw(1, nIndices / 3);
+}
+
+void Onyx::RenderQueue::applyEnvironment(Shader& shader)
+{
+	uint program = shader.getProgramID();
+	ProgramUniforms& uniforms = getProgramUniforms(program);
+	if (uniforms.sharedBlocks) return;
+
+	glUseProgram(program);
+	uploadEnvironment(uniforms);
+	glUseProgram(0);
+}
+
+void Onyx::RenderQueue::uploadEnvironment(const ProgramUniforms& uniforms)
+{
+	glUniform1i(uniforms.lightingEnabled, m_pLighting != nullptr);
+	if (m_pLighting)
+	{
+		glUniform3fv(uniforms.lightingColor, 1, m_pLighting->getColor().data());
+		glUniform1f(uniforms.lightingAmbientStrength, m_pLighting->getAmbientStrength());
+		glUniform3fv(uniforms.lightingDirection, 1, m_pLighting->getDirection().data());
+	}
+
+	glUniform1i(uniforms.fogEnabled, m_pFog != nullptr);
+	if (m_pFog)
+	{
+		glUniform3fv(uniforms.fogColor, 1, m_pFog->getColor().data());
+		glUniform1f(uniforms.fogStart, m_pFog->getStart());
+		glUniform1f(uniforms.fogEnd, m_pFog->getEnd());
+	}
+}
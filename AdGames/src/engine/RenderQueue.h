@@ -0,0 +1,377 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <Onyx/Core.h>
+#include <Onyx/Window.h>
+#include <Onyx/Camera.h>
+#include <Onyx/Lighting.h>
+#include <Onyx/Fog.h>
+#include <Onyx/Renderable.h>
+#include <Onyx/ModelRenderable.h>
+#include <Onyx/TextRenderable.h>
+#include <Onyx/TextRenderable3D.h>
+
+#include "InstancedRenderable.h"
+#include "ShapeBatch.h"
+#include "AtlasText.h"
+#include "AtlasText3D.h"
+#include "Bounds.h"
+#include "Frustum.h"
+#include "SharedUniforms.h"
+
+namespace Onyx
+{
+	/*
+		@brief The pass a draw belongs to. Passes are drawn in the order they are declared.
+		Opaque draws are sorted by state to minimize binds, transparent draws are sorted back to front,
+		and UI draws keep the order they were added in.
+	 */
+	enum class RenderPass
+	{
+		Opaque,
+		Transparent,
+		UI
+	};
+
+	/*
+		@brief A handle to something added to a RenderQueue, used to remove it again.
+		Handles are generational, so a handle stays invalid after what it refers to is removed, even once its slot is reused.
+		A default constructed handle is never valid.
+	 */
+	struct RenderHandle
+	{
+		uint index = 0;
+		uint generation = 0;
+	};
+
+	/*
+		@brief What a RenderQueue drew during its last call to render().
+		The item counts include hidden and culled items, the rest only count what was actually drawn.
+	 */
+	struct RenderStats
+	{
+		uint drawCalls = 0;
+		ulonglong triangles = 0;
+
+		uint programBinds = 0;
+		uint textureBinds = 0;
+		uint vaoBinds = 0;
+		uint skippedBinds = 0;
+		uint culled = 0;
+
+		uint renderables = 0;
+		uint models = 0;
+		uint instanced = 0;
+		uint batches = 0;
+		uint texts = 0;
+	};
+
+	/*
+		@brief A class to render a scene with as few GL state changes as possible.
+		Every draw gets a 64-bit sort key built from its pass, shader program, texture, VAO and depth,
+		and the keys are radix sorted every frame. Renderables are then drawn directly by the queue,
+		which keeps track of the bound program, texture and VAO and skips binds that wouldn't change anything.
+		Other renderable types are drawn by their own render() function at their sorted position.
+		Like the Renderer, the queue holds pointers to the renderables, so they must outlive it or be removed first.
+		Unlike the Renderer, anything added can be removed again in constant time using the handle returned by add().
+		Live items are kept densely packed, so removed items cost nothing per frame, while hidden ones still cost a check.
+		The camera, lighting and fog are written to the SharedUniforms blocks once per frame, programs that use them get no per-program uploads at all.
+		Renderables, models and 3D text outside the camera's view, or past the end of the fog, are culled before they are sorted.
+		This class is disposable, disposing it disposes every renderable it contains, except for shaders that belong to the ShaderCache.
+	 */
+	class RenderQueue : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+		 */
+		RenderQueue();
+
+		/*
+			@brief Creates a new RenderQueue object with lighting and fog disabled.
+			@param window The window to render to, used for the UI projection.
+			@param cam The camera to use.
+		 */
+		RenderQueue(Window& window, Camera& cam);
+
+		/*
+			@brief Creates a new RenderQueue object with the specified lighting settings.
+			@param window The window to render to, used for the UI projection.
+			@param cam The camera to use.
+			@param lighting The lighting settings to use.
+		 */
+		RenderQueue(Window& window, Camera& cam, Lighting& lighting);
+
+		/*
+			@brief Creates a new RenderQueue object with the specified fog settings.
+			@param window The window to render to, used for the UI projection.
+			@param cam The camera to use.
+			@param fog The fog settings to use.
+		 */
+		RenderQueue(Window& window, Camera& cam, Fog& fog);
+
+		/*
+			@brief Creates a new RenderQueue object with the specified lighting and fog settings.
+			@param window The window to render to, used for the UI projection.
+			@param cam The camera to use.
+			@param lighting The lighting settings to use.
+			@param fog The fog settings to use.
+		 */
+		RenderQueue(Window& window, Camera& cam, Lighting& lighting, Fog& fog);
+
+		/*
+			@brief Adds a renderable to the queue.
+			@param renderable The renderable to add.
+			@param pass The pass to draw the renderable in. Use RenderPass::Transparent for renderables with a transparent color or texture.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(Renderable& renderable, RenderPass pass = RenderPass::Opaque);
+
+		/*
+			@brief Adds a renderable to the queue with its own color, which is set as u_color every time it is drawn.
+			Use this for renderables that share a program from the ShaderCache, since the program's u_color is shared too.
+			@param renderable The renderable to add.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+			@param pass The pass to draw the renderable in. Use RenderPass::Transparent for renderables with a transparent color or texture.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(Renderable& renderable, const Math::Vec4& rgba, RenderPass pass = RenderPass::Opaque);
+
+		/*
+			@brief Adds a renderable to the queue with its own color and model space bounds that are already known, such as a part of a CookedModel.
+			Unlike the other overloads, nothing is read back from the GPU to compute the bounds.
+			@param renderable The renderable to add.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+			@param bounds The model space bounds of the renderable's mesh.
+			@param pass The pass to draw the renderable in. Use RenderPass::Transparent for renderables with a transparent color or texture.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(Renderable& renderable, const Math::Vec4& rgba, const Bounds& bounds, RenderPass pass = RenderPass::Opaque);
+
+		/*
+			@brief Adds a model renderable to the queue. It is drawn in the opaque pass, by its own render() function.
+			@param modelRenderable The model renderable to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(ModelRenderable& modelRenderable);
+
+		/*
+			@brief Adds an instanced renderable to the queue. It is drawn in the opaque pass.
+			@param instancedRenderable The instanced renderable to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(InstancedRenderable& instancedRenderable);
+
+		/*
+			@brief Adds a shape batch to the queue. Everything drawn into it since the last frame is drawn, and cleared, at its sorted position.
+			@param shapeBatch The shape batch to add.
+			@param pass The pass to draw the batch in. Use RenderPass::Transparent if it has transparent shapes.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(ShapeBatch& shapeBatch, RenderPass pass = RenderPass::Opaque);
+
+		/*
+			@brief Adds a 3D text renderable to the queue. It is drawn in the transparent pass, sorted by depth with the other transparent draws.
+			@param textRenderable3D The 3D text renderable to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(TextRenderable3D& textRenderable3D);
+
+		/*
+			@brief Adds a text renderable to the queue. It is drawn in the UI pass.
+			@param textRenderable The text renderable to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(TextRenderable& textRenderable);
+
+		/*
+			@brief Adds atlas text to the queue. It is drawn in the transparent pass, sorted by depth with the other transparent draws.
+			@param atlasText3D The atlas text to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(AtlasText3D& atlasText3D);
+
+		/*
+			@brief Adds atlas UI text to the queue. It is drawn in the UI pass.
+			@param atlasText The atlas text to add.
+			@return A handle that can be passed to remove().
+		 */
+		RenderHandle add(AtlasText& atlasText);
+
+		/*
+			@brief Removes something from the queue. It is not disposed, that is left to the caller.
+			This swaps the last item into the removed item's place, so it takes constant time.
+			@param handle The handle returned when it was added.
+			@return True if it was removed, false if the handle was not valid.
+		 */
+		bool remove(const RenderHandle& handle);
+
+		/*
+			@brief Sets the per-draw color of a renderable that was added with one.
+			@param handle The handle returned when it was added.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void setColor(const RenderHandle& handle, const Math::Vec4& rgba);
+
+		/*
+			@brief Gets whether a handle still refers to something in the queue.
+			@param handle The handle to check.
+			@return True if the handle is valid, false if it was never valid or has been removed.
+		 */
+		bool isValid(const RenderHandle& handle) const;
+
+		/*
+			@brief Gets the number of items in the queue.
+			@return The number of items.
+		 */
+		uint getCount() const;
+
+		/*
+			@brief Sorts and renders everything in the queue.
+			Does not render any renderables that have been hidden.
+		 */
+		void render();
+
+		/*
+			@brief Gets the number of binds (programs, textures and VAOs) that were skipped during the last call to render().
+			@return The number of skipped binds.
+		 */
+		uint getSkippedBinds() const;
+
+		/*
+			@brief Gets the number of binds (programs, textures and VAOs) that were made during the last call to render().
+			@return The number of binds.
+		 */
+		uint getBinds() const;
+
+		/*
+			@brief Gets the number of items that were culled during the last call to render().
+			@return The number of culled items.
+		 */
+		uint getCulledCount() const;
+
+		/*
+			@brief Gets the draw calls, triangles, binds and item counts from the last call to render().
+			@return The stats of the last frame.
+		 */
+		const RenderStats& getStats() const;
+
+		/*
+			@brief Sets whether items outside the camera's view are culled. Enabled by default.
+			@param enabled True to enable culling, false to disable.
+		 */
+		void setCullingEnabled(bool enabled);
+
+		/*
+			@brief Sets whether items entirely past the end of the fog are culled. Enabled by default.
+			Fully fogged items are drawn in the fog color, so this should be disabled if the fog color doesn't match the background color.
+			Has no effect if the queue has no fog.
+			@param enabled True to enable fog culling, false to disable.
+		 */
+		void setFogCullingEnabled(bool enabled);
+
+		/*
+			@brief Refreshes the lighting and fog variables after their values have been changed.
+			Programs using the SharedUniforms blocks don't need this, the blocks are set at the start of every render,
+			while models and text, which use Onyx's own shaders, have them set in each of their programs.
+		 */
+		void refreshEnvironment();
+
+		void dispose() override;
+
+	private:
+		enum class ItemType
+		{
+			Renderable,
+			Model,
+			Instanced,
+			Batch,
+			Text3D,
+			TextUI,
+			AtlasText3D,
+			AtlasTextUI
+		};
+
+		struct Item
+		{
+			ItemType type;
+			RenderPass pass;
+			void* ptr;
+			uint slot;
+			ulonglong sequence;
+			// model space, only used if hasBounds is set
+			Bounds bounds;
+			bool hasBounds;
+			// set as u_color every draw, only used if hasColor is set
+			Math::Vec4 color;
+			bool hasColor;
+		};
+
+		struct Slot
+		{
+			uint generation;
+			uint item;
+		};
+
+		struct SortEntry
+		{
+			ulonglong key;
+			uint index;
+		};
+
+		struct ProgramUniforms
+		{
+			int model, inverseModel, view, projection, camPos, color;
+			int lightingEnabled, lightingColor, lightingAmbientStrength, lightingDirection;
+			int fogEnabled, fogColor, fogStart, fogEnd;
+			// set if the program reads the camera, lighting and fog from the SharedUniforms blocks
+			bool sharedBlocks;
+			ulong frame;
+		};
+
+		Window* m_pWin;
+		Camera* m_pCam;
+		Lighting* m_pLighting;
+		Fog* m_pFog;
+
+		std::vector<Item> m_items;
+		std::vector<Slot> m_slots;
+		std::vector<uint> m_freeSlots;
+		ulonglong m_nextSequence;
+		std::vector<SortEntry> m_sortEntries;
+		std::vector<SortEntry> m_sortScratch;
+		std::unordered_map<uint, ProgramUniforms> m_programUniforms;
+
+		uint m_boundProgram;
+		uint m_boundTexture;
+		uint m_boundVAO;
+		ulong m_frame;
+
+		RenderStats m_stats;
+
+		bool m_cullingEnabled;
+		bool m_fogCullingEnabled;
+
+		RenderHandle insert(ItemType type, RenderPass pass, void* ptr, const Bounds& bounds = Bounds(), bool hasBounds = false);
+		bool isCulled(const Item& item, const Frustum& frustum) const;
+
+		ulonglong makeKey(const Item& item) const;
+		void sortEntries();
+
+		void bindProgram(uint program);
+		void bindTexture(uint texture);
+		void bindVAO(uint vao);
+
+		void countItem(ItemType type);
+		void countDraw(uint drawCalls, ulonglong triangles);
+		void resetState();
+
+		ProgramUniforms& getProgramUniforms(uint program);
+		void drawRenderable(const Item& item);
+		void applyEnvironment(Shader& shader);
+		void uploadEnvironment(const ProgramUniforms& uniforms);
+	};
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	class SceneManager;
+	class RenderQueue;
+
+	/*
+		@brief A screen of the application (a menu, a game), run by a SceneManager.
+		Scenes are pushed onto and popped off the manager's stack, only the top one is updated and rendered.
+		A scene doesn't own the window or the GL context, so it must not dispose, close or terminate them,
+		and it should leave shared caches (ShaderCache, FontCache, PrimitiveCache...) alone so the next scene can reuse what's in them.
+	 */
+	class Scene
+	{
+	public:
+		virtual ~Scene() = default;
+
+		/*
+			@brief Called once when the scene is pushed, before it is first updated.
+			Configure the window, start loading the scene's assets and create everything that doesn't depend on them here.
+			@param manager The manager running the scene, keep it to push or pop scenes later.
+		 */
+		virtual void load(SceneManager& manager) = 0;
+
+		/*
+			@brief Called once per frame after load() until it returns true, before the scene is first updated. Nothing is drawn meanwhile.
+			Start loading through the AssetLoader in load() and create what depends on the loaded assets here, once their handles are loaded.
+			The manager does the AssetLoader's uploads every frame, so the scene doesn't have to.
+			@return True if the scene is ready to run (the default), false to wait for another frame.
+		 */
+		virtual bool finishLoad() { return true; }
+
+		/*
+			@brief Called once per frame while the scene is on top of the stack, before any ticks. Handle input here.
+			@param dt The time since the last frame, in seconds. On the first frame after the stack changed it is the time since the change was done or the scene finished loading, so loading isn't simulated.
+		 */
+		virtual void update(double dt) = 0;
+
+		/*
+			@brief Called at the fixed rate returned by getTickRate(), zero or more times per frame after update(). Advance the simulation here.
+			Never called if getTickRate() returns 0.
+			@param fixedDt The time simulated by one tick, in seconds.
+		 */
+		virtual void tick(double fixedDt) {}
+
+		/*
+			@brief Called once per frame after the ticks, between the window's startRender() and endRender().
+			Not called on a frame where the scene asked for the stack to change.
+			@param alpha How far the frame is between the last tick and the next one, from 0 to 1, to interpolate what is drawn. Always 1 if the scene has no tick rate.
+		 */
+		virtual void render(double alpha) = 0;
+
+		/*
+			@brief Called once when the scene is popped or replaced, or when the manager shuts down.
+			Dispose everything created in load() here.
+		 */
+		virtual void unload() = 0;
+
+		/*
+			@brief Called when another scene is pushed on top of this one. The scene stays loaded.
+		 */
+		virtual void pause() {}
+
+		/*
+			@brief Called when the scene is back on top of the stack after the one above it was popped.
+			The window was configured by the scene that was on top, so configure it again and relink the input handler and camera here.
+		 */
+		virtual void resume() {}
+
+		/*
+			@brief Gets the number of times per second tick() is called, read when the scene comes to the top of the stack.
+			@return The tick rate, or 0 (the default) for a scene that only updates once per frame.
+		 */
+		virtual double getTickRate() const { return 0.0; }
+
+		/*
+			@brief Gets the queue the scene renders with, so the performance overlay can show its stats.
+			@return The queue, or nullptr (the default) if the scene doesn't use one.
+		 */
+		virtual const RenderQueue* getRenderQueue() const { return nullptr; }
+	};
+}
@@ -0,0 +1,199 @@
+#include "SceneManager.h"
+
+#include <chrono>
+
+#include "RenderQueue.h"
+#include "AssetLoader.h"
+
+// nothing is drawn while the top scene is loading, so most of the frame can go to uploads
+const double LOADING_UPLOAD_BUDGET_MS = 12.0;
+
+Onyx::SceneManager::SceneManager()
+{
+	m_overlayKeyDown = false;
+}
+
+Onyx::SceneManager::SceneManager(const WindowProperties& properties)
+	: m_window(properties)
+{
+	m_overlayKeyDown = false;
+}
+
+void Onyx::SceneManager::init(bool* result)
+{
+	m_window.init(result);
+}
+
+void Onyx::SceneManager::run(std::unique_ptr<Scene> scene)
+{
+	push(std::move(scene));
+	applyPending();
+
+	while (m_window.isOpen() && !m_scenes.empty())
+	{
+		Slot& slot = m_scenes.back();
+		Scene& top = *slot.scene;
+
+		if (!slot.ready)
+		{
+			AssetLoader::Update(LOADING_UPLOAD_BUDGET_MS);
+			slot.ready = top.finishLoad();
+
+			if (!slot.ready || !m_pending.empty())
+			{
+				// the scene's input handler isn't updated until it is ready, so the window is kept responsive here
+				glfwPollEvents();
+				m_window.startRender();
+				m_window.endRender();
+				applyPending();
+				continue;
+			}
+
+			// the first frame is timed from here, so however long the loading took isn't simulated
+			m_lastFrame = std::chrono::steady_clock::now();
+			m_loop.reset();
+		}
+
+		auto frameStart = std::chrono::steady_clock::now();
+
+		// timed here rather than by the window, whose delta time isn't updated until startRender() and would include the last load
+		double dt = std::chrono::duration<double>(frameStart - m_lastFrame).count();
+		m_lastFrame = frameStart;
+
+		// polled here rather than through an InputHandler, since every scene links its own
+		bool overlayKeyDown = glfwGetKey(m_window.getGlfwWindowPtr(), GLFW_KEY_F3) == GLFW_PRESS;
+		if (overlayKeyDown && !m_overlayKeyDown) m_overlay.toggle();
+		m_overlayKeyDown = overlayKeyDown;
+
+		// loads started by a scene that is already running, like the launcher's previews
+		AssetLoader::Update();
+
+		top.update(dt);
+
+		double alpha = 1.0;
+		if (top.getTickRate() > 0.0 && m_pending.empty())
+		{
+			uint steps = m_loop.advance(dt);
+			for (uint i = 0; i < steps && m_pending.empty(); i++) top.tick(m_loop.getFixedDt());
+			alpha = m_loop.getAlpha();
+		}
+
+		// a scene that just asked to leave may already have released what it draws
+		if (m_pending.empty())
+		{
+			m_window.startRender();
+			m_overlay.beginGpuTimer();
+			top.render(alpha);
+			m_overlay.endGpuTimer();
+
+			// the swap can wait for vsync, so the CPU time stops before it
+			m_overlay.record(m_window.getDeltaTime(), std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count());
+			const RenderQueue* pQueue = top.getRenderQueue();
+			m_overlay.render(m_window, pQueue ? &pQueue->getStats() : nullptr);
+			m_window.endRender();
+		}
+
+		applyPending();
+	}
+
+	unloadAll();
+}
+
+void Onyx::SceneManager::push(std::unique_ptr<Scene> scene)
+{
+	m_pending.push_back({ Change::Push, std::move(scene) });
+}
+
+void Onyx::SceneManager::pop()
+{
+	m_pending.push_back({ Change::Pop, nullptr });
+}
+
+void Onyx::SceneManager::replace(std::unique_ptr<Scene> scene)
+{
+	m_pending.push_back({ Change::Replace, std::move(scene) });
+}
+
+void Onyx::SceneManager::configureWindow(const WindowProperties& properties)
+{
+	if (m_window.isFullscreen()) m_window.windowed(properties.width, properties.height, properties.position);
+
+	m_window.setTitle(properties.title);
+	m_window.setSize(properties.width, properties.height);
+	m_window.setPosition(properties.position);
+	m_window.setBackgroundColor(properties.backgroundColor);
+	m_window.setResizable(properties.resizable);
+	m_window.setDecorated(properties.decorated);
+}
+
+Onyx::Window& Onyx::SceneManager::getWindow()
+{
+	return m_window;
+}
+
+uint Onyx::SceneManager::getDepth() const
+{
+	return m_scenes.size();
+}
+
+const Onyx::GameLoop& Onyx::SceneManager::getLoop() const
+{
+	return m_loop;
+}
+
+Onyx::PerfOverlay& Onyx::SceneManager::getOverlay()
+{
+	return m_overlay;
+}
+
+void Onyx::SceneManager::dispose()
+{
+	if (m_disposed) return;
+	m_disposed = true;
+
+	unloadAll();
+	m_pending.clear();
+	m_overlay.dispose();
+	m_window.dispose();
+}
+
+void Onyx::SceneManager::applyPending()
+{
+	// loading a scene can queue more changes, so this goes by index rather than by iterator
+	for (size_t i = 0; i < m_pending.size(); i++)
+	{
+		Change change = m_pending[i].change;
+		std::unique_ptr<Scene> scene = std::move(m_pending[i].scene);
+
+		if ((change == Change::Pop || change == Change::Replace) && !m_scenes.empty())
+		{
+			m_scenes.back().scene->unload();
+			m_scenes.pop_back();
+			if (change == Change::Pop && !m_scenes.empty()) m_scenes.back().scene->resume();
+		}
+
+		if (change == Change::Push || change == Change::Replace)
+		{
+			if (change == Change::Push && !m_scenes.empty()) m_scenes.back().scene->pause();
+			m_scenes.push_back({ std::move(scene), false });
+			m_scenes.back().scene->load(*this);
+		}
+	}
+
+	if (m_pending.empty()) return;
+	m_pending.clear();
+
+	// the first frame after a change is timed from here, so however long the loading took isn't simulated
+	m_lastFrame = std::chrono::steady_clock::now();
+	m_loop.reset();
+	if (!m_scenes.empty() && m_scenes.back().scene->getTickRate() > 0.0) m_loop.setTickRate(m_scenes.back().scene->getTickRate());
+}
+
+void Onyx::SceneManager::unloadAll()
+{
+	while (!m_scenes.empty())
+	{
+		m_scenes.back().scene->unload();
+		m_scenes.pop_back();
+	}
+}
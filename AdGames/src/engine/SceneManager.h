@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <Onyx/Core.h>
+#include <Onyx/Window.h>
+
+#include "Scene.h"
+#include "GameLoop.h"
+#include "PerfOverlay.h"
+
+namespace Onyx
+{
+	/*
+		@brief Owns the one window (and so the one GL context) of the application and runs a stack of scenes in it.
+		Switching scenes only unloads and loads the scenes themselves, the context and everything cached in it stay alive,
+		and since the stack is a loop rather than a chain of calls, switching any number of times doesn't grow the call stack.
+		Changes to the stack made by a scene during its update are applied at the end of the frame.
+		The AssetLoader's uploads are done every frame, and a scene that was just pushed isn't updated or drawn until its finishLoad() returns true.
+		Scenes with a tick rate are ticked through a GameLoop, at most GameLoop::DEFAULT_MAX_STEPS times per frame.
+		F3 toggles a PerfOverlay over every scene.
+		This class is disposable.
+	 */
+	class SceneManager : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+		 */
+		SceneManager();
+
+		/*
+			@brief Creates a new SceneManager with a window with the specified properties. The window isn't created until init() is called.
+			Properties that can't change after the window is created, like the MSAA samples, are shared by every scene.
+			@param properties The initial properties of the window.
+		 */
+		SceneManager(const WindowProperties& properties);
+
+		/*
+			@brief Creates the window and its GL context. Onyx must be initialized first.
+			@param result A pointer to a boolean that will be set to true if the window was created, and false otherwise.
+		 */
+		void init(bool* result = nullptr);
+
+		/*
+			@brief Pushes a scene and runs the stack until it is empty or the window is closed, then unloads every scene left.
+			@param scene The first scene.
+		 */
+		void run(std::unique_ptr<Scene> scene);
+
+		/*
+			@brief Pushes a scene on top of the stack at the end of the frame. The current scene is paused, not unloaded.
+			@param scene The scene to push.
+		 */
+		void push(std::unique_ptr<Scene> scene);
+
+		/*
+			@brief Pops the top scene at the end of the frame, resuming the one under it. Popping the last scene ends run().
+		 */
+		void pop();
+
+		/*
+			@brief Replaces the top scene at the end of the frame, without resuming the one under it in between.
+			@param scene The scene to replace it with.
+		 */
+		void replace(std::unique_ptr<Scene> scene);
+
+		/*
+			@brief Applies the resettable properties of a window: the title, size, position, background color, resizability and decoration.
+			Leaves fullscreen first if the window is fullscreen. Scenes call this from load() and resume().
+			@param properties The properties to apply.
+		 */
+		void configureWindow(const WindowProperties& properties);
+
+		/*
+			@brief Gets the window.
+			@return The window.
+		 */
+		Window& getWindow();
+
+		/*
+			@brief Gets the number of scenes on the stack.
+			@return The number of scenes.
+		 */
+		uint getDepth() const;
+
+		/*
+			@brief Gets the fixed timestep loop that ticks the top scene.
+			@return The loop.
+		 */
+		const GameLoop& getLoop() const;
+
+		/*
+			@brief Gets the performance overlay drawn over the scenes.
+			@return The overlay.
+		 */
+		PerfOverlay& getOverlay();
+
+		/*
+			@brief Unloads every scene and disposes the overlay and the window.
+		 */
+		void dispose() override;
+
+	private:
+		enum class Change
+		{
+			Push,
+			Pop,
+			Replace
+		};
+
+		struct PendingChange
+		{
+			Change change;
+			std::unique_ptr<Scene> scene;
+		};
+
+		struct Slot
+		{
+			std::unique_ptr<Scene> scene;
+			// whether finishLoad() returned true yet
+			bool ready;
+		};
+
+		Window m_window;
+		std::vector<Slot> m_scenes;
+		std::vector<PendingChange> m_pending;
+		GameLoop m_loop;
+		// when the last frame started, or when the stack last changed if that was later
+		std::chrono::steady_clock::time_point m_lastFrame;
+		PerfOverlay m_overlay;
+		bool m_overlayKeyDown;
+
+		void applyPending();
+		void unloadAll();
+	};
+}
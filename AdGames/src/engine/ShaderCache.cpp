@@ -0,0 +1,205 @@
+#include "ShaderCache.h"
+
+#include <cstdio>
+#include <filesystem>
+
+#include <glad/glad.h>
+#include <Onyx/FileUtils.h>
+
+#include "Hash.h"
+#include "UniformCache.h"
+#include "SharedUniforms.h"
+#include "PrimitiveCache.h"
+#include "CookedModel.h"
+
+std::unordered_map<ulonglong, Onyx::Shader> Onyx::ShaderCache::sm_shaders;
+std::unordered_map<std::string, ulonglong> Onyx::ShaderCache::sm_pathHashes;
+std::unordered_map<uint, ulonglong> Onyx::ShaderCache::sm_programHashes;
+const char* const Onyx::ShaderCache::DEFAULT_BINARY_DIR = "cache/shaders";
+std::string Onyx::ShaderCache::sm_binaryDir;
+bool Onyx::ShaderCache::sm_binaryDirSet = false;
+
+// binaries only load on the driver that saved them, so it is part of their key
+static ulonglong DriverHash()
+{
+	static ulonglong hash = 0;
+	if (hash == 0)
+	{
+		std::string driver;
+		for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+		{
+			const char* str = (const char*)glGetString(name);
+			driver += str ? str : "";
+			driver += '\n';
+		}
+		hash = Onyx::HashFNV1a64(driver);
+	}
+	return hash;
+}
+
+Onyx::Shader Onyx::ShaderCache::Load(const std::string& combinedPath, bool* result)
+{
+	// remembering which source a path had saves reading and hashing the file again
+	auto pathIt = sm_pathHashes.find(combinedPath);
+	if (pathIt != sm_pathHashes.end())
+	{
+		auto shaderIt = sm_shaders.find(pathIt->second);
+		if (shaderIt != sm_shaders.end())
+		{
+			if (result) *result = true;
+			return shaderIt->second;
+		}
+	}
+
+	// combined files are the vertex shader, a line with #switch, then the fragment shader
+	bool read = false;
+	std::string source = FileUtils::Read(combinedPath, &read);
+	size_t split = source.find("#switch");
+	if (!read || split == std::string::npos)
+	{
+		if (result) *result = false;
+		return Shader();
+	}
+
+	size_t fragStart = source.find('\n', split);
+	std::string vertSource = source.substr(0, split);
+	std::string fragSource = fragStart == std::string::npos ? "" : source.substr(fragStart + 1);
+
+	bool success = false;
+	Shader shader = Get(vertSource, fragSource, &success);
+	if (success) sm_pathHashes[combinedPath] = sm_programHashes[shader.getProgramID()];
+
+	if (result) *result = success;
+	return shader;
+}
+
+Onyx::Shader Onyx::ShaderCache::Get(const std::string& vertSource, const std::string& fragSource, bool* result)
+{
+	ulonglong hash = HashFNV1a64(vertSource) ^ (HashFNV1a64(fragSource) * 1099511628211ull);
+
+	auto it = sm_shaders.find(hash);
+	if (it != sm_shaders.end())
+	{
+		if (result) *result = true;
+		return it->second;
+	}
+
+	bool success = false;
+	Shader shader = Link(hash, vertSource, fragSource, &success);
+	if (!success)
+	{
+		if (result) *result = false;
+		return Shader();
+	}
+
+	SharedUniforms::BindBlocks(shader.getProgramID());
+
+	sm_shaders[hash] = shader;
+	sm_programHashes[shader.getProgramID()] = hash;
+
+	if (result) *result = true;
+	return shader;
+}
+
+Onyx::Shader Onyx::ShaderCache::P_Color(bool* result)
+{
+	return Load(Resources("shaders/ubo/P_Color.glsl"), result);
+}
+
+Onyx::Shader Onyx::ShaderCache::Link(ulonglong hash, const std::string& vertSource, const std::string& fragSource, bool* result)
+{
+	namespace fs = std::filesystem;
+
+	char name[20];
+	snprintf(name, sizeof(name), "%016llx", hash ^ (DriverHash() * 1099511628211ull));
+	const std::string& binaryDir = GetBinaryDir();
+	std::string binaryPath = binaryDir + "/" + name + ".bin";
+	std::error_code error;
+
+	bool success = false;
+	Shader shader;
+	if (!binaryDir.empty() && fs::exists(binaryPath, error))
+	{
+		shader = Shader::LoadBinary(binaryPath, &success);
+		if (success)
+		{
+			if (result) *result = true;
+			return shader;
+		}
+
+		// usually a driver update, fall through and replace it
+		shader.dispose();
+	}
+
+	shader = Shader(vertSource.c_str(), fragSource.c_str(), &success);
+	if (!success)
+	{
+		shader.dispose();
+		if (result) *result = false;
+		return shader;
+	}
+
+	// a failed save only costs the next launch a compile
+	if (!binaryDir.empty())
+	{
+		fs::create_directories(binaryDir, error);
+		shader.saveBinary(binaryDir, name);
+	}
+
+	if (result) *result = true;
+	return shader;
+}
+
+void Onyx::ShaderCache::SetBinaryDir(const std::string& dir)
+{
+	sm_binaryDir = dir;
+	sm_binaryDirSet = true;
+}
+
+const std::string& Onyx::ShaderCache::GetBinaryDir()
+{
+	// resolved on first use rather than at static initialization, so it follows a resource path set after startup
+	if (!sm_binaryDirSet)
+	{
+		sm_binaryDir = Resources(DEFAULT_BINARY_DIR);
+		sm_binaryDirSet = true;
+	}
+	return sm_binaryDir;
+}
+
+bool Onyx::ShaderCache::Contains(const Shader& shader)
+{
+	return sm_programHashes.find(shader.getProgramID()) != sm_programHashes.end();
+}
+
+void Onyx::ShaderCache::DisposeRenderable(Renderable& renderable)
+{
+	bool sharedShader = Contains(*renderable.getShader());
+	bool sharedMesh = PrimitiveCache::Contains(*renderable.getMesh()) || CookedModel::Contains(*renderable.getMesh());
+	bool sharedTexture = CookedModel::Contains(*renderable.getTexture());
+	if (!sharedShader && !sharedMesh && !sharedTexture)
+	{
+		renderable.dispose();
+		return;
+	}
+
+	if (!sharedShader) renderable.getShader()->dispose();
+	if (!sharedMesh) renderable.getMesh()->dispose();
+	if (!sharedTexture) renderable.getTexture()->dispose();
+}
+
+uint Onyx::ShaderCache::GetCount()
+{
+	return sm_shaders.size();
+}
+
+void Onyx::ShaderCache::Clear()
+{
+	for (auto& [hash, shader] : sm_shaders) shader.dispose();
+
+	sm_shaders.clear();
+	sm_pathHashes.clear();
+	sm_programHashes.clear();
+
+	UniformCache::Clear();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <Onyx/Core.h>
+#include <Onyx/Shader.h>
+#include <Onyx/Renderable.h>
+
+namespace Onyx
+{
+	/*
+		@brief A registry of linked shader programs, keyed by a hash of their source code.
+		Loading the same source twice gives back the same program instead of compiling and linking a new one,
+		so anything that differs between objects sharing a program (like their color) has to be set per draw.
+		The cache owns its programs. Shaders from it must not be disposed directly, use DisposeRenderable() for renderables that use them.
+		Programs that declare the SharedUniforms blocks have them bound when they are linked.
+		Linked programs are also saved to disk as program binaries, keyed by the source and the GL driver,
+		so later launches load them instead of compiling and linking again. A binary the driver rejects is recompiled and replaced.
+		Call Clear() before the GL context is destroyed.
+	 */
+	class ShaderCache
+	{
+	public:
+		/*
+			@brief Gets the program for a combined shader source file (a vertex and fragment shader separated by #switch), compiling it if it isn't cached yet.
+			@param combinedPath The path to the combined source file.
+			@param result A pointer to a boolean that will be set to true if the shader was found or compiled successfully, and false otherwise.
+			@return The shared shader.
+		 */
+		static Shader Load(const std::string& combinedPath, bool* result = nullptr);
+
+		/*
+			@brief Gets the program for the specified vertex and fragment shader source code, compiling it if it isn't cached yet.
+			@param vertSource The vertex shader source code.
+			@param fragSource The fragment shader source code.
+			@param result A pointer to a boolean that will be set to true if the shader was found or compiled successfully, and false otherwise.
+			@return The shared shader.
+		 */
+		static Shader Get(const std::string& vertSource, const std::string& fragSource, bool* result = nullptr);
+
+		/*
+			@brief Gets the shared P_Color program. Unlike Shader::P_Color, the color is not baked in, set u_color per draw instead.
+				The camera and fog come from the SharedUniforms blocks rather than uniforms in the program.
+			@param result A pointer to a boolean that will be set to true if the shader was found or compiled successfully, and false otherwise.
+			@return The shared shader.
+		 */
+		static Shader P_Color(bool* result = nullptr);
+
+		/*
+			@brief Sets the directory program binaries are saved to and loaded from. It is created when the first binary is saved.
+			@param dir The directory, or an empty string to turn the binary cache off. Defaults to DEFAULT_BINARY_DIR under the resource path.
+		 */
+		static void SetBinaryDir(const std::string& dir);
+
+		/*
+			@brief Gets the directory program binaries are saved to and loaded from.
+			@return The directory, empty if the binary cache is off.
+		 */
+		static const std::string& GetBinaryDir();
+
+		/*
+			@brief The default directory for program binaries, relative to the resource path (see Onyx::Resources()), so it doesn't depend on the working directory.
+		 */
+		static const char* const DEFAULT_BINARY_DIR;
+
+		/*
+			@brief Gets whether a shader's program belongs to the cache.
+			@param shader The shader to check.
+			@return True if the program is shared through the cache, false if not.
+		 */
+		static bool Contains(const Shader& shader);
+
+		/*
+			@brief Disposes a renderable, leaving its shader alone if it belongs to the cache, its mesh alone if it belongs to the PrimitiveCache or a CookedModel, and its texture alone if it belongs to a CookedModel.
+			@param renderable The renderable to dispose.
+		 */
+		static void DisposeRenderable(Renderable& renderable);
+
+		/*
+			@brief Gets the number of programs in the cache.
+			@return The number of programs.
+		 */
+		static uint GetCount();
+
+		/*
+			@brief Disposes every program in the cache, and clears the uniform location cache since program names will be reused.
+		 */
+		static void Clear();
+
+	private:
+		static std::unordered_map<ulonglong, Shader> sm_shaders;
+		static std::unordered_map<std::string, ulonglong> sm_pathHashes;
+		static std::unordered_map<uint, ulonglong> sm_programHashes;
+		static std::string sm_binaryDir;
+		static bool sm_binaryDirSet;
+
+		static Shader Link(ulonglong hash, const std::string& vertSource, const std::string& fragSource, bool* result);
+	};
+}
@@ -0,0 +1,274 @@
+#include "ShapeBatch.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "ShaderCache.h"
+#include "PrimitiveCache.h"
+
+// how long to wait for the GPU to finish reading a segment before writing over it anyway
+const GLuint64 FENCE_TIMEOUT_NS = 1000000000;
+
+Onyx::ShapeBatch::ShapeBatch()
+{
+	m_vao = 0;
+	m_vbo = 0;
+	m_whiteTexture = 0;
+	m_segmentCapacity = 0;
+	m_segment = 0;
+	m_segmentUsed = 0;
+	for (uint i = 0; i < N_SEGMENTS; i++) m_fences[i] = nullptr;
+	m_drawCount = 0;
+}
+
+Onyx::ShapeBatch::ShapeBatch(uint segmentCapacity, bool* result)
+	: ShapeBatch()
+{
+	m_shader = ShaderCache::Load(Resources("shaders/ubo/ShapeBatch.glsl"), result);
+
+	// whole triangles only, so a segment never ends partway through one
+	m_segmentCapacity = segmentCapacity - segmentCapacity % 3;
+	if (m_segmentCapacity == 0) m_segmentCapacity = 3;
+
+	glGenVertexArrays(1, &m_vao);
+	glBindVertexArray(m_vao);
+
+	glGenBuffers(1, &m_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glBufferData(GL_ARRAY_BUFFER, N_SEGMENTS * m_segmentCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, pos));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// untextured shapes sample a single white texel, so every shape can go through the same program
+	unsigned char white[4] = { 255, 255, 255, 255 };
+	glGenTextures(1, &m_whiteTexture);
+	glBindTexture(GL_TEXTURE_2D, m_whiteTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Onyx::ShapeBatch::drawCircle(const Math::Vec3& center, float radius, int nSegments, float rotation, const Math::Vec4& rgba)
+{
+	if (nSegments < 3) return;
+
+	beginCommand(m_whiteTexture, nSegments * 3);
+
+	float x = center.getX(), y = center.getY(), z = center.getZ();
+
+	// rotating the shared unit circle costs one sine and cosine per circle instead of one per vertex
+	const std::vector<Math::Vec2>& points = PrimitiveCache::CirclePoints(nSegments);
+	float c = radius, s = 0.0f;
+	if (rotation != 0.0f)
+	{
+		c = radius * Math::Cos(Math::Radians(rotation));
+		s = radius * Math::Sin(Math::Radians(rotation));
+	}
+
+	float prevX = x + c, prevY = y + s;
+	for (int i = 1; i <= nSegments; i++)
+	{
+		const Math::Vec2& point = points[i % nSegments];
+		float nextX = x + point.getX() * c - point.getY() * s, nextY = y + point.getX() * s + point.getY() * c;
+
+		pushVertex(x, y, z, rgba, 0.5f, 0.5f);
+		pushVertex(prevX, prevY, z, rgba, 0.5f, 0.5f);
+		pushVertex(nextX, nextY, z, rgba, 0.5f, 0.5f);
+
+		prevX = nextX;
+		prevY = nextY;
+	}
+}
+
+void Onyx::ShapeBatch::drawQuad(const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba)
+{
+	pushQuad(m_whiteTexture, center, size, rotation, rgba);
+}
+
+void Onyx::ShapeBatch::drawTexturedQuad(const Texture& texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba)
+{
+	pushQuad(texture.getTextureID(), center, size, rotation, rgba);
+}
+
+void Onyx::ShapeBatch::drawTexturedQuad(const Texture2D& texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba)
+{
+	pushQuad(texture.getTextureID(), center, size, rotation, rgba);
+}
+
+void Onyx::ShapeBatch::render()
+{
+	m_drawCount = 0;
+	if (m_vertices.empty()) return;
+
+	m_shader.use();
+	glBindVertexArray(m_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glActiveTexture(GL_TEXTURE0);
+
+	uint total = m_vertices.size();
+	uint uploaded = 0;
+	uint command = 0;
+	uint boundTexture = 0;
+
+	while (uploaded < total)
+	{
+		uint space = m_segmentCapacity - m_segmentUsed;
+		if (space == 0)
+		{
+			nextSegment();
+			continue;
+		}
+
+		uint count = total - uploaded < space ? total - uploaded : space;
+		uint bufferFirst = m_segment * m_segmentCapacity + m_segmentUsed;
+
+		// nothing the GPU could still be reading is in this range, the fences make sure of that, so there's no need for the driver to synchronize
+		void* pData = glMapBufferRange(GL_ARRAY_BUFFER, bufferFirst * sizeof(Vertex), count * sizeof(Vertex), GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+		if (pData)
+		{
+			memcpy(pData, m_vertices.data() + uploaded, count * sizeof(Vertex));
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+
+		// draw the part of every command that landed in this range, a command split between segments is drawn once in each
+		uint end = uploaded + count;
+		while (command < m_commands.size())
+		{
+			const Command& cmd = m_commands[command];
+			uint start = cmd.first > uploaded ? cmd.first : uploaded;
+			uint stop = cmd.first + cmd.count < end ? cmd.first + cmd.count : end;
+
+			if (stop > start)
+			{
+				if (cmd.texture != boundTexture)
+				{
+					glBindTexture(GL_TEXTURE_2D, cmd.texture);
+					boundTexture = cmd.texture;
+				}
+				glDrawArrays(GL_TRIANGLES, bufferFirst + (start - uploaded), stop - start);
+				m_drawCount++;
+			}
+
+			if (cmd.first + cmd.count > end) break;
+			command++;
+		}
+
+		uploaded = end;
+		m_segmentUsed += count;
+	}
+
+	// the next frame starts on a fresh segment, which leaves the GPU two frames to finish with this one
+	nextSegment();
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	glUseProgram(0);
+
+	m_vertices.clear();
+	m_commands.clear();
+}
+
+uint Onyx::ShapeBatch::getVertexCount() const
+{
+	return m_vertices.size();
+}
+
+uint Onyx::ShapeBatch::getDrawCount() const
+{
+	return m_drawCount;
+}
+
+Onyx::Shader* Onyx::ShapeBatch::getShader()
+{
+	return &m_shader;
+}
+
+void Onyx::ShapeBatch::dispose()
+{
+	if (m_disposed) return;
+
+	for (uint i = 0; i < N_SEGMENTS; i++)
+	{
+		if (m_fences[i]) glDeleteSync((GLsync)m_fences[i]);
+		m_fences[i] = nullptr;
+	}
+
+	glDeleteVertexArrays(1, &m_vao);
+	glDeleteBuffers(1, &m_vbo);
+	glDeleteTextures(1, &m_whiteTexture);
+
+	m_vertices.clear();
+	m_commands.clear();
+
+	m_disposed = true;
+}
+
+void Onyx::ShapeBatch::pushVertex(float x, float y, float z, const Math::Vec4& rgba, float u, float v)
+{
+	Vertex vertex = { { x, y, z }, { rgba.getX(), rgba.getY(), rgba.getZ(), rgba.getW() }, { u, v } };
+	m_vertices.push_back(vertex);
+}
+
+void Onyx::ShapeBatch::pushQuad(uint texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba)
+{
+	beginCommand(texture, 6);
+
+	float halfW = size.getX() / 2.0f, halfH = size.getY() / 2.0f;
+	float c = 1.0f, s = 0.0f;
+	if (rotation != 0.0f)
+	{
+		c = Math::Cos(Math::Radians(rotation));
+		s = Math::Sin(Math::Radians(rotation));
+	}
+
+	// bottom left, bottom right, top right, top left
+	const float corners[4][2] = { { -halfW, -halfH }, { halfW, -halfH }, { halfW, halfH }, { -halfW, halfH } };
+	const float texCoords[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+	const int order[6] = { 0, 1, 2, 2, 3, 0 };
+
+	for (int i : order)
+	{
+		float x = center.getX() + corners[i][0] * c - corners[i][1] * s;
+		float y = center.getY() + corners[i][0] * s + corners[i][1] * c;
+		pushVertex(x, y, center.getZ(), rgba, texCoords[i][0], texCoords[i][1]);
+	}
+}
+
+void Onyx::ShapeBatch::beginCommand(uint texture, uint nVertices)
+{
+	if (!m_commands.empty() && m_commands.back().texture == texture)
+	{
+		m_commands.back().count += nVertices;
+		return;
+	}
+
+	m_commands.push_back(Command{ texture, (uint)m_vertices.size(), nVertices });
+}
+
+void Onyx::ShapeBatch::nextSegment()
+{
+	if (m_fences[m_segment]) glDeleteSync((GLsync)m_fences[m_segment]);
+	m_fences[m_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	m_segment = (m_segment + 1) % N_SEGMENTS;
+	m_segmentUsed = 0;
+
+	if (m_fences[m_segment])
+	{
+		glClientWaitSync((GLsync)m_fences[m_segment], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+		glDeleteSync((GLsync)m_fences[m_segment]);
+		m_fences[m_segment] = nullptr;
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+
+#include <Onyx/Core.h>
+#include <Onyx/Shader.h>
+#include <Onyx/Texture.h>
+#include <Onyx/Math.h>
+
+#include "Texture2D.h"
+
+namespace Onyx
+{
+	/*
+		@brief A class to draw large numbers of flat 2D shapes with as few draw calls as possible, without any GPU objects per shape.
+		Shapes are drawn immediate mode style: call the draw functions every frame, then render() draws everything and clears the batch.
+		Vertices are transformed on the CPU and streamed into a vertex buffer split into three segments, so the GPU can still be reading
+		the previous frames' vertices while the next frame is written. Consecutive shapes with the same texture are drawn with one draw call.
+		The camera is read from the SharedUniforms camera block, so it must have been set before render() is called.
+		This class is disposable.
+	 */
+	class ShapeBatch : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+		 */
+		ShapeBatch();
+
+		/*
+			@brief Creates a new ShapeBatch object.
+			@param segmentCapacity The number of vertices each of the three buffer segments can hold. A frame with more vertices than this moves on to the next segment, waiting for the GPU if it has to.
+			@param result A pointer to a boolean that will be set to true if the batch shader was successfully compiled, and false otherwise.
+		 */
+		ShapeBatch(uint segmentCapacity, bool* result = nullptr);
+
+		/*
+			@brief Draws a filled circle.
+			@param center The center of the circle. The z coordinate is used for depth.
+			@param radius The radius of the circle.
+			@param nSegments The number of segments (sides) of the circle.
+			@param rotation The rotation of the circle around its center, in degrees.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void drawCircle(const Math::Vec3& center, float radius, int nSegments, float rotation, const Math::Vec4& rgba);
+
+		/*
+			@brief Draws a filled quad.
+			@param center The center of the quad. The z coordinate is used for depth.
+			@param size The width and height of the quad.
+			@param rotation The rotation of the quad around its center, in degrees.
+			@param rgba The color, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void drawQuad(const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba);
+
+		/*
+			@brief Draws a textured quad.
+			Switching textures starts a new draw call, so draw shapes with the same texture one after another where possible.
+			@param texture The texture to use. It is not owned by the batch.
+			@param center The center of the quad. The z coordinate is used for depth.
+			@param size The width and height of the quad.
+			@param rotation The rotation of the quad around its center, in degrees.
+			@param rgba The color to multiply the texture by, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void drawTexturedQuad(const Texture& texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba = Math::Vec4::White());
+
+		/*
+			@brief Draws a textured quad with a texture created from a decoded image.
+			See the other overload for details.
+			@param texture The texture to use. It is not owned by the batch.
+			@param center The center of the quad. The z coordinate is used for depth.
+			@param size The width and height of the quad.
+			@param rotation The rotation of the quad around its center, in degrees.
+			@param rgba The color to multiply the texture by, specified as red, green, blue, and alpha (transparency) values ranging from 0 to 1.
+		 */
+		void drawTexturedQuad(const Texture2D& texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba = Math::Vec4::White());
+
+		/*
+			@brief Draws everything in the batch, then clears it.
+			Does nothing if the batch is empty.
+		 */
+		void render();
+
+		/*
+			@brief Gets the number of vertices that will be drawn by the next call to render().
+			@return The number of vertices.
+		 */
+		uint getVertexCount() const;
+
+		/*
+			@brief Gets the number of draw calls made by the last call to render().
+			@return The number of draw calls.
+		 */
+		uint getDrawCount() const;
+
+		/*
+			@brief Gets the batch shader.
+			@return A pointer to the shader.
+		 */
+		Shader* getShader();
+
+		void dispose() override;
+
+	private:
+		struct Vertex
+		{
+			float pos[3];
+			float color[4];
+			float texCoords[2];
+		};
+
+		// a run of consecutive vertices with the same texture
+		struct Command
+		{
+			uint texture;
+			uint first;
+			uint count;
+		};
+
+		static const uint N_SEGMENTS = 3;
+
+		Shader m_shader;
+		uint m_vao;
+		uint m_vbo;
+		uint m_whiteTexture;
+
+		uint m_segmentCapacity;
+		uint m_segment;
+		uint m_segmentUsed;
+		// GLsync objects, one per segment, set once the GPU has been given draws that read the segment
+		void* m_fences[N_SEGMENTS];
+
+		std::vector<Vertex> m_vertices;
+		std::vector<Command> m_commands;
+		uint m_drawCount;
+
+		void pushVertex(float x, float y, float z, const Math::Vec4& rgba, float u, float v);
+		void pushQuad(uint texture, const Math::Vec3& center, const Math::Vec2& size, float rotation, const Math::Vec4& rgba);
+		void beginCommand(uint texture, uint nVertices);
+		void nextSegment();
+	};
+}
@@ -0,0 +1,134 @@
+#include "SharedUniforms.h"
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+uint Onyx::SharedUniforms::sm_cameraUBO = 0;
+uint Onyx::SharedUniforms::sm_lightingUBO = 0;
+uint Onyx::SharedUniforms::sm_fogUBO = 0;
+ubyte Onyx::SharedUniforms::sm_lightingData[LIGHTING_BLOCK_SIZE] = { 0 };
+ubyte Onyx::SharedUniforms::sm_fogData[FOG_BLOCK_SIZE] = { 0 };
+
+bool Onyx::SharedUniforms::BindBlocks(uint program)
+{
+	bool found = false;
+
+	const char* names[3] = { "CameraBlock", "LightingBlock", "FogBlock" };
+	const uint bindings[3] = { CAMERA_BINDING, LIGHTING_BINDING, FOG_BINDING };
+	for (int i = 0; i < 3; i++)
+	{
+		uint index = glGetUniformBlockIndex(program, names[i]);
+		if (index == GL_INVALID_INDEX) continue;
+
+		glUniformBlockBinding(program, index, bindings[i]);
+		found = true;
+	}
+
+	return found;
+}
+
+bool Onyx::SharedUniforms::UsesCameraBlock(uint program)
+{
+	return glGetUniformBlockIndex(program, "CameraBlock") != GL_INVALID_INDEX;
+}
+
+void Onyx::SharedUniforms::SetCamera(const Camera& cam)
+{
+	if (sm_cameraUBO == 0) CreateBuffers();
+
+	unsigned char data[CAMERA_BLOCK_SIZE] = { 0 };
+	memcpy(data, cam.getViewMatrix().data(), 64);
+	memcpy(data + 64, cam.getProjectionMatrix().data(), 64);
+	memcpy(data + 128, cam.getPosition().data(), 12);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_cameraUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, CAMERA_BLOCK_SIZE, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Onyx::SharedUniforms::SetLighting(const Lighting* pLighting)
+{
+	if (sm_lightingUBO == 0) CreateBuffers();
+
+	unsigned char data[LIGHTING_BLOCK_SIZE] = { 0 };
+	if (pLighting)
+	{
+		float ambientStrength = pLighting->getAmbientStrength();
+		int enabled = 1;
+		memcpy(data, pLighting->getColor().data(), 12);
+		memcpy(data + 12, &ambientStrength, 4);
+		memcpy(data + 16, pLighting->getDirection().data(), 12);
+		memcpy(data + 28, &enabled, 4);
+	}
+
+	if (memcmp(data, sm_lightingData, LIGHTING_BLOCK_SIZE) == 0) return;
+	memcpy(sm_lightingData, data, LIGHTING_BLOCK_SIZE);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_lightingUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, LIGHTING_BLOCK_SIZE, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Onyx::SharedUniforms::SetFog(const Fog* pFog)
+{
+	if (sm_fogUBO == 0) CreateBuffers();
+
+	unsigned char data[FOG_BLOCK_SIZE] = { 0 };
+	if (pFog)
+	{
+		float start = pFog->getStart();
+		float end = pFog->getEnd();
+		int enabled = 1;
+		memcpy(data, pFog->getColor().data(), 12);
+		memcpy(data + 12, &start, 4);
+		memcpy(data + 16, &end, 4);
+		memcpy(data + 20, &enabled, 4);
+	}
+
+	if (memcmp(data, sm_fogData, FOG_BLOCK_SIZE) == 0) return;
+	memcpy(sm_fogData, data, FOG_BLOCK_SIZE);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_fogUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, FOG_BLOCK_SIZE, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Onyx::SharedUniforms::Clear()
+{
+	if (sm_cameraUBO == 0) return;
+
+	uint buffers[3] = { sm_cameraUBO, sm_lightingUBO, sm_fogUBO };
+	glDeleteBuffers(3, buffers);
+
+	sm_cameraUBO = 0;
+	sm_lightingUBO = 0;
+	sm_fogUBO = 0;
+	memset(sm_lightingData, 0, LIGHTING_BLOCK_SIZE);
+	memset(sm_fogData, 0, FOG_BLOCK_SIZE);
+}
+
+void Onyx::SharedUniforms::CreateBuffers()
+{
+	uint buffers[3];
+	glGenBuffers(3, buffers);
+	sm_cameraUBO = buffers[0];
+	sm_lightingUBO = buffers[1];
+	sm_fogUBO = buffers[2];
+
+	// zeroed buffers leave lighting and fog disabled until they're set
+	unsigned char zeros[CAMERA_BLOCK_SIZE] = { 0 };
+
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_cameraUBO);
+	glBufferData(GL_UNIFORM_BUFFER, CAMERA_BLOCK_SIZE, zeros, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_lightingUBO);
+	glBufferData(GL_UNIFORM_BUFFER, LIGHTING_BLOCK_SIZE, zeros, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, sm_fogUBO);
+	glBufferData(GL_UNIFORM_BUFFER, FOG_BLOCK_SIZE, zeros, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// binding points are context state, so the buffers stay bound to them no matter which program is in use
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, sm_cameraUBO);
+	glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTING_BINDING, sm_lightingUBO);
+	glBindBufferBase(GL_UNIFORM_BUFFER, FOG_BINDING, sm_fogUBO);
+}
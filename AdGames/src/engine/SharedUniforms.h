@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Onyx/Core.h>
+#include <Onyx/Camera.h>
+#include <Onyx/Lighting.h>
+#include <Onyx/Fog.h>
+
+namespace Onyx
+{
+	/*
+		@brief A class to hold the camera, lighting and fog uniforms in std140 uniform buffers shared by every program that declares the matching blocks.
+		The shaders in resources/shaders/ubo declare CameraBlock, LightingBlock and FogBlock, and programs from the ShaderCache have their blocks bound automatically.
+		Setting the camera is one buffer write per frame no matter how many programs use it, and setting the lighting or fog only writes the buffer if it changed.
+		The buffers are created the first time they are written to. Call Clear() before the GL context is destroyed.
+	 */
+	class SharedUniforms
+	{
+	public:
+		static const uint CAMERA_BINDING = 0;
+		static const uint LIGHTING_BINDING = 1;
+		static const uint FOG_BINDING = 2;
+
+		/*
+			@brief Binds any of the shared blocks a program declares to their binding points.
+			GLSL 4.1 can't set block bindings in the shader, so this has to be done once per program after it is linked.
+			@param program The ID of the shader program.
+			@return True if the program declares at least one of the shared blocks, false if not.
+		 */
+		static bool BindBlocks(uint program);
+
+		/*
+			@brief Gets whether a program reads the camera from the shared camera block.
+			@param program The ID of the shader program.
+			@return True if the program declares CameraBlock, false if it uses the separate camera uniforms.
+		 */
+		static bool UsesCameraBlock(uint program);
+
+		/*
+			@brief Writes the view matrix, projection matrix and position of a camera to the camera block.
+			@param cam The camera to use.
+		 */
+		static void SetCamera(const Camera& cam);
+
+		/*
+			@brief Writes lighting settings to the lighting block, unless it already holds them.
+			@param pLighting A pointer to the lighting settings to use, or nullptr to disable lighting.
+		 */
+		static void SetLighting(const Lighting* pLighting);
+
+		/*
+			@brief Writes fog settings to the fog block, unless it already holds them.
+			@param pFog A pointer to the fog settings to use, or nullptr to disable fog.
+		 */
+		static void SetFog(const Fog* pFog);
+
+		/*
+			@brief Deletes the uniform buffers.
+		 */
+		static void Clear();
+
+	private:
+		// std140 layouts, a vec3 is aligned to 16 bytes but a scalar right after it fills its last 4
+		//   CameraBlock:   mat4 view (0), mat4 projection (64), vec3 pos (128)
+		//   LightingBlock: vec3 color (0), float ambientStrength (12), vec3 direction (16), bool enabled (28)
+		//   FogBlock:      vec3 color (0), float start (12), float end (16), bool enabled (20)
+		static const uint CAMERA_BLOCK_SIZE = 144;
+		static const uint LIGHTING_BLOCK_SIZE = 32;
+		static const uint FOG_BLOCK_SIZE = 32;
+
+		static uint sm_cameraUBO;
+		static uint sm_lightingUBO;
+		static uint sm_fogUBO;
+
+		// what the lighting and fog buffers last had written to them, by anyone
+		static ubyte sm_lightingData[LIGHTING_BLOCK_SIZE];
+		static ubyte sm_fogData[FOG_BLOCK_SIZE];
+
+		static void CreateBuffers();
+	};
+}
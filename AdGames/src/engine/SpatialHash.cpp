@@ -0,0 +1,58 @@
+#include "SpatialHash.h"
+
+Onyx::SpatialHash::SpatialHash()
+	: SpatialHash(64.0f)
+{
+}
+
+Onyx::SpatialHash::SpatialHash(float cellSize)
+{
+	m_cellSize = cellSize;
+	m_inverseCellSize = 1.0f / cellSize;
+	m_bucketMask = 0;
+}
+
+void Onyx::SpatialHash::clear()
+{
+	m_entries.clear();
+}
+
+void Onyx::SpatialHash::insert(uint id, float x, float y)
+{
+	m_entries.push_back(Entry{ cellCoord(x), cellCoord(y), id });
+}
+
+void Onyx::SpatialHash::build()
+{
+	// at least twice as many buckets as points, and a power of two so the hash is masked rather than divided
+	uint nBuckets = 16;
+	while (nBuckets < m_entries.size() * 2) nBuckets <<= 1;
+	m_bucketMask = nBuckets - 1;
+
+	// one extra so a bucket's end is always the next bucket's start
+	m_bucketStarts.assign(nBuckets + 1, 0);
+	for (const Entry& entry : m_entries) m_bucketStarts[hashCell(entry.x, entry.y) + 1]++;
+	for (uint i = 1; i <= nBuckets; i++) m_bucketStarts[i] += m_bucketStarts[i - 1];
+
+	m_sorted.resize(m_entries.size());
+	for (const Entry& entry : m_entries)
+	{
+		// bucketStarts[b] is moved up to b's end while filling, then everything is shifted back down one bucket
+		uint bucket = hashCell(entry.x, entry.y);
+		m_sorted[m_bucketStarts[bucket]++] = entry;
+	}
+	for (uint i = nBuckets; i > 0; i--) m_bucketStarts[i] = m_bucketStarts[i - 1];
+	m_bucketStarts[0] = 0;
+
+	m_entries.swap(m_sorted);
+}
+
+uint Onyx::SpatialHash::getCount() const
+{
+	return m_entries.size();
+}
+
+float Onyx::SpatialHash::getCellSize() const
+{
+	return m_cellSize;
+}
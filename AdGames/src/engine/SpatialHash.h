@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <Onyx/Core.h>
+
+namespace Onyx
+{
+	/*
+		@brief A broadphase for 2D points: finds the points near an area without looking at every point.
+		Points are binned into square cells, and the cells are hashed into a bucket table, so the world has no bounds and empty space costs nothing.
+		The table is rebuilt from scratch with a counting sort, meant to be done once per tick: call clear(), insert() every point, then build().
+		Every bucket's points end up next to each other in one array, so a query reads a few short contiguous runs and allocates nothing.
+		Entries remember their cell, so two cells hashing to the same bucket never report each other's points.
+		Positions are plain floats rather than vectors, so simulations using the hash don't need anything from Onyx that isn't in its headers.
+	 */
+	class SpatialHash
+	{
+	public:
+		/*
+			@brief Default constructor, creates a hash with 64 unit cells.
+		 */
+		SpatialHash();
+
+		/*
+			@brief Creates a hash with the specified cell size.
+			@param cellSize The width and height of a cell. About the size of the areas queried works well.
+		 */
+		SpatialHash(float cellSize);
+
+		/*
+			@brief Removes every point, keeping the memory for the next build.
+		 */
+		void clear();
+
+		/*
+			@brief Adds a point. It can't be queried until build() is called.
+			@param id The id reported by query(), usually the index of what the point belongs to.
+			@param x The x coordinate of the point.
+			@param y The y coordinate of the point.
+		 */
+		void insert(uint id, float x, float y);
+
+		/*
+			@brief Sorts the inserted points into their buckets.
+		 */
+		void build();
+
+		/*
+			@brief Calls a function for every point in the cells overlapping a rectangle, each at most once.
+			Points in those cells but outside the rectangle are reported too, so the caller still has to test each one.
+			@param minX The left edge of the rectangle.
+			@param minY The bottom edge of the rectangle.
+			@param maxX The right edge of the rectangle.
+			@param maxY The top edge of the rectangle.
+			@param callback The function to call with the id of each point.
+		 */
+		template<typename Callback>
+		void query(float minX, float minY, float maxX, float maxY, Callback&& callback) const
+		{
+			if (m_entries.empty()) return;
+
+			int cellMinX = cellCoord(minX), cellMinY = cellCoord(minY);
+			int cellMaxX = cellCoord(maxX), cellMaxY = cellCoord(maxY);
+			for (int y = cellMinY; y <= cellMaxY; y++)
+			{
+				for (int x = cellMinX; x <= cellMaxX; x++)
+				{
+					uint bucket = hashCell(x, y);
+					for (uint i = m_bucketStarts[bucket]; i < m_bucketStarts[bucket + 1]; i++)
+					{
+						const Entry& entry = m_entries[i];
+						if (entry.x == x && entry.y == y) callback(entry.id);
+					}
+				}
+			}
+		}
+
+		/*
+			@brief Gets the number of points inserted since the last clear().
+			@return The number of points.
+		 */
+		uint getCount() const;
+
+		/*
+			@brief Gets the cell size.
+			@return The width and height of a cell.
+		 */
+		float getCellSize() const;
+
+	private:
+		struct Entry
+		{
+			int x, y;
+			uint id;
+		};
+
+		float m_cellSize;
+		float m_inverseCellSize;
+		std::vector<Entry> m_entries;
+		std::vector<Entry> m_sorted;
+		std::vector<uint> m_bucketStarts;
+		uint m_bucketMask;
+
+		int cellCoord(float value) const { return (int)std::floor(value * m_inverseCellSize); }
+		uint hashCell(int x, int y) const { return ((uint)x * 73856093u ^ (uint)y * 19349663u) & m_bucketMask; }
+	};
+}
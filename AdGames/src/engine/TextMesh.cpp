@@ -0,0 +1,122 @@
+#include "TextMesh.h"
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+Onyx::TextMesh::TextMesh()
+{
+	m_vao = 0;
+	m_vbo = 0;
+	m_vertexCount = 0;
+	m_capacity = 0;
+}
+
+void Onyx::TextMesh::build(const AtlasFont& font, const std::string& text)
+{
+	if (m_vao == 0)
+	{
+		glGenVertexArrays(1, &m_vao);
+		glGenBuffers(1, &m_vbo);
+
+		glBindVertexArray(m_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	const uint floatsPerChar = VERTICES_PER_CHAR * 4;
+	uint length = text.length();
+	uint oldLength = m_vertexCount / VERTICES_PER_CHAR;
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+	bool grown = false;
+	if (length > m_capacity)
+	{
+		// at least doubling keeps a string that grows a character at a time from reallocating every time
+		m_capacity = length > m_capacity * 2 ? length : m_capacity * 2;
+		glBufferData(GL_ARRAY_BUFFER, m_capacity * floatsPerChar * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+		grown = true;
+	}
+
+	// the quads from the last build are still in m_vertices, so each new quad can be compared against the old one in its place
+	m_vertices.resize(length * floatsPerChar);
+
+	uint dirtyFirst = length, dirtyEnd = 0;
+
+	// the origin is the left end of the baseline, like Onyx's text renderables
+	float pen = 0.0f;
+	for (uint i = 0; i < length; i++)
+	{
+		const AtlasGlyph& glyph = font[text[i]];
+
+		float x0 = pen + glyph.bearingX, x1 = x0 + glyph.width;
+		float y1 = (float)glyph.bearingY, y0 = y1 - glyph.height;
+
+		const float quad[VERTICES_PER_CHAR][4] = {
+			{ x0, y1, glyph.u0, glyph.v0 },
+			{ x0, y0, glyph.u0, glyph.v1 },
+			{ x1, y0, glyph.u1, glyph.v1 },
+			{ x0, y1, glyph.u0, glyph.v0 },
+			{ x1, y0, glyph.u1, glyph.v1 },
+			{ x1, y1, glyph.u1, glyph.v0 }
+		};
+		pen += glyph.advance;
+
+		float* pDest = m_vertices.data() + i * floatsPerChar;
+		if (!grown && i < oldLength && memcmp(pDest, quad, sizeof(quad)) == 0) continue;
+
+		memcpy(pDest, quad, sizeof(quad));
+		if (i < dirtyFirst) dirtyFirst = i;
+		dirtyEnd = i + 1;
+	}
+
+	// a reallocated buffer has nothing in it, otherwise only the span of changed quads is uploaded
+	if (grown) glBufferSubData(GL_ARRAY_BUFFER, 0, length * floatsPerChar * sizeof(float), m_vertices.data());
+	else if (dirtyEnd > dirtyFirst)
+		glBufferSubData(GL_ARRAY_BUFFER, dirtyFirst * floatsPerChar * sizeof(float), (dirtyEnd - dirtyFirst) * floatsPerChar * sizeof(float), m_vertices.data() + dirtyFirst * floatsPerChar);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_vertexCount = length * VERTICES_PER_CHAR;
+}
+
+void Onyx::TextMesh::draw() const
+{
+	if (m_vertexCount == 0) return;
+
+	glBindVertexArray(m_vao);
+	glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
+	glBindVertexArray(0);
+}
+
+uint Onyx::TextMesh::getVAO() const
+{
+	return m_vao;
+}
+
+uint Onyx::TextMesh::getVertexCount() const
+{
+	return m_vertexCount;
+}
+
+void Onyx::TextMesh::dispose()
+{
+	if (m_disposed) return;
+
+	if (m_vao != 0)
+	{
+		glDeleteVertexArrays(1, &m_vao);
+		glDeleteBuffers(1, &m_vbo);
+	}
+	m_vao = 0;
+	m_vbo = 0;
+	m_vertexCount = 0;
+	m_capacity = 0;
+	m_vertices.clear();
+
+	m_disposed = true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Onyx/Core.h>
+
+#include "AtlasFont.h"
+
+namespace Onyx
+{
+	/*
+		@brief The geometry of a string of text, one quad per character in a single vertex buffer, used by AtlasText and AtlasText3D.
+		Each vertex is a vec4 of the position (x, y) and texture coordinates (z, w) in the font's atlas, at attribute location 0.
+		The GL objects are created by the first call to build(). The vertex buffer only ever grows, and rebuilding only uploads the quads that changed.
+		This class is disposable.
+	 */
+	class TextMesh : public Disposable
+	{
+	public:
+		/*
+			@brief The number of vertices used for each character.
+		 */
+		static const uint VERTICES_PER_CHAR = 6;
+
+		/*
+			@brief Default constructor, initializes member variables.
+		 */
+		TextMesh();
+
+		/*
+			@brief Builds the quads for a string and uploads the ones that differ from the last build.
+			Characters that keep their glyph and position (e.g. the unchanged leading digits of a score) are not uploaded again.
+			@param font The font to lay the string out with.
+			@param text The string.
+		 */
+		void build(const AtlasFont& font, const std::string& text);
+
+		/*
+			@brief Draws every quad with one draw call. The caller is responsible for the shader and texture.
+		 */
+		void draw() const;
+
+		/*
+			@brief Gets the ID of the VAO.
+			@return The ID of the VAO, or 0 if build() hasn't been called yet.
+		 */
+		uint getVAO() const;
+
+		/*
+			@brief Gets the number of vertices drawn by draw().
+			@return The number of vertices.
+		 */
+		uint getVertexCount() const;
+
+		void dispose() override;
+
+	private:
+		uint m_vao;
+		uint m_vbo;
+		uint m_vertexCount;
+		// in characters
+		uint m_capacity;
+
+		std::vector<float> m_vertices;
+	};
+}
@@ -0,0 +1,72 @@
+#include "Texture2D.h"
+
+#include <glad/glad.h>
+
+static GLint GLWrap(Onyx::TextureWrap wrap)
+{
+	switch (wrap)
+	{
+		case Onyx::TextureWrap::MirroredRepeat: return GL_MIRRORED_REPEAT;
+		case Onyx::TextureWrap::ClampToEdge: return GL_CLAMP_TO_EDGE;
+		default: return GL_REPEAT;
+	}
+}
+
+static GLint GLFilter(Onyx::TextureFilter filter)
+{
+	return filter == Onyx::TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR;
+}
+
+Onyx::Texture2D::Texture2D()
+{
+	m_tex = 0;
+	m_width = m_height = 0;
+}
+
+Onyx::Texture2D Onyx::Texture2D::Create(const Image& image, TextureWrap textureWrap, TextureFilter minFilter, TextureFilter magFilter)
+{
+	Texture2D texture;
+	texture.m_width = image.getWidth();
+	texture.m_height = image.getHeight();
+
+	glGenTextures(1, &texture.m_tex);
+	glBindTexture(GL_TEXTURE_2D, texture.m_tex);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texture.m_width, texture.m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.getPixels().data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GLWrap(textureWrap));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GLWrap(textureWrap));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GLFilter(minFilter));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GLFilter(magFilter));
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return texture;
+}
+
+void Onyx::Texture2D::bind() const
+{
+	glBindTexture(GL_TEXTURE_2D, m_tex);
+}
+
+uint Onyx::Texture2D::getTextureID() const
+{
+	return m_tex;
+}
+
+int Onyx::Texture2D::getWidth() const
+{
+	return m_width;
+}
+
+int Onyx::Texture2D::getHeight() const
+{
+	return m_height;
+}
+
+void Onyx::Texture2D::dispose()
+{
+	if (m_disposed) return;
+
+	glDeleteTextures(1, &m_tex);
+	m_tex = 0;
+
+	m_disposed = true;
+}
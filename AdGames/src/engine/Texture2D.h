@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Onyx/Core.h>
+
+#include "Image.h"
+
+namespace Onyx
+{
+	/*
+		@brief A class to represent a 2D texture created from an already decoded Image.
+		Onyx's Texture can only be created by decoding a file on the calling thread, this one separates the decode from the upload so the decode can happen elsewhere, see AssetLoader.
+		This class is disposable. Copies share the texture, so only one of them should be disposed.
+	 */
+	class Texture2D : public Disposable
+	{
+	public:
+		/*
+			@brief Default constructor, initializes member variables.
+			Using an object created with this constructor will result in undefined behavior.
+			Use the static Create() function to create a valid texture.
+		 */
+		Texture2D();
+
+		/*
+			@brief Uploads an image to a new texture. Must be called on the thread that owns the GL context.
+			@param image The image.
+			@param textureWrap The texture wrap option. Repeat by default.
+			@param minFilter The minification filter (applied when the texture is shrunk). Nearest by default.
+			@param magFilter The magnification filter (applied when the texture is enlarged). Linear by default.
+			@return The texture.
+		 */
+		static Texture2D Create(const Image& image, TextureWrap textureWrap = TextureWrap::Repeat, TextureFilter minFilter = TextureFilter::Nearest, TextureFilter magFilter = TextureFilter::Linear);
+
+		/*
+			@brief Binds the texture.
+		 */
+		void bind() const;
+
+		/*
+			@brief Gets the ID of the texture in OpenGL.
+			@return The ID of the OpenGL texture.
+		 */
+		uint getTextureID() const;
+
+		/*
+			@brief Gets the width of the texture.
+			@return The width, in pixels.
+		 */
+		int getWidth() const;
+
+		/*
+			@brief Gets the height of the texture.
+			@return The height, in pixels.
+		 */
+		int getHeight() const;
+
+		void dispose() override;
+
+	private:
+		uint m_tex;
+		int m_width, m_height;
+	};
+}
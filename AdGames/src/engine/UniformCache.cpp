@@ -0,0 +1,64 @@
+#include "UniformCache.h"
+
+#include <glad/glad.h>
+
+std::unordered_map<ulonglong, int> Onyx::UniformCache::sm_locations;
+
+int Onyx::UniformCache::GetLocation(uint program, const UniformName& name)
+{
+	ulonglong key = ((ulonglong)program << 32) | name.hash;
+
+	auto it = sm_locations.find(key);
+	if (it != sm_locations.end()) return it->second;
+
+	int location = glGetUniformLocation(program, name.name);
+	sm_locations[key] = location;
+	return location;
+}
+
+void Onyx::UniformCache::SetBool(Shader& shader, const UniformName& name, bool val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform1i(program, GetLocation(program, name), val);
+}
+
+void Onyx::UniformCache::SetInt(Shader& shader, const UniformName& name, int val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform1i(program, GetLocation(program, name), val);
+}
+
+void Onyx::UniformCache::SetFloat(Shader& shader, const UniformName& name, float val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform1f(program, GetLocation(program, name), val);
+}
+
+void Onyx::UniformCache::SetVec2(Shader& shader, const UniformName& name, const Math::Vec2& val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform2fv(program, GetLocation(program, name), 1, val.data());
+}
+
+void Onyx::UniformCache::SetVec3(Shader& shader, const UniformName& name, const Math::Vec3& val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform3fv(program, GetLocation(program, name), 1, val.data());
+}
+
+void Onyx::UniformCache::SetVec4(Shader& shader, const UniformName& name, const Math::Vec4& val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniform4fv(program, GetLocation(program, name), 1, val.data());
+}
+
+void Onyx::UniformCache::SetMat4(Shader& shader, const UniformName& name, const Math::Mat4& val)
+{
+	uint program = shader.getProgramID();
+	glProgramUniformMatrix4fv(program, GetLocation(program, name), 1, GL_FALSE, val.data());
+}
+
+void Onyx::UniformCache::Clear()
+{
+	sm_locations.clear();
+}
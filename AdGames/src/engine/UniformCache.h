@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+
+#include <Onyx/Core.h>
+#include <Onyx/Shader.h>
+#include <Onyx/Math.h>
+
+#include "Hash.h"
+
+namespace Onyx
+{
+	/*
+		@brief The name of a uniform along with its hash, which is what the UniformCache looks locations up by.
+		Create one with the _u literal, e.g. "u_color"_u, so the hash is computed at compile time.
+	 */
+	struct UniformName
+	{
+		const char* name;
+		uint hash;
+	};
+
+	/*
+		@brief Creates a uniform name with a compile time hash.
+	 */
+	consteval UniformName operator""_u(const char* name, size_t length)
+	{
+		return UniformName{ name, HashFNV1a32(std::string_view(name, length)) };
+	}
+
+	/*
+		@brief A class to cache the locations of uniforms in shader programs, so each location is only looked up by string once per program.
+		The setters use glProgramUniform, so the program does not need to be in use.
+		Call Clear() before the GL context is destroyed, since program names are reused by the next context.
+	 */
+	class UniformCache
+	{
+	public:
+		/*
+			@brief Gets the location of a uniform, looking it up the first time it is used with this program.
+			@param program The ID of the shader program.
+			@param name The name of the uniform.
+			@return The location, or -1 if the program has no such uniform.
+		 */
+		static int GetLocation(uint program, const UniformName& name);
+
+		/*
+			@brief Sets a bool uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetBool(Shader& shader, const UniformName& name, bool val);
+
+		/*
+			@brief Sets an int uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetInt(Shader& shader, const UniformName& name, int val);
+
+		/*
+			@brief Sets a float uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetFloat(Shader& shader, const UniformName& name, float val);
+
+		/*
+			@brief Sets a vec2 uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetVec2(Shader& shader, const UniformName& name, const Math::Vec2& val);
+
+		/*
+			@brief Sets a vec3 uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetVec3(Shader& shader, const UniformName& name, const Math::Vec3& val);
+
+		/*
+			@brief Sets a vec4 uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetVec4(Shader& shader, const UniformName& name, const Math::Vec4& val);
+
+		/*
+			@brief Sets a mat4 uniform in the shader's program.
+			@param shader The shader to set the uniform in.
+			@param name The name of the uniform.
+			@param val The value to set.
+		 */
+		static void SetMat4(Shader& shader, const UniformName& name, const Math::Mat4& val);
+
+		/*
+			@brief Forgets every cached location.
+		 */
+		static void Clear();
+
+	private:
+		// keyed by the program ID in the high 32 bits and the name hash in the low 32 bits
+		static std::unordered_map<ulonglong, int> sm_locations;
+	};
+}